@@ -0,0 +1,18 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "numsim-core::numsim-core" for configuration "Release"
+set_property(TARGET numsim-core::numsim-core APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(numsim-core::numsim-core PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libnumsim-core.a"
+  )
+
+list(APPEND _cmake_import_check_targets numsim-core::numsim-core )
+list(APPEND _cmake_import_check_files_for_numsim-core::numsim-core "${_IMPORT_PREFIX}/lib/libnumsim-core.a" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
@@ -0,0 +1,113 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/benchmark/CMakeLists.txt"
+  "/root/repo/benchmark/allocation/CMakeLists.txt"
+  "/root/repo/benchmark/any_printer/CMakeLists.txt"
+  "/root/repo/benchmark/concurrent_parameter_handler/CMakeLists.txt"
+  "/root/repo/benchmark/factory_base/CMakeLists.txt"
+  "/root/repo/benchmark/input_parameter_controller/CMakeLists.txt"
+  "/root/repo/benchmark/input_parser/CMakeLists.txt"
+  "/root/repo/benchmark/layered_parameter_handler/CMakeLists.txt"
+  "/root/repo/benchmark/pack/CMakeLists.txt"
+  "/root/repo/benchmark/parameter_handler/CMakeLists.txt"
+  "/root/repo/benchmark/query_map/CMakeLists.txt"
+  "/root/repo/benchmark/registry/CMakeLists.txt"
+  "/root/repo/benchmark/snapshot/CMakeLists.txt"
+  "/root/repo/benchmark/type_dispatch/CMakeLists.txt"
+  "/root/repo/benchmark/warehouse/CMakeLists.txt"
+  "/root/repo/cmake/numsim-coreConfig.cmake.in"
+  "/root/repo/project-meta-info.in"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-SameMajorVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FetchContent.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "numsim-coreConfigVersion.cmake"
+  "numsim-coreConfig.cmake"
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/allocation/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/any_printer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/concurrent_parameter_handler/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/factory_base/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/input_parameter_controller/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/input_parser/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/layered_parameter_handler/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/pack/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/parameter_handler/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/query_map/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/registry/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/snapshot/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/type_dispatch/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/warehouse/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/numsim-core.dir/DependInfo.cmake"
+  "benchmark/allocation/CMakeFiles/allocation_benchmark.dir/DependInfo.cmake"
+  "benchmark/any_printer/CMakeFiles/any_printer_benchmark.dir/DependInfo.cmake"
+  "benchmark/concurrent_parameter_handler/CMakeFiles/concurrent_parameter_handler_benchmark.dir/DependInfo.cmake"
+  "benchmark/factory_base/CMakeFiles/factory_base_benchmark.dir/DependInfo.cmake"
+  "benchmark/input_parameter_controller/CMakeFiles/input_parameter_controller_benchmark.dir/DependInfo.cmake"
+  "benchmark/input_parser/CMakeFiles/input_parser_benchmark.dir/DependInfo.cmake"
+  "benchmark/layered_parameter_handler/CMakeFiles/layered_parameter_handler_benchmark.dir/DependInfo.cmake"
+  "benchmark/pack/CMakeFiles/pack_benchmark.dir/DependInfo.cmake"
+  "benchmark/parameter_handler/CMakeFiles/parameter_handler_benchmark.dir/DependInfo.cmake"
+  "benchmark/query_map/CMakeFiles/query_map_benchmark.dir/DependInfo.cmake"
+  "benchmark/registry/CMakeFiles/registry_benchmark.dir/DependInfo.cmake"
+  "benchmark/snapshot/CMakeFiles/snapshot_benchmark.dir/DependInfo.cmake"
+  "benchmark/type_dispatch/CMakeFiles/type_dispatch_benchmark.dir/DependInfo.cmake"
+  "benchmark/warehouse/CMakeFiles/warehouse_benchmark.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libnumsim-core.a"
+  "libnumsim-core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/numsim-core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
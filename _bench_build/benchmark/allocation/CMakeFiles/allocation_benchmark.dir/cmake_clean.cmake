@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/allocation_benchmark.dir/main.cpp.o"
+  "CMakeFiles/allocation_benchmark.dir/main.cpp.o.d"
+  "allocation_benchmark"
+  "allocation_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/allocation_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/any_printer_benchmark.dir/main.cpp.o"
+  "CMakeFiles/any_printer_benchmark.dir/main.cpp.o.d"
+  "any_printer_benchmark"
+  "any_printer_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/any_printer_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
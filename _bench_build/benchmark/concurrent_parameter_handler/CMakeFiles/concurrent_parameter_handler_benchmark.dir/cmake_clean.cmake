@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/concurrent_parameter_handler_benchmark.dir/main.cpp.o"
+  "CMakeFiles/concurrent_parameter_handler_benchmark.dir/main.cpp.o.d"
+  "concurrent_parameter_handler_benchmark"
+  "concurrent_parameter_handler_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/concurrent_parameter_handler_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
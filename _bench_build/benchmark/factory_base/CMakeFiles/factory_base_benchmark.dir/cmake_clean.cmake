@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/factory_base_benchmark.dir/main.cpp.o"
+  "CMakeFiles/factory_base_benchmark.dir/main.cpp.o.d"
+  "factory_base_benchmark"
+  "factory_base_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/factory_base_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/input_parameter_controller_benchmark.dir/main.cpp.o"
+  "CMakeFiles/input_parameter_controller_benchmark.dir/main.cpp.o.d"
+  "input_parameter_controller_benchmark"
+  "input_parameter_controller_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/input_parameter_controller_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
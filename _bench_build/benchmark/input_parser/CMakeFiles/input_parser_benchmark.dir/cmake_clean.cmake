@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/input_parser_benchmark.dir/main.cpp.o"
+  "CMakeFiles/input_parser_benchmark.dir/main.cpp.o.d"
+  "input_parser_benchmark"
+  "input_parser_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/input_parser_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/layered_parameter_handler_benchmark.dir/main.cpp.o"
+  "CMakeFiles/layered_parameter_handler_benchmark.dir/main.cpp.o.d"
+  "layered_parameter_handler_benchmark"
+  "layered_parameter_handler_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/layered_parameter_handler_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pack_benchmark.dir/main.cpp.o"
+  "CMakeFiles/pack_benchmark.dir/main.cpp.o.d"
+  "pack_benchmark"
+  "pack_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pack_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/parameter_handler_benchmark.dir/main.cpp.o"
+  "CMakeFiles/parameter_handler_benchmark.dir/main.cpp.o.d"
+  "parameter_handler_benchmark"
+  "parameter_handler_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/parameter_handler_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/query_map_benchmark.dir/main.cpp.o"
+  "CMakeFiles/query_map_benchmark.dir/main.cpp.o.d"
+  "query_map_benchmark"
+  "query_map_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/query_map_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
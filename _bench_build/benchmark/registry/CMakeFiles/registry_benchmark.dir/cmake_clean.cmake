@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/registry_benchmark.dir/main.cpp.o"
+  "CMakeFiles/registry_benchmark.dir/main.cpp.o.d"
+  "registry_benchmark"
+  "registry_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/registry_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
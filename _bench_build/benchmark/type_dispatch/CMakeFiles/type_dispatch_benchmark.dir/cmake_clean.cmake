@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/type_dispatch_benchmark.dir/main.cpp.o"
+  "CMakeFiles/type_dispatch_benchmark.dir/main.cpp.o.d"
+  "type_dispatch_benchmark"
+  "type_dispatch_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/type_dispatch_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
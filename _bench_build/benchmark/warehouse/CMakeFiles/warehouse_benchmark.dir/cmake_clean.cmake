@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/warehouse_benchmark.dir/main.cpp.o"
+  "CMakeFiles/warehouse_benchmark.dir/main.cpp.o.d"
+  "warehouse_benchmark"
+  "warehouse_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/warehouse_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,124 @@
+# Install script for directory: /root/repo
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/_bench_build/libnumsim-core.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/numsim-core" TYPE FILE FILES
+    "/root/repo/include/numsim-core/factory_base_bones.h"
+    "/root/repo/include/numsim-core/factory_base_meat.h"
+    "/root/repo/include/numsim-core/registry_bones.h"
+    "/root/repo/include/numsim-core/registry_meat.h"
+    "/root/repo/include/numsim-core/static_registry.h"
+    "/root/repo/include/numsim-core/warehouse_bones.h"
+    "/root/repo/include/numsim-core/warehouse_meat.h"
+    "/root/repo/include/numsim-core/input_parameter_controller.h"
+    "/root/repo/include/numsim-core/input_parameter_schema.h"
+    "/root/repo/include/numsim-core/input_parser.h"
+    "/root/repo/include/numsim-core/static_indexing.h"
+    "/root/repo/include/numsim-core/type_dispatch.h"
+    "/root/repo/include/numsim-core/numsim_core_utility.h"
+    "/root/repo/include/numsim-core/instrumentation.h"
+    "/root/repo/include/numsim-core/query_map.h"
+    "/root/repo/include/numsim-core/parameter_handler.h"
+    "/root/repo/include/numsim-core/concurrent_parameter_handler.h"
+    "/root/repo/include/numsim-core/layered_parameter_handler.h"
+    "/root/repo/include/numsim-core/snapshot.h"
+    "/root/repo/include/numsim-core/pack.h"
+    "/root/repo/include/numsim-core/flat_hash_map.h"
+    "/root/repo/include/numsim-core/any_printer.h"
+    "/root/repo/include/numsim-core/small_any.h"
+    "/root/repo/include/numsim-core/parallel.h"
+    "/root/repo/include/numsim-core/object_pool.h"
+    "/root/repo/include/numsim-core/wrapper.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/share/numsim-core/cmake" TYPE FILE FILES
+    "/root/repo/_bench_build/numsim-coreConfig.cmake"
+    "/root/repo/_bench_build/numsim-coreConfigVersion.cmake"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/share/numsim-core/cmake/numsim-coreTargets.cmake")
+    file(DIFFERENT _cmake_export_file_changed FILES
+         "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/share/numsim-core/cmake/numsim-coreTargets.cmake"
+         "/root/repo/_bench_build/CMakeFiles/Export/6cb3beec9ba147b57ca998d32931bda0/numsim-coreTargets.cmake")
+    if(_cmake_export_file_changed)
+      file(GLOB _cmake_old_config_files "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/share/numsim-core/cmake/numsim-coreTargets-*.cmake")
+      if(_cmake_old_config_files)
+        string(REPLACE ";" ", " _cmake_old_config_files_text "${_cmake_old_config_files}")
+        message(STATUS "Old export file \"$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/share/numsim-core/cmake/numsim-coreTargets.cmake\" will be replaced.  Removing files [${_cmake_old_config_files_text}].")
+        unset(_cmake_old_config_files_text)
+        file(REMOVE ${_cmake_old_config_files})
+      endif()
+      unset(_cmake_old_config_files)
+    endif()
+    unset(_cmake_export_file_changed)
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/share/numsim-core/cmake" TYPE FILE FILES "/root/repo/_bench_build/CMakeFiles/Export/6cb3beec9ba147b57ca998d32931bda0/numsim-coreTargets.cmake")
+  if(CMAKE_INSTALL_CONFIG_NAME MATCHES "^([Rr][Ee][Ll][Ee][Aa][Ss][Ee])$")
+    file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/share/numsim-core/cmake" TYPE FILE FILES "/root/repo/_bench_build/CMakeFiles/Export/6cb3beec9ba147b57ca998d32931bda0/numsim-coreTargets-release.cmake")
+  endif()
+endif()
+
+if(NOT CMAKE_INSTALL_LOCAL_ONLY)
+  # Include the install script for the subdirectory.
+  include("/root/repo/_bench_build/benchmark/cmake_install.cmake")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT)
+  set(CMAKE_INSTALL_MANIFEST "install_manifest_${CMAKE_INSTALL_COMPONENT}.txt")
+else()
+  set(CMAKE_INSTALL_MANIFEST "install_manifest.txt")
+endif()
+
+string(REPLACE ";" "\n" CMAKE_INSTALL_MANIFEST_CONTENT
+       "${CMAKE_INSTALL_MANIFEST_FILES}")
+file(WRITE "/root/repo/_bench_build/${CMAKE_INSTALL_MANIFEST}"
+     "${CMAKE_INSTALL_MANIFEST_CONTENT}")
@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/query_map.h>
+#include <numsim-core/small_any.h>
+
+// Count every global heap allocation made by the benchmarked code. The
+// replacements are not inlined, so the compiler does not pair the malloc and
+// free inside them with new and delete expressions.
+static std::size_t allocation_count{0};
+
+[[gnu::noinline]] void *operator new(std::size_t size) {
+  ++allocation_count;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+// Keys longer than the small string buffer, as produced by input decks.
+static std::vector<std::string> make_keys(std::size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back("material_parameter_" + std::to_string(i));
+  }
+  return keys;
+}
+
+// Build a parameter_handler on the global heap.
+static void BM_parameter_handler_heap(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  std::size_t allocations{0};
+  for (auto _ : state) {
+    const auto before{allocation_count};
+    numsim_core::parameter_handler<> handler;
+    for (const auto &key : keys) {
+      handler.insert(key, 1.0);
+    }
+    allocations += allocation_count - before;
+    benchmark::DoNotOptimize(handler);
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_parameter_handler_heap)->Arg(16)->Arg(256)->Arg(4096);
+
+// Build a pmr parameter_handler inside a monotonic arena.
+static void BM_parameter_handler_arena(benchmark::State &state) {
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  std::vector<std::pmr::string> keys;
+  for (const auto &key : make_keys(count)) {
+    keys.emplace_back(key);
+  }
+  std::vector<std::byte> buffer(count * 256);
+  std::size_t allocations{0};
+  for (auto _ : state) {
+    const auto before{allocation_count};
+    {
+      std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+      numsim_core::pmr::parameter_handler<numsim_core::small_any<>> handler(
+          &arena);
+      for (const auto &key : keys) {
+        handler.insert(key, 1.0);
+      }
+      benchmark::DoNotOptimize(handler);
+    }
+    allocations += allocation_count - before;
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_parameter_handler_arena)->Arg(16)->Arg(256)->Arg(4096);
+
+// Build a double_query_map on the global heap.
+static void BM_double_query_map_heap(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  std::size_t allocations{0};
+  for (auto _ : state) {
+    const auto before{allocation_count};
+    numsim_core::double_query_map qmap;
+    for (const auto &key : keys) {
+      qmap.set(std::any(1.0), std::string("linear_elastic_model"), key);
+    }
+    allocations += allocation_count - before;
+    benchmark::DoNotOptimize(qmap);
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_double_query_map_heap)->Arg(16)->Arg(256)->Arg(4096);
+
+// Build a pmr double_query_map inside a monotonic arena.
+static void BM_double_query_map_arena(benchmark::State &state) {
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  std::vector<std::pmr::string> keys;
+  for (const auto &key : make_keys(count)) {
+    keys.emplace_back(key);
+  }
+  const std::pmr::string model("linear_elastic_model");
+  std::vector<std::byte> buffer(count * 256);
+  std::size_t allocations{0};
+  for (auto _ : state) {
+    const auto before{allocation_count};
+    {
+      std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+      numsim_core::pmr::double_query_map qmap(&arena);
+      for (const auto &key : keys) {
+        qmap.set(std::any(1.0), model, key);
+      }
+      benchmark::DoNotOptimize(qmap);
+    }
+    allocations += allocation_count - before;
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_double_query_map_arena)->Arg(16)->Arg(256)->Arg(4096);
+
+// Register one deferred query per stored value.
+static void BM_register_queries(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  numsim_core::double_query_map qmap;
+  for (const auto &key : keys) {
+    qmap.set(std::any(1.0), std::string("linear_elastic_model"), key);
+  }
+  double sum{0};
+  std::size_t allocations{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    numsim_core::double_query_map queries;
+    state.ResumeTiming();
+    const auto before{allocation_count};
+    for (const auto &key : keys) {
+      queries.query(
+          [&sum, &key, scale = 2.0](std::any &value) {
+            sum += scale * std::any_cast<double>(value) + key.size();
+          },
+          std::string("model"), std::string("field"));
+    }
+    allocations += allocation_count - before;
+    benchmark::DoNotOptimize(queries);
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_register_queries)->Arg(16)->Arg(256)->Arg(4096);
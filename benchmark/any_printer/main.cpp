@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include <any>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <numsim-core/any_printer.h>
+#include <numsim-core/small_any.h>
+
+// Print one value of a type through the visitor table.
+template <typename TypeErasure>
+static void print_loop(benchmark::State &state, TypeErasure const &value) {
+  std::ostringstream os;
+  for (auto _ : state) {
+    os << numsim_core::basic_any_print_wrapper<TypeErasure>(value);
+    if (os.tellp() > (1 << 16)) {
+      os.str({});
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_print_int(benchmark::State &state) {
+  print_loop(state, std::any(42));
+}
+BENCHMARK(BM_print_int);
+
+static void BM_print_double(benchmark::State &state) {
+  print_loop(state, std::any(3.14159));
+}
+BENCHMARK(BM_print_double);
+
+static void BM_print_string(benchmark::State &state) {
+  print_loop(state, std::any(std::string("linear_elastic_model")));
+}
+BENCHMARK(BM_print_string);
+
+static void BM_print_vector(benchmark::State &state) {
+  print_loop(state, std::any(std::vector<double>(8, 1.0)));
+}
+BENCHMARK(BM_print_vector);
+
+static void BM_print_small_any_double(benchmark::State &state) {
+  print_loop(state, numsim_core::small_any<>(3.14159));
+}
+BENCHMARK(BM_print_small_any_double);
+
+// Print one value of a type through the bulk printer.
+template <typename TypeErasure>
+static void bulk_print_loop(benchmark::State &state, TypeErasure const &value) {
+  std::ostringstream os;
+  numsim_core::basic_value_printer<TypeErasure> printer(os);
+  for (auto _ : state) {
+    printer(value);
+    if (os.tellp() > (1 << 16)) {
+      os.str({});
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_bulk_print_double(benchmark::State &state) {
+  bulk_print_loop(state, std::any(3.14159));
+}
+BENCHMARK(BM_bulk_print_double);
+
+static void BM_bulk_print_small_any_double(benchmark::State &state) {
+  bulk_print_loop(state, numsim_core::small_any<>(3.14159));
+}
+BENCHMARK(BM_bulk_print_small_any_double);
+
+// Dump a result vector of state.range(0) doubles.
+static void BM_print_result_vector(benchmark::State &state) {
+  std::vector<double> result(static_cast<std::size_t>(state.range(0)));
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    result[i] = 1.0 / static_cast<double>(i + 1);
+  }
+  const std::any value(std::move(result));
+  for (auto _ : state) {
+    std::ostringstream os;
+    os << numsim_core::any_print_wrapper(value);
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_print_result_vector)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_bulk_print_result_vector(benchmark::State &state) {
+  std::vector<double> result(static_cast<std::size_t>(state.range(0)));
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    result[i] = 1.0 / static_cast<double>(i + 1);
+  }
+  const std::any value(std::move(result));
+  for (auto _ : state) {
+    std::ostringstream os;
+    {
+      numsim_core::value_printer printer(os);
+      printer(value);
+    }
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_bulk_print_result_vector)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <numsim-core/concurrent_parameter_handler.h>
+#include <numsim-core/parameter_handler.h>
+
+namespace {
+const std::string key{"material_parameter_42"};
+
+numsim_core::parameter_handler<> make_handler() {
+  numsim_core::parameter_handler<> handler;
+  for (int i = 0; i < 100; ++i) {
+    handler.insert("material_parameter_" + std::to_string(i), 0.5 * i);
+  }
+  return handler;
+}
+
+// The same parameters behind the usual locks
+struct mutex_handler {
+  double get() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_handler.get<double>(key);
+  }
+
+  mutable std::mutex m_mutex;
+  numsim_core::parameter_handler<> m_handler{make_handler()};
+};
+
+struct shared_mutex_handler {
+  double get() const {
+    const std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_handler.get<double>(key);
+  }
+
+  mutable std::shared_mutex m_mutex;
+  numsim_core::parameter_handler<> m_handler{make_handler()};
+};
+
+mutex_handler mutex_shared;
+shared_mutex_handler shared_mutex_shared;
+numsim_core::concurrent_parameter_handler<> concurrent_shared(make_handler());
+} // namespace
+
+// Lookups from all threads, no writer.
+static void BM_get_mutex(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mutex_shared.get());
+  }
+}
+
+static void BM_get_shared_mutex(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(shared_mutex_shared.get());
+  }
+}
+
+static void BM_get_concurrent(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(concurrent_shared.get<double>(key));
+  }
+}
+
+// Thread 0 publishes an update every 1024 lookups.
+static void BM_get_concurrent_with_writer(benchmark::State &state) {
+  std::size_t count{0};
+  for (auto _ : state) {
+    if (state.thread_index() == 0 && (++count & 1023) == 0) {
+      concurrent_shared.insert("step", static_cast<int>(count));
+    }
+    benchmark::DoNotOptimize(concurrent_shared.get<double>(key));
+  }
+}
+
+BENCHMARK(BM_get_mutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_get_shared_mutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_get_concurrent)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_get_concurrent_with_writer)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <numsim-core/factory_base_bones.h>
+
+struct material {
+  virtual ~material() = default;
+  [[nodiscard]] virtual double stiffness() const = 0;
+};
+
+struct linear_elastic final : material {
+  [[nodiscard]] double stiffness() const override { return m_youngs_modulus; }
+  double m_youngs_modulus{210.0e3};
+  double m_poisson_ratio{0.3};
+};
+
+static numsim_core::factory_base<material> make_factory() {
+  numsim_core::factory_base<material> factory;
+  factory.add<linear_elastic>("linear_elastic_material");
+  return factory;
+}
+
+// One lookup and one heap allocation per instance.
+static void BM_create(benchmark::State &state) {
+  const auto factory{make_factory()};
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<material>> objects;
+    objects.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      objects.push_back(factory.create("linear_elastic_material"));
+    }
+    benchmark::DoNotOptimize(objects.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(count));
+}
+BENCHMARK(BM_create)->Arg(16)->Arg(1024);
+
+// One lookup and one allocation for all instances.
+static void BM_create_n(benchmark::State &state) {
+  const auto factory{make_factory()};
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    auto objects{factory.create_n("linear_elastic_material", count)};
+    benchmark::DoNotOptimize(&objects[0]);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(count));
+}
+BENCHMARK(BM_create_n)->Arg(16)->Arg(1024);
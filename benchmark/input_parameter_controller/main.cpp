@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <numsim-core/input_parameter_controller.h>
+#include <numsim-core/parameter_handler.h>
+
+using handler_type = numsim_core::parameter_handler<>;
+using controller_type =
+    numsim_core::input_parameter_controller<std::string, handler_type>;
+
+// A material-like controller: (required + range), (default), (type) checks
+// on a third of the parameters each.
+static controller_type make_controller(std::size_t count) {
+  controller_type controller;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto name{"material_parameter_" + std::to_string(i)};
+    switch (i % 3) {
+    case 0:
+      controller.insert<double>(name)
+          .add<numsim_core::is_required>()
+          .add<numsim_core::check_range>(0.0, 1.0e12);
+      break;
+    case 1:
+      controller.insert<double>(name).add<numsim_core::set_default>(1.0);
+      break;
+    default:
+      controller.insert<std::string>(name)
+          .add<numsim_core::check_data_type>();
+      break;
+    }
+  }
+  return controller;
+}
+
+// Provide every required and typed parameter, leave the defaults missing.
+static handler_type make_handler(std::size_t count) {
+  handler_type handler;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto name{"material_parameter_" + std::to_string(i)};
+    if (i % 3 == 0) {
+      handler.insert(name, 210.0e3);
+    } else if (i % 3 == 2) {
+      handler.insert(name, std::string("a_rather_long_string_parameter_value"));
+    }
+  }
+  return handler;
+}
+
+// Check one handler; defaults are inserted on the first iteration only.
+static void BM_check_parameter(benchmark::State &state) {
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  auto controller{make_controller(count)};
+  auto handler{make_handler(count)};
+  for (auto _ : state) {
+    controller.check_parameter(handler);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_check_parameter)->Arg(12)->Arg(96)->Arg(768);
+
+// Check a batch of fresh handlers, serially and on all hardware threads.
+static void BM_check_parameter_batch(benchmark::State &state) {
+  const auto threads{static_cast<unsigned>(state.range(0))};
+  const std::size_t count{12};
+  const std::size_t handlers_count{10000};
+  auto controller{make_controller(count)};
+  const auto prototype{make_handler(count)};
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<handler_type> handlers(handlers_count, prototype);
+    state.ResumeTiming();
+    auto errors{controller.check_parameter(
+        handlers, numsim_core::parallel_executor(threads))};
+    benchmark::DoNotOptimize(errors);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(handlers_count));
+}
+BENCHMARK(BM_check_parameter_batch)
+    ->Arg(1)
+    ->Arg(0)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// A range-checked scalar parameter across many element handlers, checked
+// per handler and as one column.
+static controller_type make_range_controller() {
+  controller_type controller;
+  controller.insert<double>("E")
+      .add<numsim_core::is_required>()
+      .add<numsim_core::check_range>(0.0, 1.0e12);
+  return controller;
+}
+
+static std::vector<handler_type> make_elements(std::size_t count) {
+  std::vector<handler_type> handlers(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    handlers[i].insert("E", 210.0e3 + static_cast<double>(i));
+  }
+  return handlers;
+}
+
+static void BM_check_range_batch(benchmark::State &state) {
+  const auto controller{make_range_controller()};
+  auto handlers{make_elements(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    auto errors{controller.check_parameter(
+        handlers, numsim_core::parallel_executor(1))};
+    benchmark::DoNotOptimize(errors);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_check_range_batch)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_check_range_columns(benchmark::State &state) {
+  const auto controller{make_range_controller()};
+  auto handlers{make_elements(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    auto masks{controller.check_columns(handlers)};
+    benchmark::DoNotOptimize(masks);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_check_range_columns)->Arg(1000000)->Unit(benchmark::kMillisecond);
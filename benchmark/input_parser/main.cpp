@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <numsim-core/input_parser.h>
+#include <numsim-core/parameter_handler.h>
+
+// A generated parameter file of numeric key = value lines.
+static std::string make_file(std::size_t count) {
+  std::string text;
+  for (std::size_t i = 0; i < count; ++i) {
+    text += "material_parameter_" + std::to_string(i) + " = " +
+            std::to_string(0.5 * static_cast<double>(i)) + "\n";
+  }
+  return text;
+}
+
+// The manual pipeline: lines into a string map, then std::stod per value.
+static void BM_string_map(benchmark::State &state) {
+  const auto text{make_file(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    std::istringstream input(text);
+    std::map<std::string, std::string, std::less<>> entries;
+    std::string line;
+    while (std::getline(input, line)) {
+      const auto pos{line.find('=')};
+      entries[std::string(numsim_core::detail::trim(
+          std::string_view(line).substr(0, pos)))] =
+          std::string(numsim_core::detail::trim(
+              std::string_view(line).substr(pos + 1)));
+    }
+    numsim_core::parameter_handler<> handler;
+    for (const auto &[key, value] : entries) {
+      handler.insert(key, std::stod(value));
+    }
+    benchmark::DoNotOptimize(handler);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+
+// Tokenizing only.
+static void BM_config_reader_scan(benchmark::State &state) {
+  const auto text{make_file(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    std::istringstream input(text);
+    std::size_t bytes{0};
+    numsim_core::config_reader(input).for_each(
+        [&bytes](std::string_view key, std::string_view value) {
+          bytes += key.size() + value.size();
+        });
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+
+// Streaming straight into the handler with from_chars.
+static void BM_config_reader(benchmark::State &state) {
+  const auto text{make_file(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    std::istringstream input(text);
+    numsim_core::parameter_handler<> handler;
+    numsim_core::config_reader(input).read(handler);
+    benchmark::DoNotOptimize(handler);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+
+BENCHMARK(BM_string_map)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_config_reader_scan)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_config_reader)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <numsim-core/layered_parameter_handler.h>
+#include <numsim-core/parameter_handler.h>
+
+namespace {
+constexpr std::size_t keys{30};
+
+template <typename Handler> void fill_material(Handler &handler) {
+  for (std::size_t i = 0; i < keys; ++i) {
+    handler.insert("material_parameter_" + std::to_string(i), 0.5 * i);
+  }
+}
+} // namespace
+
+// Full per-element copies of the material, two overrides each.
+static void BM_copy_elements(benchmark::State &state) {
+  numsim_core::parameter_handler<> material;
+  fill_material(material);
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    std::vector<numsim_core::parameter_handler<>> elements(count, material);
+    for (std::size_t i = 0; i < count; ++i) {
+      elements[i].insert("material_parameter_3", 1.0 * i);
+      elements[i].insert("material_parameter_7", 2.0 * i);
+    }
+    benchmark::DoNotOptimize(elements.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Layers over the shared material storing only the overrides.
+static void BM_layer_elements(benchmark::State &state) {
+  numsim_core::layered_parameter_handler<> material;
+  fill_material(material);
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    std::vector<numsim_core::layered_parameter_handler<>> elements(
+        count, material.child());
+    for (std::size_t i = 0; i < count; ++i) {
+      elements[i].insert("material_parameter_3", 1.0 * i);
+      elements[i].insert("material_parameter_7", 2.0 * i);
+    }
+    benchmark::DoNotOptimize(elements.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Lookup of an inherited key: one level up, and after flattening.
+static void BM_get_inherited(benchmark::State &state) {
+  numsim_core::layered_parameter_handler<> material;
+  fill_material(material);
+  auto element{material.child()};
+  element.insert("material_parameter_3", 1.0);
+  if (state.range(0) != 0) {
+    element.flatten();
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(element.get<double>("material_parameter_20"));
+  }
+}
+
+BENCHMARK(BM_copy_elements)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_layer_elements)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_get_inherited)->Arg(0)->Arg(1);
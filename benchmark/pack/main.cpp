@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <numsim-core/pack.h>
+#include <numsim-core/parameter_handler.h>
+
+// An input deck of scalar material parameters.
+static numsim_core::parameter_handler<> make_handler(std::size_t count) {
+  numsim_core::parameter_handler<> handler;
+  handler.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    handler.insert("material_parameter_" + std::to_string(i),
+                   static_cast<double>(i));
+  }
+  return handler;
+}
+
+// One message per entry, as broadcasting key by key does.
+static void BM_pack_per_entry(benchmark::State &state) {
+  const auto handler{make_handler(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    std::size_t bytes{0};
+    for (const auto &[key, value] : handler) {
+      numsim_core::parameter_handler<> single;
+      single.insert(key, std::any_cast<double>(value));
+      bytes += numsim_core::pack(single).size();
+    }
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// One buffer for all entries.
+static void BM_pack(benchmark::State &state) {
+  const auto handler{make_handler(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    auto buffer{numsim_core::pack(handler)};
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Rebuild on the receiver with the default allocator.
+static void BM_unpack(benchmark::State &state) {
+  const auto buffer{numsim_core::pack(
+      make_handler(static_cast<std::size_t>(state.range(0))))};
+  for (auto _ : state) {
+    numsim_core::parameter_handler<> handler;
+    numsim_core::unpack(buffer, handler);
+    benchmark::DoNotOptimize(handler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Rebuild on the receiver into a monotonic resource sized from the buffer.
+static void BM_unpack_pmr(benchmark::State &state) {
+  const auto buffer{numsim_core::pack(
+      make_handler(static_cast<std::size_t>(state.range(0))))};
+  for (auto _ : state) {
+    std::pmr::monotonic_buffer_resource resource(4 * buffer.size());
+    {
+      numsim_core::pmr::parameter_handler<> handler(&resource);
+      numsim_core::unpack(buffer, handler);
+      benchmark::DoNotOptimize(handler);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_pack_per_entry)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pack)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_unpack)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_unpack_pmr)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <numsim-core/parameter_handler.h>
+
+// Keys longer than the small string buffer, as produced by input decks.
+static std::vector<std::string> make_keys(std::size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back("material_parameter_" + std::to_string(i));
+  }
+  return keys;
+}
+
+template <typename Handler>
+static Handler make_handler(std::vector<std::string> const &keys) {
+  Handler handler;
+  for (const auto &key : keys) {
+    handler.insert(key, 1.0);
+  }
+  return handler;
+}
+
+// Insert all keys into an empty handler.
+template <typename Handler> static void BM_insert(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    Handler handler;
+    for (const auto &key : keys) {
+      handler.insert(key, 1.0);
+    }
+    benchmark::DoNotOptimize(handler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Read every stored key once.
+template <typename Handler> static void BM_get(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  auto handler{make_handler<Handler>(keys)};
+  for (auto _ : state) {
+    double sum{0};
+    for (const auto &key : keys) {
+      sum += handler.template get<double>(key);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Look up every stored key and as many missing keys.
+template <typename Handler> static void BM_contains(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  auto handler{make_handler<Handler>(keys)};
+  std::vector<std::string> missing;
+  missing.reserve(keys.size());
+  for (const auto &key : keys) {
+    missing.push_back(key + "_missing");
+  }
+  for (auto _ : state) {
+    std::size_t found{0};
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      found += handler.contains(keys[i]);
+      found += handler.contains(missing[i]);
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+// Read every stored key through pre-resolved handles.
+template <typename Handler> static void BM_handle(benchmark::State &state) {
+  using handle_type = typename Handler::template handle<double>;
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  auto handler{make_handler<Handler>(keys)};
+  std::vector<handle_type> handles;
+  handles.reserve(keys.size());
+  for (const auto &key : keys) {
+    handles.push_back(handler.template resolve<double>(key));
+  }
+  for (auto _ : state) {
+    double sum{0};
+    for (const auto &value : handles) {
+      sum += *value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using unordered_handler = numsim_core::parameter_handler<>;
+using flat_handler = numsim_core::flat_parameter_handler<>;
+
+BENCHMARK_TEMPLATE(BM_insert, unordered_handler)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_insert, flat_handler)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_get, unordered_handler)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_get, flat_handler)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_contains, unordered_handler)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_contains, flat_handler)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_handle, unordered_handler)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_handle, flat_handler)->Arg(10)->Arg(1000)->Arg(100000);
+
+// A tabulated curve derived from two base parameters.
+static std::vector<double> tabulate(double scale, double exponent) {
+  std::vector<double> curve(1000);
+  for (std::size_t i = 0; i < curve.size(); ++i) {
+    curve[i] = scale * std::pow(1.0e-3 * static_cast<double>(i), exponent);
+  }
+  return curve;
+}
+
+// Setup computing state.range(0) derived curves eagerly.
+static void BM_derived_eager(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    numsim_core::parameter_handler<> handler;
+    handler.insert("scale", 2.0);
+    handler.insert("exponent", 0.5);
+    for (const auto &key : keys) {
+      handler.insert(key, tabulate(handler.get<double>("scale"),
+                                   handler.get<double>("exponent")));
+    }
+    benchmark::DoNotOptimize(handler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Setup registering the same curves as deferred values, none read.
+static void BM_derived_deferred(benchmark::State &state) {
+  const auto keys{make_keys(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    numsim_core::parameter_handler<> handler;
+    handler.insert("scale", 2.0);
+    handler.insert("exponent", 0.5);
+    for (const auto &key : keys) {
+      handler.insert_deferred(key, {"scale", "exponent"}, [](auto const &h) {
+        return tabulate(h.template get<double>("scale"),
+                        h.template get<double>("exponent"));
+      });
+    }
+    benchmark::DoNotOptimize(handler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Reading a cached deferred value.
+static void BM_get_deferred(benchmark::State &state) {
+  numsim_core::parameter_handler<> handler;
+  handler.insert("E", 210000.0);
+  handler.insert("nu", 0.3);
+  handler.insert_deferred("mu", {"E", "nu"}, [](auto const &h) {
+    return h.template get<double>("E") /
+           (2.0 * (1.0 + h.template get<double>("nu")));
+  });
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(handler.get<double>("mu"));
+  }
+}
+
+BENCHMARK(BM_derived_eager)->Arg(50);
+BENCHMARK(BM_derived_deferred)->Arg(50);
+BENCHMARK(BM_get_deferred);
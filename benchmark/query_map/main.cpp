@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <numsim-core/parallel.h>
+#include <numsim-core/query_map.h>
+
+// Keys of each level, e.g. model and field names.
+static std::vector<std::string> make_keys(std::string const &prefix,
+                                          std::size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back(prefix + std::to_string(i));
+  }
+  return keys;
+}
+
+using one_level = std::tuple<std::string>;
+using two_level = std::tuple<std::string, std::string>;
+using three_level = std::tuple<std::string, std::string, std::string>;
+
+// Calls func with every key combination of the given depth; range(0) keys on
+// the last level and 8 keys on every other level.
+template <typename List, typename Func>
+static void for_each_key(benchmark::State const &state, Func &&func) {
+  const auto last{make_keys("field_", static_cast<std::size_t>(state.range(0)))};
+  const auto outer{make_keys("model_", 8)};
+  if constexpr (std::tuple_size_v<List> == 1) {
+    for (const auto &key : last) {
+      func(key);
+    }
+  } else if constexpr (std::tuple_size_v<List> == 2) {
+    for (const auto &first : outer) {
+      for (const auto &key : last) {
+        func(first, key);
+      }
+    }
+  } else {
+    for (const auto &first : outer) {
+      for (const auto &second : outer) {
+        for (const auto &key : last) {
+          func(first, second, key);
+        }
+      }
+    }
+  }
+}
+
+template <typename QueryMap> static QueryMap make_map(benchmark::State &state) {
+  QueryMap qmap;
+  for_each_key<typename QueryMap::tuple_type>(
+      state, [&](auto const &...keys) { qmap.set(std::any(1.0), keys...); });
+  return qmap;
+}
+
+// Set one value per key combination.
+template <typename QueryMap> static void BM_set(benchmark::State &state) {
+  for (auto _ : state) {
+    auto qmap{make_map<QueryMap>(state)};
+    benchmark::DoNotOptimize(qmap);
+  }
+}
+
+// Get every stored value once.
+template <typename QueryMap> static void BM_get(benchmark::State &state) {
+  auto qmap{make_map<QueryMap>(state)};
+  std::vector<typename QueryMap::tuple_type> keys;
+  for_each_key<typename QueryMap::tuple_type>(
+      state, [&](auto const &...key) { keys.emplace_back(key...); });
+  for (auto _ : state) {
+    for (const auto &key : keys) {
+      benchmark::DoNotOptimize(std::apply(
+          [&](auto const &...key_part) -> auto & {
+            return qmap.get(key_part...);
+          },
+          key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(keys.size()));
+}
+
+// Register one query per stored value and run them; with `Invalidate` every
+// query re-runs each step, otherwise only the first step runs them. With
+// `Parallel` the queries run on a parallel_executor.
+template <typename QueryMap, bool Invalidate, bool Parallel = false>
+static void run_final_queries(benchmark::State &state) {
+  auto qmap{make_map<QueryMap>(state)};
+  double sum{0};
+  std::size_t queries{0};
+  for_each_key<typename QueryMap::tuple_type>(state, [&](auto const &...keys) {
+    qmap.query(
+        [&sum](std::any &value) {
+          if constexpr (Parallel) {
+            benchmark::DoNotOptimize(std::any_cast<double>(value));
+          } else {
+            sum += std::any_cast<double>(value);
+          }
+        },
+        keys...);
+    ++queries;
+  });
+  const numsim_core::parallel_executor executor;
+  for (auto _ : state) {
+    if constexpr (Invalidate) {
+      qmap.invalidate_queries();
+    }
+    if constexpr (Parallel) {
+      qmap.final_queries(executor);
+    } else {
+      qmap.final_queries();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(queries));
+}
+
+// A time step in which no value changed.
+template <typename QueryMap>
+static void BM_final_queries(benchmark::State &state) {
+  run_final_queries<QueryMap, false>(state);
+}
+
+// A time step in which every value changed.
+template <typename QueryMap>
+static void BM_final_queries_all(benchmark::State &state) {
+  run_final_queries<QueryMap, true>(state);
+}
+
+// A time step in which every value changed, queries run in parallel.
+template <typename QueryMap>
+static void BM_final_queries_parallel(benchmark::State &state) {
+  run_final_queries<QueryMap, true, true>(state);
+}
+
+template <typename List>
+using nested_map = numsim_core::query_map<List, std::unordered_map>;
+template <typename List>
+using flat_map = numsim_core::flat_query_map<List, std::unordered_map>;
+
+#define NUMSIM_QUERY_MAP_BENCHMARK(NAME)                                       \
+  BENCHMARK_TEMPLATE(NAME, nested_map<one_level>)->Arg(16)->Arg(1024);         \
+  BENCHMARK_TEMPLATE(NAME, flat_map<one_level>)->Arg(16)->Arg(1024);           \
+  BENCHMARK_TEMPLATE(NAME, nested_map<two_level>)->Arg(16)->Arg(1024);         \
+  BENCHMARK_TEMPLATE(NAME, flat_map<two_level>)->Arg(16)->Arg(1024);           \
+  BENCHMARK_TEMPLATE(NAME, nested_map<three_level>)->Arg(16)->Arg(1024);       \
+  BENCHMARK_TEMPLATE(NAME, flat_map<three_level>)->Arg(16)->Arg(1024)
+
+NUMSIM_QUERY_MAP_BENCHMARK(BM_set);
+NUMSIM_QUERY_MAP_BENCHMARK(BM_get);
+NUMSIM_QUERY_MAP_BENCHMARK(BM_final_queries);
+NUMSIM_QUERY_MAP_BENCHMARK(BM_final_queries_all);
+NUMSIM_QUERY_MAP_BENCHMARK(BM_final_queries_parallel);
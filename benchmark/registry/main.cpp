@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+#include <map>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <numsim-core/registry_bones.h>
+#include <numsim-core/static_registry.h>
+
+// Minimal object hierarchy registered by name.
+struct material_base {
+  virtual ~material_base() = default;
+  virtual double stiffness() const = 0;
+};
+
+struct linear_elastic final : material_base {
+  double stiffness() const override { return 210.0e3; }
+};
+
+struct hyperelastic final : material_base {
+  double stiffness() const override { return 1.0e3; }
+};
+
+using ordered_registry = numsim_core::registry<
+    std::map, std::string, numsim_core::heap_registry_entry<material_base>>;
+using unordered_registry =
+    numsim_core::registry<std::unordered_map, std::string,
+                          numsim_core::heap_registry_entry<material_base>>;
+using pooled_registry =
+    numsim_core::registry<std::unordered_map, std::string,
+                          numsim_core::pooled_registry_entry<material_base>>;
+
+// A distinct entry type gives the frozen registry its own singleton.
+struct frozen_entry : numsim_core::heap_registry_entry<material_base> {};
+using frozen_registry =
+    numsim_core::registry<std::map, std::string, frozen_entry>;
+
+using static_registry = numsim_core::static_registry<
+    numsim_core::heap_registry_entry<material_base>,
+    StaticRegisterObject(linear_elastic, linear_elastic),
+    StaticRegisterObject(hyperelastic, hyperelastic)>;
+
+RegisterObject(ordered_registry, linear_elastic, linear_elastic)
+RegisterObject(ordered_registry, hyperelastic, hyperelastic)
+RegisterObject(unordered_registry, linear_elastic, linear_elastic)
+RegisterObject(unordered_registry, hyperelastic, hyperelastic)
+RegisterObject(pooled_registry, linear_elastic, linear_elastic)
+RegisterObject(pooled_registry, hyperelastic, hyperelastic)
+RegisterObject(frozen_registry, linear_elastic, linear_elastic)
+RegisterObject(frozen_registry, hyperelastic, hyperelastic)
+
+// Build objects by name.
+template <typename Registry> static void BM_build(benchmark::State &state) {
+  if constexpr (std::is_same_v<Registry, frozen_registry>) {
+    Registry::freeze();
+  }
+  const std::string names[]{"linear_elastic", "hyperelastic"};
+  std::size_t index{0};
+  for (auto _ : state) {
+    auto object{Registry::build(names[index++ & 1])};
+    benchmark::DoNotOptimize(object->stiffness());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_build, ordered_registry);
+BENCHMARK_TEMPLATE(BM_build, unordered_registry);
+BENCHMARK_TEMPLATE(BM_build, pooled_registry);
+BENCHMARK_TEMPLATE(BM_build, frozen_registry);
+BENCHMARK_TEMPLATE(BM_build, static_registry);
+
+// Build objects through builders resolved once.
+template <typename Registry> static void BM_builder(benchmark::State &state) {
+  const typename Registry::builder builders[]{
+      Registry::resolve("linear_elastic"), Registry::resolve("hyperelastic")};
+  std::size_t index{0};
+  for (auto _ : state) {
+    auto object{builders[index++ & 1]()};
+    benchmark::DoNotOptimize(object->stiffness());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_builder, unordered_registry);
+BENCHMARK_TEMPLATE(BM_builder, pooled_registry);
+
+// Look up the entry of a name without building.
+template <typename Registry> static void BM_entity(benchmark::State &state) {
+  if constexpr (std::is_same_v<Registry, frozen_registry>) {
+    Registry::freeze();
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&Registry::entity("linear_elastic"));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_entity, ordered_registry);
+BENCHMARK_TEMPLATE(BM_entity, unordered_registry);
+BENCHMARK_TEMPLATE(BM_entity, frozen_registry);
+BENCHMARK_TEMPLATE(BM_entity, static_registry);
+
+// Startup cost of registering many types: eager entries, as RegisterObject
+// created them during static initialization, against the descriptors it
+// links now, and the deferred cost of the first access.
+namespace {
+constexpr std::size_t startup_count{256};
+
+struct eager_entry : numsim_core::heap_registry_entry<material_base> {};
+struct lazy_entry : numsim_core::heap_registry_entry<material_base> {};
+using eager_registry = numsim_core::registry<std::map, std::string, eager_entry>;
+using lazy_registry = numsim_core::registry<std::map, std::string, lazy_entry>;
+
+std::vector<std::string> startup_names() {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < startup_count; ++i) {
+    names.push_back("material_type_" + std::to_string(i));
+  }
+  return names;
+}
+} // namespace
+
+static void BM_startup_eager(benchmark::State &state) {
+  const auto names{startup_names()};
+  for (auto _ : state) {
+    for (const auto &name : names) {
+      eager_registry::add_object<linear_elastic>(name);
+    }
+    state.PauseTiming();
+    for (const auto &name : names) {
+      eager_registry::erase(name);
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * startup_count);
+}
+BENCHMARK(BM_startup_eager);
+
+template <bool FirstAccess>
+static void BM_startup_lazy(benchmark::State &state) {
+  const auto names{startup_names()};
+  std::array<std::optional<lazy_registry::registration>, startup_count>
+      registrations;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < startup_count; ++i) {
+      registrations[i].emplace(names[i].c_str(),
+                               std::type_identity<linear_elastic>{});
+    }
+    if constexpr (FirstAccess) {
+      benchmark::DoNotOptimize(&lazy_registry::get());
+    }
+    state.PauseTiming();
+    static_cast<void>(lazy_registry::get());
+    for (std::size_t i = 0; i < startup_count; ++i) {
+      lazy_registry::erase(names[i]);
+      registrations[i].reset();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * startup_count);
+}
+BENCHMARK_TEMPLATE(BM_startup_lazy, false);
+BENCHMARK_TEMPLATE(BM_startup_lazy, true);
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/snapshot.h>
+
+// A restart state: mostly scalars with some nodal arrays.
+static numsim_core::parameter_handler<> make_handler(std::size_t count) {
+  numsim_core::parameter_handler<> handler;
+  handler.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto key{"material_parameter_" + std::to_string(i)};
+    if (i % 100 == 0) {
+      handler.insert(std::move(key), std::vector<double>(64, 1.0));
+    } else {
+      handler.insert(std::move(key), static_cast<double>(i));
+    }
+  }
+  return handler;
+}
+
+// Serialize all parameters.
+static void BM_to_snapshot(benchmark::State &state) {
+  const auto handler{make_handler(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    auto buffer{numsim_core::to_snapshot(handler)};
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Index a snapshot, as done after mapping a file.
+static void BM_open_view(benchmark::State &state) {
+  const auto buffer{numsim_core::to_snapshot(
+      make_handler(static_cast<std::size_t>(state.range(0))))};
+  for (auto _ : state) {
+    numsim_core::snapshot_view view(buffer);
+    benchmark::DoNotOptimize(view.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Decode all parameters into a new handler.
+static void BM_load(benchmark::State &state) {
+  const auto buffer{numsim_core::to_snapshot(
+      make_handler(static_cast<std::size_t>(state.range(0))))};
+  for (auto _ : state) {
+    numsim_core::parameter_handler<> handler;
+    numsim_core::snapshot_view(buffer).load(handler);
+    benchmark::DoNotOptimize(handler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The text output print() offers, for comparison with BM_to_snapshot.
+static void BM_print(benchmark::State &state) {
+  auto handler{make_handler(static_cast<std::size_t>(state.range(0)))};
+  for (auto _ : state) {
+    std::ostringstream os;
+    handler.print(os);
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_to_snapshot)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_open_view)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_load)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_print)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
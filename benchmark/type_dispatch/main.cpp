@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <numsim-core/static_indexing.h>
+#include <numsim-core/type_dispatch.h>
+
+// Two small hierarchies combined by a material x element kernel.
+struct material {
+  virtual ~material() = default;
+  [[nodiscard]] virtual numsim_core::type_id get_type_id() const noexcept = 0;
+};
+
+struct element {
+  virtual ~element() = default;
+  [[nodiscard]] virtual numsim_core::type_id get_type_id() const noexcept = 0;
+};
+
+template <int I>
+struct material_impl
+    : numsim_core::static_indexing<material_impl<I>, material> {
+  double value{I + 1.0};
+};
+
+template <int I>
+struct element_impl
+    : numsim_core::static_indexing<element_impl<I>, element> {
+  double value{I + 2.0};
+};
+
+template <int M, int E> double kernel(material &m, element &e) {
+  return static_cast<material_impl<M> &>(m).value *
+         static_cast<element_impl<E> &>(e).value;
+}
+
+// Resolve the element type by a dynamic_cast chain.
+template <int M> double dispatch_element(material &m, element &e) {
+  if (dynamic_cast<element_impl<0> *>(&e) != nullptr) {
+    return kernel<M, 0>(m, e);
+  }
+  if (dynamic_cast<element_impl<1> *>(&e) != nullptr) {
+    return kernel<M, 1>(m, e);
+  }
+  if (dynamic_cast<element_impl<2> *>(&e) != nullptr) {
+    return kernel<M, 2>(m, e);
+  }
+  return kernel<M, 3>(m, e);
+}
+
+// Resolve both types by dynamic_cast chains.
+static double dispatch_dynamic_cast(material &m, element &e) {
+  if (dynamic_cast<material_impl<0> *>(&m) != nullptr) {
+    return dispatch_element<0>(m, e);
+  }
+  if (dynamic_cast<material_impl<1> *>(&m) != nullptr) {
+    return dispatch_element<1>(m, e);
+  }
+  if (dynamic_cast<material_impl<2> *>(&m) != nullptr) {
+    return dispatch_element<2>(m, e);
+  }
+  return dispatch_element<3>(m, e);
+}
+
+using kernel_table = numsim_core::double_dispatch_table<double(material &, element &)>;
+
+template <int M, int... E>
+void add_row(kernel_table &table, std::integer_sequence<int, E...>) {
+  (table.set<material_impl<M>, element_impl<E>>(&kernel<M, E>), ...);
+}
+
+template <int... M>
+kernel_table make_table(std::integer_sequence<int, M...>) {
+  kernel_table table;
+  (add_row<M>(table, std::make_integer_sequence<int, 4>{}), ...);
+  return table;
+}
+
+// Mixed pairs, so neither branch nor indirect call is trivially predicted.
+struct workload {
+  std::vector<std::unique_ptr<material>> materials;
+  std::vector<std::unique_ptr<element>> elements;
+
+  workload() {
+    const std::vector<std::unique_ptr<material> (*)()> make_material{
+        []() -> std::unique_ptr<material> { return std::make_unique<material_impl<0>>(); },
+        []() -> std::unique_ptr<material> { return std::make_unique<material_impl<1>>(); },
+        []() -> std::unique_ptr<material> { return std::make_unique<material_impl<2>>(); },
+        []() -> std::unique_ptr<material> { return std::make_unique<material_impl<3>>(); }};
+    const std::vector<std::unique_ptr<element> (*)()> make_element{
+        []() -> std::unique_ptr<element> { return std::make_unique<element_impl<0>>(); },
+        []() -> std::unique_ptr<element> { return std::make_unique<element_impl<1>>(); },
+        []() -> std::unique_ptr<element> { return std::make_unique<element_impl<2>>(); },
+        []() -> std::unique_ptr<element> { return std::make_unique<element_impl<3>>(); }};
+    for (std::size_t i = 0; i < 1024; ++i) {
+      materials.push_back(make_material[(i * 7) % 4]());
+      elements.push_back(make_element[(i * 5 + i / 3) % 4]());
+    }
+  }
+};
+
+static void BM_dynamic_cast(benchmark::State &state) {
+  const workload data;
+  for (auto _ : state) {
+    double sum{0};
+    for (std::size_t i = 0; i < data.materials.size(); ++i) {
+      sum += dispatch_dynamic_cast(*data.materials[i], *data.elements[i]);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(data.materials.size()));
+}
+BENCHMARK(BM_dynamic_cast);
+
+static void BM_double_dispatch_table(benchmark::State &state) {
+  const workload data;
+  const auto table{make_table(std::make_integer_sequence<int, 4>{})};
+  for (auto _ : state) {
+    double sum{0};
+    for (std::size_t i = 0; i < data.materials.size(); ++i) {
+      auto &m{*data.materials[i]};
+      auto &e{*data.elements[i]};
+      sum += table(m.get_type_id(), e.get_type_id(), m, e);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(data.materials.size()));
+}
+BENCHMARK(BM_double_dispatch_table);
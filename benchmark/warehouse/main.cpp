@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include <numsim-core/static_indexing.h>
+#include <numsim-core/warehouse_bones.h>
+
+// A hierarchy with a small hot state, as material points carry.
+struct point_base {
+  virtual ~point_base() = default;
+  virtual void update(double increment) = 0;
+};
+
+struct elastic_point final
+    : numsim_core::static_indexing<elastic_point, point_base> {
+  void update(double increment) override { m_stress += 2.0 * increment; }
+  double m_stress{0.0};
+};
+
+struct plastic_point final
+    : numsim_core::static_indexing<plastic_point, point_base> {
+  void update(double increment) override {
+    m_stress = std::min(m_stress + 2.0 * increment, 1.0);
+  }
+  double m_stress{0.0};
+};
+
+// Objects behind unique_ptrs, allocated interleaved with other data and
+// visited in creation order.
+static void BM_heap_objects(benchmark::State &state) {
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  std::vector<std::unique_ptr<point_base>> objects;
+  std::vector<std::unique_ptr<char[]>> noise;
+  std::mt19937 random(42);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (random() % 2 == 0) {
+      objects.push_back(std::make_unique<elastic_point>());
+    } else {
+      objects.push_back(std::make_unique<plastic_point>());
+    }
+    noise.push_back(std::make_unique<char[]>(16 + random() % 256));
+  }
+  noise.clear();
+  for (auto _ : state) {
+    for (auto &object : objects) {
+      object->update(1.0e-6);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(count));
+}
+BENCHMARK(BM_heap_objects)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// The same objects grouped by type in a warehouse.
+static void BM_warehouse_objects(benchmark::State &state) {
+  const auto count{static_cast<std::size_t>(state.range(0))};
+  numsim_core::warehouse<point_base, 1024> objects;
+  std::mt19937 random(42);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (random() % 2 == 0) {
+      objects.emplace<elastic_point>();
+    } else {
+      objects.emplace<plastic_point>();
+    }
+  }
+  for (auto _ : state) {
+    objects.for_each<elastic_point>(
+        [](elastic_point &object) { object.update(1.0e-6); });
+    objects.for_each<plastic_point>(
+        [](plastic_point &object) { object.update(1.0e-6); });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(count));
+}
+BENCHMARK(BM_warehouse_objects)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
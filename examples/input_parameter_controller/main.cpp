@@ -7,6 +7,8 @@
 // Mock implementation of ParameterHandler class.
 class MockParameterHandler {
 public:
+  using type_erasure_type = std::any;
+
   bool contains(const std::string &name) const {
     return parameters.find(name) != parameters.end();
   }
@@ -19,6 +21,11 @@ public:
     parameters[name] = value;
   }
 
+  std::any *find(const std::string &name) {
+    auto pos{parameters.find(name)};
+    return pos == parameters.end() ? nullptr : &pos->second;
+  }
+
 private:
   std::unordered_map<std::string, std::any> parameters;
 };
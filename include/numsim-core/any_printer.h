@@ -2,44 +2,334 @@
 #define ANY_PRINTER_H
 
 #include "numsim_core_utility.h"
+#include "static_indexing.h"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace numsim_core {
 
+/**
+ * @brief An output buffer formatting numbers with std::to_chars.
+ *
+ * Text is collected in a fixed buffer and written to the stream in large
+ * blocks, so printing many values costs no stream call per value. Floating
+ * point numbers are written in their shortest round-trip representation.
+ */
+class print_buffer {
+public:
+  /**
+   * @brief Constructs a buffer writing to a stream.
+   *
+   * @param os The output stream.
+   * @param capacity The size of the buffer in bytes.
+   */
+  explicit print_buffer(std::ostream &os, std::size_t capacity = 1 << 16)
+      : m_os(os), m_data(std::max<std::size_t>(capacity, max_number_size)) {}
+
+  print_buffer(print_buffer const &) = delete;
+
+  print_buffer &operator=(print_buffer const &) = delete;
+
+  /**
+   * @brief Writes the remaining text to the stream.
+   */
+  ~print_buffer() {
+    try {
+      flush();
+    } catch (...) {
+      // a stream with exceptions enabled must not throw from a destructor
+    }
+  }
+
+  /**
+   * @brief Appends text.
+   *
+   * @param text The text.
+   */
+  void write(std::string_view text) {
+    if (text.size() > m_data.size() - m_size) {
+      flush();
+      if (text.size() > m_data.size()) {
+        m_os.write(text.data(), static_cast<std::streamsize>(text.size()));
+        return;
+      }
+    }
+    std::memcpy(m_data.data() + m_size, text.data(), text.size());
+    m_size += text.size();
+  }
+
+  /**
+   * @brief Appends a character.
+   *
+   * @param c The character.
+   */
+  void put(char c) {
+    if (m_size == m_data.size()) {
+      flush();
+    }
+    m_data[m_size++] = c;
+  }
+
+  /**
+   * @brief Appends a number, bool as true or false.
+   *
+   * @param value The number.
+   */
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  void write_number(T value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      write(value ? "true" : "false");
+    } else {
+      if (m_data.size() - m_size < max_number_size) {
+        flush();
+      }
+      const auto result{std::to_chars(m_data.data() + m_size,
+                                      m_data.data() + m_data.size(), value)};
+      m_size = static_cast<std::size_t>(result.ptr - m_data.data());
+    }
+  }
+
+  /**
+   * @brief Appends all numbers of a range, each followed by a separator.
+   *
+   * @param values The numbers.
+   * @param separator The character written after every number.
+   */
+  template <typename T>
+  void write_numbers(std::span<T const> values, char separator = ' ') {
+    for (const auto value : values) {
+      write_number(value);
+      put(separator);
+    }
+  }
+
+  /**
+   * @brief Appends text in double quotes, escaping quotes and backslashes
+   * like std::quoted.
+   *
+   * @param text The text.
+   */
+  void write_quoted(std::string_view text) {
+    put('"');
+    for (const auto c : text) {
+      if (c == '"' || c == '\\') {
+        put('\\');
+      }
+      put(c);
+    }
+    put('"');
+  }
+
+  /**
+   * @brief Writes the buffered text to the stream.
+   */
+  void flush() {
+    if (m_size > 0) {
+      m_os.write(m_data.data(), static_cast<std::streamsize>(m_size));
+      m_size = 0;
+    }
+  }
+
+private:
+  static constexpr std::size_t max_number_size{
+      64}; ///< Upper bound of one formatted number.
+
+  std::ostream &m_os;       ///< The output stream.
+  std::vector<char> m_data; ///< The buffer.
+  std::size_t m_size{0};    ///< Used bytes of the buffer.
+};
+
+/**
+ * @brief Print functions of the bulk printing path, extensible at runtime.
+ *
+ * There is one table per type erasure. An entry formats a value into a
+ * print_buffer. When the type erasure is keyed by dense static ids, as
+ * small_any is, the table is a plain vector indexed by the id; otherwise
+ * the keys are mapped to a slot once per lookup.
+ *
+ * @note Types must be added before printing starts; adding is not
+ * synchronized with concurrent printing.
+ *
+ * @tparam TypeErasure The type erasure, with a type_erasure_traits
+ * specialization.
+ */
+template <typename TypeErasure> class print_table {
+  using traits = type_erasure_traits<TypeErasure>;
+
+public:
+  using key_type = typename traits::key_type; ///< The type key.
+  using visitor = inplace_function<void(
+      TypeErasure const &, print_buffer &)>; ///< The print function type.
+
+  /**
+   * @brief Returns the table of TypeErasure, filled with the built-in types.
+   */
+  static print_table &instance() {
+    static print_table table{builtin_tag{}};
+    return table;
+  }
+
+  /**
+   * @brief Adds or replaces the print function of a type.
+   *
+   * @tparam T The type.
+   * @param func Called as `func(T const &, print_buffer &)`.
+   */
+  template <typename T, typename Function> void add(Function func) {
+    set(traits::template key<T>(),
+        [g = std::move(func)](TypeErasure const &data, print_buffer &out) {
+          using std::any_cast;
+          g(any_cast<T const &>(data), out);
+        });
+  }
+
+  /**
+   * @brief Returns the print function of a type key, or nullptr.
+   *
+   * @param key The type key.
+   */
+  [[nodiscard]] visitor const *find(key_type const &key) const {
+    if constexpr (dense) {
+      return key < m_visitors.size() && m_visitors[key] ? &m_visitors[key]
+                                                        : nullptr;
+    } else {
+      const auto pos{m_slots.find(key)};
+      return pos != m_slots.end() ? &m_visitors[pos->second] : nullptr;
+    }
+  }
+
+private:
+  static constexpr bool dense{std::is_same_v<key_type, type_id>};
+
+  struct builtin_tag {};
+
+  explicit print_table(builtin_tag) {
+    const auto numbers{[](auto const &x, print_buffer &out) {
+      out.write_number(x);
+    }};
+    const auto vector{[](auto const &x, print_buffer &out) {
+      out.write_numbers(std::span(x.data(), x.size()));
+    }};
+    add<int>(numbers);
+    add<unsigned>(numbers);
+    add<long>(numbers);
+    add<float>(numbers);
+    add<double>(numbers);
+    add<bool>(numbers);
+    add<std::string>(
+        [](std::string const &x, print_buffer &out) { out.write(x); });
+    add<char const *>(
+        [](char const *x, print_buffer &out) { out.write_quoted(x); });
+    add<std::vector<int>>(vector);
+    add<std::vector<double>>(vector);
+    add<std::vector<std::string>>(
+        [](std::vector<std::string> const &x, print_buffer &out) {
+          for (const auto &entry : x) {
+            out.write(entry);
+            out.put(' ');
+          }
+        });
+    add<std::tuple<int, double, std::string>>(
+        [](std::tuple<int, double, std::string> const &t, print_buffer &out) {
+          out.put('(');
+          out.write_number(std::get<0>(t));
+          out.write(", ");
+          out.write_number(std::get<1>(t));
+          out.write(", ");
+          out.write_quoted(std::get<2>(t));
+          out.put(')');
+        });
+    add<std::reference_wrapper<const double>>(
+        [](std::reference_wrapper<const double> const &x, print_buffer &out) {
+          out.write_number(x.get());
+        });
+    add<std::reference_wrapper<double>>(
+        [](std::reference_wrapper<double> const &x, print_buffer &out) {
+          out.write_number(x.get());
+        });
+  }
+
+  void set(key_type const &key, visitor &&func) {
+    if constexpr (dense) {
+      if (key >= m_visitors.size()) {
+        m_visitors.resize(key + 1);
+      }
+      m_visitors[key] = std::move(func);
+    } else {
+      const auto [pos, inserted]{m_slots.try_emplace(key, m_visitors.size())};
+      if (inserted) {
+        m_visitors.emplace_back();
+      }
+      m_visitors[pos->second] = std::move(func);
+    }
+  }
+
+  std::vector<visitor> m_visitors; ///< Print functions by slot.
+  std::unordered_map<key_type, std::size_t>
+      m_slots; ///< Slot per key, unused for dense keys.
+};
+
 /**
  * @brief A utility class that provides type-safe printing of `std::any` types.
  *
  * This class contains a static map `any_print_visitor` that stores visitors for
- * various types. Each type is associated with a `std::function` that specifies
- * how to print the contained data in the `std::any` object. This allows for
- * safe, type-erased printing of various types by looking up the appropriate
- * visitor function for the contained type.
+ * various types, built on the first print. Each type is associated with an
+ * `inplace_function` that specifies how to print the contained data of the
+ * type erasure. This allows for safe, type-erased printing of various types
+ * by looking up the appropriate visitor function for the contained type.
  *
  * @note The class supports adding new types by adding additional visitors using
- * the `to_any_visitor` function template.
+ * the `to_erased_visitor` function template.
+ *
+ * @tparam TypeErasure The type erasure to print, any type with a
+ * `type_erasure_traits` specialization (e.g. std::any or small_any).
  *
  * @see std::any
  */
-class any_print_wrapper {
+template <typename TypeErasure> class basic_any_print_wrapper {
+  using traits = type_erasure_traits<TypeErasure>;
+
   /**
    * @brief A static map that holds type-erased printing functions for various
    * types.
    *
-   * This map stores `std::function` objects that accept a `std::any` object and
-   * an `std::ostream&`. It enables safe printing of `std::any` values based on
-   * their type. The key is a `std::type_index` corresponding to the type
-   * contained in the `std::any` object, and the value is the function that
-   * knows how to print that type to the stream.
+   * This map stores `inplace_function` objects that accept a `TypeErasure`
+   * and an `std::ostream&`. It enables safe printing of type-erased values
+   * based on their type. The key is the `traits::key_type` of the contained
+   * type, e.g. a `std::type_index` for std::any or a `type_id` for
+   * small_any, and the value is the function that knows how to print that
+   * type to the stream.
    */
-  static inline const std::unordered_map<
-      std::type_index, std::function<void(std::any const &, std::ostream &)>>
-      any_print_visitor{
+  using visitor_map = std::unordered_map<
+      typename traits::key_type,
+      inplace_function<void(TypeErasure const &, std::ostream &)>>;
+
+  static visitor_map const &any_print_visitor() {
+    // built on first use instead of during static initialization
+    static const visitor_map visitors{make_visitor_map<visitor_map>(
           /**
            * @brief Visitor for printing `int` values from a `std::any` object.
            *
            * Prints the integer value contained in the `std::any` to the given
            * output stream.
            */
-          to_any_visitor<int, std::ostream &>(
+          to_erased_visitor<TypeErasure, int, std::ostream &>(
               [](int x, std::ostream &os) { os << x; }),
 
           /**
@@ -49,7 +339,7 @@ class any_print_wrapper {
            * Prints the unsigned integer value contained in the `std::any` to
            * the given output stream.
            */
-          to_any_visitor<unsigned, std::ostream &>(
+          to_erased_visitor<TypeErasure, unsigned, std::ostream &>(
               [](unsigned x, std::ostream &os) { os << x; }),
 
           /**
@@ -59,7 +349,7 @@ class any_print_wrapper {
            * Prints the floating-point value contained in the `std::any` to the
            * given output stream.
            */
-          to_any_visitor<float, std::ostream &>(
+          to_erased_visitor<TypeErasure, float, std::ostream &>(
               [](float x, std::ostream &os) { os << x; }),
 
           /**
@@ -69,7 +359,7 @@ class any_print_wrapper {
            * Prints the double-precision floating-point value contained in the
            * `std::any` to the given output stream.
            */
-          to_any_visitor<double, std::ostream &>(
+          to_erased_visitor<TypeErasure, double, std::ostream &>(
               [](double x, std::ostream &os) { os << x; }),
 
           /**
@@ -79,7 +369,7 @@ class any_print_wrapper {
            * Prints the string contained in the `std::any` to the given output
            * stream.
            */
-          to_any_visitor<std::string, std::ostream &>(
+          to_erased_visitor<TypeErasure, std::string, std::ostream &>(
               [](std::string const &x, std::ostream &os) { os << x; }),
 
           /**
@@ -89,7 +379,7 @@ class any_print_wrapper {
            * Prints the elements of the vector of strings contained in the
            * `std::any` to the given output stream.
            */
-          to_any_visitor<std::vector<std::string>, std::ostream &>(
+          to_erased_visitor<TypeErasure, std::vector<std::string>, std::ostream &>(
               [](std::vector<std::string> const &x, std::ostream &os) {
                 for (const auto &entry : x) {
                   os << entry << " ";
@@ -103,7 +393,7 @@ class any_print_wrapper {
            * Prints the C-string contained in the `std::any` to the given output
            * stream.
            */
-          to_any_visitor<char const *, std::ostream &>(
+          to_erased_visitor<TypeErasure, char const *, std::ostream &>(
               [](char const *s, std::ostream &os) { os << std::quoted(s); }),
 
           // Additional types
@@ -113,7 +403,7 @@ class any_print_wrapper {
            * Prints the boolean value contained in the `std::any` to the given
            * output stream as "true" or "false".
            */
-          to_any_visitor<bool, std::ostream &>(
+          to_erased_visitor<TypeErasure, bool, std::ostream &>(
               [](bool x, std::ostream &os) { os << (x ? "true" : "false"); }),
 
           /**
@@ -122,7 +412,7 @@ class any_print_wrapper {
            * Prints the long integer value contained in the `std::any` to the
            * given output stream.
            */
-          to_any_visitor<long, std::ostream &>(
+          to_erased_visitor<TypeErasure, long, std::ostream &>(
               [](long x, std::ostream &os) { os << x; }),
 
           /**
@@ -132,7 +422,7 @@ class any_print_wrapper {
            * Prints the elements of the vector of integers contained in the
            * `std::any` to the given output stream.
            */
-          to_any_visitor<std::vector<int>, std::ostream &>(
+          to_erased_visitor<TypeErasure, std::vector<int>, std::ostream &>(
               [](std::vector<int> const &x, std::ostream &os) {
                 for (const auto &entry : x) {
                   os << entry << " ";
@@ -146,7 +436,7 @@ class any_print_wrapper {
            * Prints the elements of the vector of doubles contained in the
            * `std::any` to the given output stream.
            */
-          to_any_visitor<std::vector<double>, std::ostream &>(
+          to_erased_visitor<TypeErasure, std::vector<double>, std::ostream &>(
               [](std::vector<double> const &x, std::ostream &os) {
                 for (const auto &entry : x) {
                   os << entry << " ";
@@ -160,20 +450,22 @@ class any_print_wrapper {
            * Prints the elements of the tuple `(int, double, std::string)`
            * contained in the `std::any` to the given output stream.
            */
-          to_any_visitor<std::tuple<int, double, std::string>, std::ostream &>(
+          to_erased_visitor<TypeErasure, std::tuple<int, double, std::string>, std::ostream &>(
               [](std::tuple<int, double, std::string> const &t,
                  std::ostream &os) {
                 os << "(" << std::get<0>(t) << ", " << std::get<1>(t) << ", "
                    << std::quoted(std::get<2>(t)) << ")";
               }),
 
-          to_any_visitor<std::reference_wrapper<const double>, std::ostream &>(
+          to_erased_visitor<TypeErasure, std::reference_wrapper<const double>, std::ostream &>(
               [](std::reference_wrapper<const double> const &x, std::ostream &os) {
                 os << x.get(); }),
 
-          to_any_visitor<std::reference_wrapper<double>, std::ostream &>(
+          to_erased_visitor<TypeErasure, std::reference_wrapper<double>, std::ostream &>(
       [](std::reference_wrapper<double> const &x, std::ostream &os) {
-               os << x.get(); })};
+               os << x.get(); }))};
+    return visitors;
+  }
 
 public:
   /**
@@ -182,7 +474,7 @@ public:
    *
    * @param data The `std::any` object to be printed.
    */
-  explicit any_print_wrapper(std::any const &data) : m_data(data) {}
+  explicit basic_any_print_wrapper(TypeErasure const &data) : m_data(data) {}
 
   /**
    * @brief Overloads the stream insertion operator to print the wrapped
@@ -194,23 +486,113 @@ public:
    * @param os The output stream.
    * @param data The `any_print_wrapper` object containing the `std::any` data.
    * @return std::ostream& The output stream after printing.
-   * @throws std::runtime_error If the type contained in `std::any` is not found
-   * in the `any_print_visitor`.
+   * Types without a visitor are looked up in the print_table, so types added
+   * there at runtime are printable as well.
+   *
+   * @throws std::runtime_error If the type contained in `std::any` is found
+   * neither in the `any_print_visitor` nor in the print_table.
+   */
+  friend std::ostream &operator<<(std::ostream &os,
+                                  basic_any_print_wrapper data) {
+    auto const &visitors{any_print_visitor()};
+    auto pos = visitors.find(traits::key(data.m_data));
+    if (pos != visitors.end()) {
+      pos->second(data.m_data, os);
+      return os;
+    }
+    // types added at runtime to the print_table
+    if (auto const *func{print_table<TypeErasure>::instance().find(
+            traits::key(data.m_data))}) {
+      print_buffer out(os, 256);
+      (*func)(data.m_data, out);
+      return os;
+    }
+    throw std::runtime_error("type id " + traits::name(data.m_data) +
+                             " not found\n");
+  }
+
+private:
+  TypeErasure const &m_data; ///< The type-erased object being printed.
+};
+
+/**
+ * @brief Printer for `std::any` values.
+ */
+using any_print_wrapper = basic_any_print_wrapper<std::any>;
+
+/**
+ * @brief Bulk printer for type-erased values.
+ *
+ * Formats values through the print_table into a print_buffer: one table
+ * lookup and one call per value, numbers via std::to_chars and whole vectors
+ * in one call, and the stream sees only block writes. Consecutive values of
+ * the same type reuse the previous lookup.
+ *
+ * @code
+ * numsim_core::value_printer out(std::cout);
+ * handler.print(out);
+ * @endcode
+ *
+ * @tparam TypeErasure The type erasure to print.
+ */
+template <typename TypeErasure> class basic_value_printer {
+  using table = print_table<TypeErasure>;
+
+public:
+  /**
+   * @brief Constructs a printer writing to a stream.
+   *
+   * @param os The output stream.
+   * @param capacity The size of the buffer in bytes.
+   */
+  explicit basic_value_printer(std::ostream &os,
+                               std::size_t capacity = 1 << 16)
+      : m_out(os, capacity), m_table(table::instance()) {}
+
+  /**
+   * @brief Prints a value.
+   *
+   * @param data The value.
+   * @return This printer.
+   * @throws std::runtime_error if the type has no print function.
    */
-  friend std::ostream &operator<<(std::ostream &os, any_print_wrapper data) {
-    auto pos = any_print_visitor.find(std::type_index(data.m_data.type()));
-    if (pos == any_print_visitor.end()) {
-      throw std::runtime_error(
-          "type id " + std::string(data.m_data.type().name()) + " not found\n");
+  basic_value_printer &operator()(TypeErasure const &data) {
+    using traits = type_erasure_traits<TypeErasure>;
+    const auto key{traits::key(data)};
+    if (m_last == nullptr || !(key == *m_last_key)) {
+      m_last = m_table.find(key);
+      if (m_last == nullptr) {
+        throw std::runtime_error("type id " + traits::name(data) +
+                                 " not found\n");
+      }
+      m_last_key = key;
     }
-    pos->second(data.m_data, os);
-    return os;
+    (*m_last)(data, m_out);
+    return *this;
   }
 
+  /**
+   * @brief Returns the buffer, e.g. to write keys and separators.
+   */
+  print_buffer &buffer() noexcept { return m_out; }
+
+  /**
+   * @brief Writes the buffered text to the stream.
+   */
+  void flush() { m_out.flush(); }
+
 private:
-  std::any const &m_data; ///< The `std::any` object being printed.
+  print_buffer m_out;                          ///< The output buffer.
+  table const &m_table;                        ///< The print functions.
+  typename table::visitor const *m_last{nullptr}; ///< Last print function.
+  std::optional<typename table::key_type> m_last_key; ///< Its key.
 };
 
+/**
+ * @brief Bulk printer for `std::any` values.
+ */
+using value_printer = basic_value_printer<std::any>;
+
 } // namespace numsim_core
 
 inline auto print(std::any const &data) {
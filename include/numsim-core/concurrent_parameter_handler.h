@@ -0,0 +1,284 @@
+#ifndef CONCURRENT_PARAMETER_HANDLER_H
+#define CONCURRENT_PARAMETER_HANDLER_H
+
+#include "parameter_handler.h"
+#include <any>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace numsim_core {
+
+namespace detail {
+/**
+ * @brief Reader counters of one slot, padded to a cache line so readers in
+ * different slots do not contend.
+ */
+struct alignas(64) reader_slot {
+  std::array<std::atomic<std::uint64_t>, 2> m_readers{}; ///< Per parity.
+};
+
+/**
+ * @brief Returns the reader slot of the calling thread.
+ *
+ * Threads are assigned round-robin on first use.
+ *
+ * @param count The number of slots.
+ */
+inline std::size_t reader_slot_index(std::size_t count) noexcept {
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t index{
+      next.fetch_add(1, std::memory_order_relaxed)};
+  return index % count;
+}
+} // namespace detail
+
+/**
+ * @brief A parameter_handler shared by many reading threads and updated
+ * rarely.
+ *
+ * The parameters live in an immutable parameter_handler version. Readers
+ * announce themselves in a per-thread counter slot and read the current
+ * version without a lock; writers copy the current version, apply all
+ * changes of one update() to the copy, publish it with one atomic store and
+ * free the previous version once every reader that may still see it has
+ * left (read-copy-update with sharded reader counters). A read touches only
+ * the cache line of its slot, so it does not contend with other readers;
+ * it retries only if an update flips the reader parity at the same moment.
+ *
+ * The interface follows parameter_handler, with the template parameters of
+ * parameter_handler, so code templated on the handler type can select it.
+ * Because a version may be replaced after a call returns, get() returns a
+ * copy; read() gives consistent access to one version without copying.
+ *
+ * @code
+ * numsim_core::concurrent_parameter_handler<> shared;
+ * shared.update([](auto &handler) {
+ *   handler.insert("load_factor", 0.5);
+ *   handler.insert("step", 10);
+ * });
+ * const auto factor{shared.get<double>("load_factor")}; // from any thread
+ * @endcode
+ *
+ * @tparam KeyType Type of the keys used for storing parameters.
+ * @tparam TypeErasure Type used for the values stored in the handler.
+ * @tparam Map Storage policy of the underlying parameter_handler.
+ */
+template <typename KeyType = std::string, typename TypeErasure = std::any,
+          template <class... ArgsMap> class Map = std::unordered_map>
+class concurrent_parameter_handler {
+public:
+  using handler_type = parameter_handler<KeyType, TypeErasure,
+                                         Map>; ///< The immutable versions.
+  using key_type = KeyType;           ///< The key type.
+  using type_erasure_type = TypeErasure; ///< The type-erased value type.
+
+  /**
+   * @brief Read access to one version, keeping it alive while it exists.
+   */
+  class read_guard {
+  public:
+    read_guard(read_guard const &) = delete;
+
+    read_guard &operator=(read_guard const &) = delete;
+
+    /**
+     * @brief Leaves the read side.
+     */
+    ~read_guard() {
+      m_counter->fetch_sub(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the version.
+     */
+    handler_type const &operator*() const noexcept { return *m_handler; }
+
+    /**
+     * @brief Accesses the version.
+     */
+    handler_type const *operator->() const noexcept { return m_handler; }
+
+  private:
+    friend class concurrent_parameter_handler;
+
+    explicit read_guard(concurrent_parameter_handler const &owner) {
+      auto &slot{owner.m_slots[detail::reader_slot_index(slot_count)]};
+      while (true) {
+        const auto parity{owner.m_parity.load()};
+        slot.m_readers[parity].fetch_add(1);
+        if (owner.m_parity.load() == parity) {
+          m_counter = &slot.m_readers[parity];
+          break;
+        }
+        // an update flipped the parity meanwhile and may not wait for us
+        slot.m_readers[parity].fetch_sub(1);
+      }
+      m_handler = owner.m_current.load();
+    }
+
+    std::atomic<std::uint64_t> *m_counter{nullptr}; ///< The entered counter.
+    handler_type const *m_handler{nullptr};         ///< The read version.
+  };
+
+  /**
+   * @brief Constructs an empty handler.
+   */
+  concurrent_parameter_handler() : m_current(new handler_type()) {}
+
+  /**
+   * @brief Constructs a handler publishing a copy of the given parameters.
+   *
+   * @param handler The initial parameters.
+   */
+  explicit concurrent_parameter_handler(handler_type handler)
+      : m_current(new handler_type(std::move(handler))) {}
+
+  concurrent_parameter_handler(concurrent_parameter_handler const &) = delete;
+
+  concurrent_parameter_handler &
+  operator=(concurrent_parameter_handler const &) = delete;
+
+  /**
+   * @brief Frees the current version; no reader may be active.
+   */
+  ~concurrent_parameter_handler() { delete m_current.load(); }
+
+  /**
+   * @brief Enters the read side and returns the current version.
+   *
+   * Updates published while the guard exists do not affect it; they wait
+   * for the guard before freeing the version.
+   */
+  [[nodiscard]] read_guard read() const { return read_guard(*this); }
+
+  /**
+   * @brief Calls a function with the current version.
+   *
+   * @param func Called as `func(handler_type const &)`.
+   * @return The result of func.
+   */
+  template <typename Function> decltype(auto) read(Function &&func) const {
+    const read_guard guard(*this);
+    return std::forward<Function>(func)(*guard);
+  }
+
+  /**
+   * @brief Returns a copy of a value.
+   *
+   * @tparam T The type of the value.
+   * @param name The key of the value.
+   * @throws std::invalid_argument if the key is not found.
+   * @throws std::bad_any_cast if the stored value is not of type T.
+   */
+  template <typename T, typename K> T get(K const &name) const {
+    const read_guard guard(*this);
+    return guard->template get<T>(name);
+  }
+
+  /**
+   * @brief Checks whether a key is stored.
+   *
+   * @param name The key.
+   */
+  template <typename K> bool contains(K const &name) const {
+    const read_guard guard(*this);
+    return guard->contains(name);
+  }
+
+  /**
+   * @brief Returns the number of stored parameters.
+   */
+  [[nodiscard]] std::size_t size() const {
+    const read_guard guard(*this);
+    return guard->size();
+  }
+
+  /**
+   * @brief Applies a batch of changes and publishes them atomically.
+   *
+   * Readers see either none or all of the changes. Updates are serialized;
+   * the call returns once every reader of the replaced version has left and
+   * the version is freed, so it must not be called by a thread holding a
+   * read_guard of this handler. If func throws, nothing is published.
+   *
+   * @param func Called as `func(handler_type &)` on a copy of the current
+   * version.
+   */
+  template <typename Function> void update(Function &&func) {
+    const std::lock_guard<std::mutex> lock(m_update);
+    auto next{std::make_unique<handler_type>(*m_current.load())};
+    std::forward<Function>(func)(*next);
+    publish(next.release());
+  }
+
+  /**
+   * @brief Inserts or assigns one value; see update() for batches and the
+   * restrictions.
+   *
+   * @param name The key.
+   * @param value The value.
+   */
+  template <typename T> void insert(KeyType name, T &&value) {
+    update([&](handler_type &handler) {
+      handler.insert(std::move(name), std::forward<T>(value));
+    });
+  }
+
+  /**
+   * @brief Removes all parameters; see update() for the restrictions.
+   */
+  void clear() {
+    const std::lock_guard<std::mutex> lock(m_update);
+    publish(new handler_type());
+  }
+
+  /**
+   * @brief Prints all key-value pairs of the current version.
+   *
+   * @param os The output stream.
+   */
+  void print(std::ostream &os) const {
+    const read_guard guard(*this);
+    // print() of parameter_handler is not const, the version is not changed
+    const_cast<handler_type &>(*guard).print(os);
+  }
+
+private:
+  static constexpr std::size_t slot_count{64}; ///< Number of reader slots.
+
+  /**
+   * @brief Publishes a version and frees the previous one after all of its
+   * readers left.
+   */
+  void publish(handler_type *next) {
+    auto *previous{m_current.exchange(next)};
+    const auto parity{m_parity.fetch_xor(1)};
+    for (auto &slot : m_slots) {
+      // seq_cst like the reader's increment and parity check: with a weaker
+      // load the writer may see no reader while one still sees the old parity
+      while (slot.m_readers[parity].load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+      }
+    }
+    delete previous;
+  }
+
+  std::atomic<handler_type *> m_current;        ///< The published version.
+  mutable std::array<detail::reader_slot, slot_count>
+      m_slots{};                                 ///< Reader counters.
+  std::atomic<unsigned> m_parity{0};             ///< Parity of new readers.
+  std::mutex m_update;                           ///< Serializes updates.
+};
+
+} // namespace numsim_core
+
+#endif // CONCURRENT_PARAMETER_HANDLER_H
@@ -1,10 +1,21 @@
 #ifndef FACTORY_BASE_BONES_H
 #define FACTORY_BASE_BONES_H
 
-#include <string>
+#include "numsim_core_utility.h"
+#include "static_indexing.h"
+#include <cstddef>
+#include <functional>
 #include <memory>
-#include <vector>
 #include <map>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace numsim_core {
 
@@ -12,20 +23,145 @@ template <typename Type>
 class factory_base
 {
 public:
+    /**
+     * @brief Objects cloned from one prototype, stored contiguously.
+     */
+    class batch
+    {
+    public:
+        batch() = default;
+
+        batch(batch const&) = delete;
+
+        batch& operator=(batch const&) = delete;
+
+        batch(batch&& other) noexcept:
+            m_data(std::exchange(other.m_data, nullptr)),
+            m_size(std::exchange(other.m_size, 0)),
+            m_type(other.m_type),
+            m_at(other.m_at),
+            m_destroy(other.m_destroy)
+        {}
+
+        batch& operator=(batch&& other) noexcept {
+            if(this != &other){
+                reset();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+                m_type = other.m_type;
+                m_at = other.m_at;
+                m_destroy = other.m_destroy;
+            }
+            return *this;
+        }
+
+        ~batch(){
+            reset();
+        }
+
+        std::size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        Type& operator[](std::size_t index){
+            return *m_at(m_data, index);
+        }
+
+        Type const& operator[](std::size_t index) const {
+            return *m_at(m_data, index);
+        }
+
+        //typed view for hot loops, throws if the objects are of another type
+        template<typename Derived>
+        std::span<Derived> view(){
+            if(m_data == nullptr || m_type != static_type_id<Derived, Type>()){
+                throw std::invalid_argument("numsim_core::factory_base::batch: objects are not of the requested type");
+            }
+            return {static_cast<Derived*>(m_data), m_size};
+        }
+
+    private:
+        friend class factory_base;
+
+        void reset(){
+            if(m_data != nullptr){
+                m_destroy(m_data, m_size);
+                m_data = nullptr;
+                m_size = 0;
+            }
+        }
+
+        void* m_data{nullptr};
+        std::size_t m_size{0};
+        type_id m_type{0};
+        Type* (*m_at)(void*, std::size_t){nullptr};
+        void (*m_destroy)(void*, std::size_t){nullptr};
+    };
+
     factory_base():
         m_data(),
         m_data_ptr()
     {}
 
+    factory_base(factory_base const&) = delete;
+
+    factory_base& operator=(factory_base const&) = delete;
+
+    //the prototypes stay in place, so the cached pointers survive a move
+    factory_base(factory_base&&) noexcept = default;
+
+    factory_base& operator=(factory_base&&) noexcept = default;
+
     ~factory_base(){}
 
-    template<typename Derived>
-    void add(std::string&& name){
-        m_data[name] = std::move(std::make_unique<Derived>());
+    //stores a prototype constructed from args, replacing an existing one
+    template<typename Derived, typename ...Args>
+    void add(std::string name, Args&&... args){
+        static_assert(std::is_base_of_v<Type, Derived>, "factory_base: Derived must derive from Type");
+        auto object{std::make_unique<Derived>(std::forward<Args>(args)...)};
+        entry data{object.get(), nullptr, nullptr};
+        if constexpr (std::is_copy_constructible_v<Derived>){
+            data.m_clone = &clone_func<Derived>;
+            data.m_create_n = &create_n_func<Derived>;
+        }
+        m_data_ptr.insert_or_assign(name, data);
+        m_data.insert_or_assign(std::move(name), std::move(object));
+    }
+
+    //returns the prototype of name
+    Type* get(std::string_view name) const {
+        return find_or_throw(name).m_prototype;
+    }
+
+    bool contains(std::string_view name) const {
+        return m_data_ptr.find(name) != m_data_ptr.end();
     }
 
-    auto get(std::string name){
-        return m_data.find(name)->second.get();
+    //copy constructs a new object from the prototype of name
+    std::unique_ptr<Type> create(std::string_view name) const {
+        auto const& data{find_or_throw(name)};
+        throw_if_not_clonable(data, name);
+        return data.m_clone(*data.m_prototype);
+    }
+
+    //copy constructs count objects from the prototype of name into one
+    //contiguous buffer, the name is looked up once
+    batch create_n(std::string_view name, std::size_t count) const {
+        auto const& data{find_or_throw(name)};
+        throw_if_not_clonable(data, name);
+        batch result;
+        if(count > 0){
+            data.m_create_n(result, *data.m_prototype, count);
+        }
+        return result;
+    }
+
+    std::size_t size() const {
+        return m_data.size();
     }
 
     template<typename Derived>
@@ -34,8 +170,56 @@ public:
     }
 
 private:
-    std::map<std::string, std::unique_ptr<Type>> m_data;
-    std::map<std::string, Type*> m_data_ptr;
+    struct entry
+    {
+        Type* m_prototype;
+        std::unique_ptr<Type>(*m_clone)(Type const&);
+        void(*m_create_n)(batch&, Type const&, std::size_t);
+    };
+
+    template<typename Derived>
+    static std::unique_ptr<Type> clone_func(Type const& prototype){
+        return std::make_unique<Derived>(static_cast<Derived const&>(prototype));
+    }
+
+    template<typename Derived>
+    static void create_n_func(batch& result, Type const& prototype, std::size_t count){
+        auto* data{static_cast<Derived*>(::operator new(sizeof(Derived) * count, std::align_val_t{alignof(Derived)}))};
+        try{
+            std::uninitialized_fill_n(data, count, static_cast<Derived const&>(prototype));
+        }catch(...){
+            ::operator delete(data, std::align_val_t{alignof(Derived)});
+            throw;
+        }
+        result.m_data = data;
+        result.m_size = count;
+        result.m_type = static_type_id<Derived, Type>();
+        result.m_at = [](void* objects, std::size_t index) -> Type* {
+            return static_cast<Derived*>(objects) + index;
+        };
+        result.m_destroy = [](void* objects, std::size_t size){
+            std::destroy_n(static_cast<Derived*>(objects), size);
+            ::operator delete(objects, std::align_val_t{alignof(Derived)});
+        };
+    }
+
+    entry const& find_or_throw(std::string_view name) const {
+        const auto iter{m_data_ptr.find(name)};
+        if(iter == m_data_ptr.end()){
+            throw std::runtime_error("numsim_core::factory_base: " + std::string(name) + " is not a valid input");
+        }
+        return iter->second;
+    }
+
+    static void throw_if_not_clonable(entry const& data, std::string_view name){
+        if(data.m_clone == nullptr){
+            throw std::logic_error("numsim_core::factory_base: " + std::string(name) + " is not copy constructible");
+        }
+    }
+
+    std::map<std::string, std::unique_ptr<Type>, std::less<>> m_data;
+    //cached prototype pointers and copy functions, looked up by string_view
+    std::unordered_map<std::string, entry, string_hash, std::equal_to<>> m_data_ptr;
 };
 
 }
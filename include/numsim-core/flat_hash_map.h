@@ -0,0 +1,455 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "numsim_core_utility.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace numsim_core {
+
+/**
+ * @brief A cache-friendly open-addressing hash map.
+ *
+ * The key/value pairs are stored densely in one contiguous array in insertion
+ * order, while a separate power-of-two slot table maps hashes to positions in
+ * that array using linear probing. Lookups therefore touch one small slot
+ * array and one entry, and iteration is a linear sweep over contiguous memory.
+ *
+ * The interface mirrors the subset of `std::unordered_map` used throughout
+ * numsim-core, so the class can be passed wherever a
+ * `template <class...> class Map` is expected.
+ *
+ * @note Unlike node-based maps, inserting new keys may relocate the stored
+ * entries, which invalidates references and iterators. Erasing a key moves the
+ * last entry into the freed position.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The mapped type.
+ * @tparam Hash The hash function object type.
+ * @tparam KeyEqual The key comparison function object type.
+ * @tparam Allocator The allocator used for the entry and slot arrays.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<Key, Value>>>
+class flat_hash_map {
+public:
+  using key_type = Key;                       ///< The key type.
+  using mapped_type = Value;                  ///< The mapped type.
+  using value_type = std::pair<Key, Value>;   ///< The stored entry type.
+  using size_type = std::size_t;              ///< The size type.
+  using hasher = Hash;                        ///< The hash function type.
+  using key_equal = KeyEqual;                 ///< The key comparison type.
+  using allocator_type = Allocator;           ///< The allocator type.
+  using iterator = typename std::vector<value_type,
+                                        Allocator>::iterator; ///< Iterator.
+  using const_iterator =
+      typename std::vector<value_type,
+                           Allocator>::const_iterator; ///< Const iterator.
+
+  /**
+   * @brief Constructs an empty map.
+   */
+  flat_hash_map() = default;
+
+  /**
+   * @brief Constructs an empty map using the given allocator.
+   *
+   * @param alloc The allocator for all internal storage.
+   */
+  explicit flat_hash_map(allocator_type const &alloc)
+      : m_entries(alloc), m_slots(slot_allocator(alloc)) {}
+
+  /**
+   * @brief Returns the allocator of the map.
+   */
+  allocator_type get_allocator() const noexcept {
+    return m_entries.get_allocator();
+  }
+
+  /**
+   * @brief Returns an iterator to the first entry.
+   */
+  iterator begin() noexcept { return m_entries.begin(); }
+
+  /**
+   * @brief Returns a const iterator to the first entry.
+   */
+  const_iterator begin() const noexcept { return m_entries.begin(); }
+
+  /**
+   * @brief Returns an iterator past the last entry.
+   */
+  iterator end() noexcept { return m_entries.end(); }
+
+  /**
+   * @brief Returns a const iterator past the last entry.
+   */
+  const_iterator end() const noexcept { return m_entries.end(); }
+
+  /**
+   * @brief Returns the number of stored entries.
+   */
+  size_type size() const noexcept { return m_entries.size(); }
+
+  /**
+   * @brief Checks whether the map is empty.
+   */
+  bool empty() const noexcept { return m_entries.empty(); }
+
+  /**
+   * @brief Removes all entries while keeping the allocated slot table.
+   */
+  void clear() noexcept {
+    m_entries.clear();
+    for (auto &slot : m_slots) {
+      slot = slot_type{};
+    }
+  }
+
+  /**
+   * @brief Reserves space for at least `count` entries without rehashing.
+   *
+   * @param count The number of entries to reserve space for.
+   */
+  void reserve(size_type count) {
+    m_entries.reserve(count);
+    if (count * 2 > m_slots.size()) {
+      rehash(count * 2);
+    }
+  }
+
+  /**
+   * @brief Finds the entry with the given key.
+   *
+   * @param key The key to search for.
+   * @return An iterator to the entry, or `end()` if the key is not present.
+   */
+  iterator find(Key const &key) {
+    const auto index{find_index(key)};
+    return index == npos ? end() : m_entries.begin() + index;
+  }
+
+  /**
+   * @brief Finds the entry with the given key (const overload).
+   *
+   * @param key The key to search for.
+   * @return A const iterator to the entry, or `end()` if not present.
+   */
+  const_iterator find(Key const &key) const {
+    const auto index{find_index(key)};
+    return index == npos ? end() : m_entries.begin() + index;
+  }
+
+  /**
+   * @brief Checks whether the map contains the given key.
+   *
+   * @param key The key to search for.
+   * @return True if the key is present.
+   */
+  bool contains(Key const &key) const { return find_index(key) != npos; }
+
+  /**
+   * @brief Finds the entry with a key comparing equal to `key`.
+   *
+   * Only available if Hash and KeyEqual are transparent.
+   *
+   * @param key The key to search for.
+   * @return An iterator to the entry, or `end()` if the key is not present.
+   */
+  template <typename K>
+    requires(is_transparent_v<Hash> && is_transparent_v<KeyEqual>)
+  iterator find(K const &key) {
+    const auto index{find_index(key)};
+    return index == npos ? end() : m_entries.begin() + index;
+  }
+
+  /**
+   * @brief Finds the entry with a key comparing equal to `key` (const
+   * overload).
+   *
+   * @param key The key to search for.
+   * @return A const iterator to the entry, or `end()` if not present.
+   */
+  template <typename K>
+    requires(is_transparent_v<Hash> && is_transparent_v<KeyEqual>)
+  const_iterator find(K const &key) const {
+    const auto index{find_index(key)};
+    return index == npos ? end() : m_entries.begin() + index;
+  }
+
+  /**
+   * @brief Checks whether the map contains a key comparing equal to `key`.
+   *
+   * @param key The key to search for.
+   * @return True if the key is present.
+   */
+  template <typename K>
+    requires(is_transparent_v<Hash> && is_transparent_v<KeyEqual>)
+  bool contains(K const &key) const {
+    return find_index(key) != npos;
+  }
+
+  /**
+   * @brief Accesses the value of a key, default-constructing it if absent.
+   *
+   * @param key The key of the element.
+   * @return A reference to the mapped value.
+   */
+  Value &operator[](Key const &key) { return try_emplace(key).first->second; }
+
+  /**
+   * @brief Accesses the value of a key, default-constructing it if absent.
+   *
+   * @param key The key of the element.
+   * @return A reference to the mapped value.
+   */
+  Value &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  /**
+   * @brief Inserts a new element if the key is not present.
+   *
+   * @tparam K The type of the key argument.
+   * @tparam Args The types of the arguments used to construct the value.
+   * @param key The key of the element.
+   * @param args The arguments used to construct the value.
+   * @return A pair of an iterator to the element and a flag that is true if
+   * the element was inserted.
+   */
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(K &&key, Args &&...args) {
+    const auto hash{hash_key(key)};
+    if (const auto index{find_index(key, hash)}; index != npos) {
+      return {m_entries.begin() + index, false};
+    }
+    return {emplace_new(hash, std::forward<K>(key),
+                        std::forward<Args>(args)...),
+            true};
+  }
+
+  /**
+   * @brief Inserts a new element or assigns to the existing one.
+   *
+   * @tparam K The type of the key argument.
+   * @tparam M The type of the value argument.
+   * @param key The key of the element.
+   * @param value The value to insert or assign.
+   * @return A pair of an iterator to the element and a flag that is true if
+   * the element was inserted.
+   */
+  template <typename K, typename M>
+  std::pair<iterator, bool> insert_or_assign(K &&key, M &&value) {
+    const auto hash{hash_key(key)};
+    if (const auto index{find_index(key, hash)}; index != npos) {
+      m_entries[index].second = std::forward<M>(value);
+      return {m_entries.begin() + index, false};
+    }
+    return {emplace_new(hash, std::forward<K>(key), std::forward<M>(value)),
+            true};
+  }
+
+  /**
+   * @brief Removes the element with the given key.
+   *
+   * The last entry is moved into the freed position to keep the storage dense.
+   *
+   * @param key The key of the element to remove.
+   * @return The number of removed elements (0 or 1).
+   */
+  size_type erase(Key const &key) {
+    if (m_slots.empty()) {
+      return 0;
+    }
+    const auto hash{hash_key(key)};
+    auto pos{hash & mask()};
+    while (m_slots[pos].m_index != empty_index) {
+      const auto index{m_slots[pos].m_index};
+      if (m_slots[pos].m_hash == hash &&
+          m_equal(m_entries[index].first, key)) {
+        remove_slot(pos);
+        move_last_into(index);
+        return 1;
+      }
+      pos = (pos + 1) & mask();
+    }
+    return 0;
+  }
+
+private:
+  /**
+   * @brief A slot of the open-addressing table.
+   */
+  struct slot_type {
+    std::uint32_t m_index{empty_index}; ///< Position in the entry array.
+    std::uint32_t m_hash{0};            ///< Cached (mixed) hash value.
+  };
+
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<slot_type>; ///< Slot allocator type.
+
+  static constexpr std::uint32_t empty_index{
+      std::numeric_limits<std::uint32_t>::max()}; ///< Marks an unused slot.
+  static constexpr size_type npos{
+      std::numeric_limits<size_type>::max()}; ///< Marks a failed lookup.
+
+  /**
+   * @brief Hashes a key and mixes the result to spread poor hash functions.
+   */
+  template <typename K> std::uint32_t hash_key(K const &key) const {
+    const auto hash{static_cast<std::uint64_t>(m_hash(key)) *
+                    0x9E3779B97F4A7C15ull};
+    return static_cast<std::uint32_t>(hash >> 32);
+  }
+
+  /**
+   * @brief Returns the bit mask used to wrap slot positions.
+   */
+  size_type mask() const noexcept { return m_slots.size() - 1; }
+
+  /**
+   * @brief Looks up the entry position of a key.
+   */
+  template <typename K> size_type find_index(K const &key) const {
+    return m_slots.empty() ? npos : find_index(key, hash_key(key));
+  }
+
+  /**
+   * @brief Looks up the entry position of a key with a precomputed hash.
+   */
+  template <typename K>
+  size_type find_index(K const &key, std::uint32_t hash) const {
+    if (m_slots.empty()) {
+      return npos;
+    }
+    auto pos{hash & mask()};
+    while (m_slots[pos].m_index != empty_index) {
+      const auto &slot{m_slots[pos]};
+      if (slot.m_hash == hash && m_equal(m_entries[slot.m_index].first, key)) {
+        return slot.m_index;
+      }
+      pos = (pos + 1) & mask();
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Appends a new entry and registers it in the slot table.
+   */
+  template <typename K, typename... Args>
+  iterator emplace_new(std::uint32_t hash, K &&key, Args &&...args) {
+    if ((m_entries.size() + 1) * 2 > m_slots.size()) {
+      rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+    }
+    m_entries.emplace_back(std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    insert_slot(hash, static_cast<std::uint32_t>(m_entries.size() - 1));
+    return m_entries.end() - 1;
+  }
+
+  /**
+   * @brief Places an entry position into the first free slot of its probe
+   * sequence.
+   */
+  void insert_slot(std::uint32_t hash, std::uint32_t index) {
+    auto pos{hash & mask()};
+    while (m_slots[pos].m_index != empty_index) {
+      pos = (pos + 1) & mask();
+    }
+    m_slots[pos] = slot_type{index, hash};
+  }
+
+  /**
+   * @brief Rebuilds the slot table with at least `count` slots.
+   */
+  void rehash(size_type count) {
+    size_type capacity{16};
+    while (capacity < count) {
+      capacity *= 2;
+    }
+    std::vector<slot_type, slot_allocator> slots(capacity,
+                                                 m_slots.get_allocator());
+    std::swap(m_slots, slots);
+    for (const auto &slot : slots) {
+      if (slot.m_index != empty_index) {
+        insert_slot(slot.m_hash, slot.m_index);
+      }
+    }
+  }
+
+  /**
+   * @brief Clears a slot using backward-shift deletion so that no tombstones
+   * are needed.
+   *
+   * Scans to the end of the cluster; an entry moves into the hole unless its
+   * home slot lies cyclically in (hole, current], where it stays reachable.
+   */
+  void remove_slot(size_type pos) {
+    auto next{(pos + 1) & mask()};
+    while (m_slots[next].m_index != empty_index) {
+      const auto home{m_slots[next].m_hash & mask()};
+      if (((next - home) & mask()) >= ((next - pos) & mask())) {
+        m_slots[pos] = m_slots[next];
+        pos = next;
+      }
+      next = (next + 1) & mask();
+    }
+    m_slots[pos] = slot_type{};
+  }
+
+  /**
+   * @brief Moves the last entry into `index` and updates its slot.
+   */
+  void move_last_into(size_type index) {
+    const auto last{m_entries.size() - 1};
+    if (index != last) {
+      auto pos{hash_key(m_entries[last].first) & mask()};
+      while (m_slots[pos].m_index != last) {
+        pos = (pos + 1) & mask();
+      }
+      m_slots[pos].m_index = static_cast<std::uint32_t>(index);
+      m_entries[index] = std::move(m_entries[last]);
+    }
+    m_entries.pop_back();
+  }
+
+  std::vector<value_type, Allocator> m_entries{}; ///< Dense key/value storage.
+  std::vector<slot_type, slot_allocator>
+      m_slots{}; ///< Open-addressing slot table.
+  [[no_unique_address]] Hash m_hash{}; ///< The hash function object.
+  [[no_unique_address]] KeyEqual m_equal{}; ///< The key comparison object.
+};
+
+namespace pmr {
+/**
+ * @brief flat_hash_map using a polymorphic allocator.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using flat_hash_map =
+    numsim_core::flat_hash_map<Key, Value, Hash, KeyEqual,
+                               std::pmr::polymorphic_allocator<
+                                   std::pair<Key, Value>>>;
+} // namespace pmr
+
+/**
+ * @brief flat_hash_map relocates its entries when it grows.
+ */
+template <> struct has_stable_references<flat_hash_map> : std::false_type {};
+
+/**
+ * @brief pmr::flat_hash_map relocates its entries when it grows.
+ */
+template <>
+struct has_stable_references<pmr::flat_hash_map> : std::false_type {};
+
+} // namespace numsim_core
+
+#endif // FLAT_HASH_MAP_H
@@ -1,11 +1,24 @@
 #ifndef INPUT_PARAMETER_CONTROLLER_H
 #define INPUT_PARAMETER_CONTROLLER_H
 
+#include "input_parser.h"
+#include "instrumentation.h"
+#include "numsim_core_utility.h"
+#include "parallel.h"
+#include <algorithm>
 #include <any>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <fstream>
+#include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -28,6 +41,66 @@ namespace numsim_core {
 template <typename T, typename KeyType, typename ParameterHandler>
 class input_parameter;
 
+/**
+ * @brief Number of handlers per word of the masks of input_parameter_column
+ * and input_parameter_mask.
+ */
+inline constexpr std::size_t input_parameter_mask_word_bits{64};
+
+/**
+ * @brief The values of one parameter gathered across many handlers, see
+ * input_parameter_controller::check_columns.
+ *
+ * Bit i of word i / word_bits of a mask refers to handler i.
+ *
+ * @tparam T The type of the parameter.
+ * @tparam ParameterHandler The type of the handler that manages parameters.
+ */
+template <typename T, typename ParameterHandler> struct input_parameter_column {
+  static constexpr std::size_t word_bits{
+      input_parameter_mask_word_bits}; ///< Handlers per mask word.
+
+  std::span<ParameterHandler> m_handlers; ///< The checked handlers.
+  std::vector<T> m_values;                ///< Values, T{} if not present.
+  std::vector<std::uint64_t> m_present;   ///< Handlers holding the parameter.
+  std::vector<std::uint64_t> m_mismatch;  ///< Present but not of type T.
+  std::vector<std::uint64_t> m_failed;    ///< Handlers failing a check.
+
+  /**
+   * @brief Returns the number of handlers.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_handlers.size(); }
+
+  /**
+   * @brief Returns the number of mask words.
+   */
+  [[nodiscard]] std::size_t words() const noexcept { return m_present.size(); }
+
+  /**
+   * @brief Returns the bits of a mask word that refer to a handler.
+   */
+  [[nodiscard]] std::uint64_t valid(std::size_t word) const noexcept {
+    const auto rest{size() - word * word_bits};
+    return rest >= word_bits ? ~std::uint64_t{0}
+                             : (std::uint64_t{1} << rest) - 1;
+  }
+
+  /**
+   * @brief Tests bit i of a mask.
+   */
+  static bool test(std::vector<std::uint64_t> const &mask,
+                   std::size_t i) noexcept {
+    return (mask[i / word_bits] >> (i % word_bits)) & 1u;
+  }
+
+  /**
+   * @brief Sets bit i of a mask.
+   */
+  static void set(std::vector<std::uint64_t> &mask, std::size_t i) noexcept {
+    mask[i / word_bits] |= std::uint64_t{1} << (i % word_bits);
+  }
+};
+
 /**
  * @brief Base class for input parameter checks.
  *
@@ -81,12 +154,58 @@ public:
   input_parameter_check_base const &
   operator=(input_parameter_check_base const &) = delete;
 
+  /**
+   * @brief Pointer to a type-erased value stored in the parameter handler.
+   *
+   * Checks only read through it, so handlers resolving values from shared
+   * storage, such as layered_parameter_handler, may hand out const values.
+   */
+  using value_pointer = typename ParameterHandler::type_erasure_type const *;
+
   /**
    * @brief Pure virtual function to check the parameter.
    *
+   * The value is looked up once per parameter and shared by all of its checks.
+   * A check that inserts the parameter updates the pointer for the following
+   * checks.
+   *
    * @param input The parameter handler to check against.
+   * @param value The resolved value of the parameter, nullptr if it is absent.
+   */
+  virtual void check(ParameterHandler &input, value_pointer &value) const = 0;
+
+  /**
+   * @brief Checks the parameter across a column of handlers.
+   *
+   * Handlers that already failed are skipped, like the remaining checks of a
+   * failing parameter in check_parameter. The default runs check() for
+   * every handler; checks override it with loops over the gathered values.
+   *
+   * @param column The gathered parameter, its failed mask is updated.
    */
-  virtual void check(ParameterHandler &) const = 0;
+  virtual void check_column(input_parameter_column<T, ParameterHandler> &column) const {
+    using column_type = input_parameter_column<T, ParameterHandler>;
+    for (std::size_t i = 0; i < column.size(); ++i) {
+      if (column_type::test(column.m_failed, i)) {
+        continue;
+      }
+      auto &input{column.m_handlers[i]};
+      value_pointer value{column_type::test(column.m_present, i)
+                              ? input.find(m_para.name())
+                              : nullptr};
+      try {
+        check(input, value);
+      } catch (std::exception const &) {
+        column_type::set(column.m_failed, i);
+        continue;
+      }
+      if (value != nullptr && !column_type::test(column.m_present, i)) {
+        using std::any_cast;
+        column.m_values[i] = any_cast<T const &>(*value);
+        column_type::set(column.m_present, i);
+      }
+    }
+  }
 
 protected:
   /**
@@ -154,12 +273,25 @@ public:
    *
    * @param input The parameter handler to check against.
    */
-  void check(ParameterHandler &input) const final override {
-    if (!input.contains(this->m_para.name())) {
+  void check(ParameterHandler & /*input*/,
+             typename base::value_pointer &value) const final override {
+    if (value == nullptr) {
       throw std::invalid_argument("Parameter " + this->m_para.name() +
                                   " is missing!");
     }
   }
+
+  /**
+   * @brief Marks every handler without the parameter as failed.
+   *
+   * @param column The gathered parameter.
+   */
+  void check_column(
+      input_parameter_column<T, ParameterHandler> &column) const final override {
+    for (std::size_t word = 0; word < column.words(); ++word) {
+      column.m_failed[word] |= ~column.m_present[word] & column.valid(word);
+    }
+  }
 };
 
 /**
@@ -223,18 +355,47 @@ public:
    * Throws an invalid_argument exception if the value is outside the defined range.
    *
    * @param input The parameter handler to check against.
-   */
-  void check(ParameterHandler &input) const final override {
-    const auto &para_name{this->m_para.name()};
-    if (input.contains(para_name)) {
-      const auto value{input.template get<T>(para_name)};
-      if (value < m_low || value > m_high) {
+   * @param value The resolved value of the parameter.
+   */
+  void check(ParameterHandler & /*input*/,
+             typename base::value_pointer &value) const final override {
+    if (value != nullptr) {
+      using std::any_cast;
+      const auto &data{any_cast<T const &>(*value)};
+      if (data < m_low || data > m_high) {
         throw std::invalid_argument("Parameter " + this->m_para.name() +
                                     " out of range");
       }
     }
   }
 
+  /**
+   * @brief Marks every handler with a value outside the range, or of the
+   * wrong type, as failed.
+   *
+   * The compare loop of one mask word has no branches, so the compiler can
+   * vectorize it.
+   *
+   * @param column The gathered parameter.
+   */
+  void check_column(
+      input_parameter_column<T, ParameterHandler> &column) const final override {
+    constexpr auto word_bits{input_parameter_column<T, ParameterHandler>::word_bits};
+    const T *values{column.m_values.data()};
+    for (std::size_t word = 0; word < column.words(); ++word) {
+      const auto first{word * word_bits};
+      const auto count{std::min(word_bits, column.size() - first)};
+      std::uint64_t outside{0};
+      for (std::size_t bit = 0; bit < count; ++bit) {
+        const auto value{values[first + bit]};
+        outside |= static_cast<std::uint64_t>((value < m_low) | (value > m_high))
+                   << bit;
+      }
+      column.m_failed[word] |=
+          (outside | column.m_mismatch[word]) & column.m_present[word];
+    }
+  }
+
 private:
   const T m_low;  ///< Lower bound of the range.
   const T m_high; ///< Upper bound of the range.
@@ -296,11 +457,40 @@ public:
   /**
    * @brief Checks if the parameter is present in the handler and sets default if absent.
    *
+   * The default is written into the checked handler. For a
+   * layered_parameter_handler a parameter inherited from a parent counts as
+   * present, so checking the parent first stores the default once for all
+   * children.
+   *
    * @param input The parameter handler to check against.
+   * @param value The resolved value of the parameter, updated on insertion.
    */
-  void check(ParameterHandler &input) const final override {
-    if (!input.contains(this->m_para.name())) {
+  void check(ParameterHandler &input,
+             typename base::value_pointer &value) const final override {
+    if (value == nullptr) {
       input.insert(this->m_para.name(), m_value);
+      value = input.find(this->m_para.name());
+    }
+  }
+
+  /**
+   * @brief Inserts the default into every handler without the parameter.
+   *
+   * @param column The gathered parameter, updated for the inserted values.
+   */
+  void check_column(
+      input_parameter_column<T, ParameterHandler> &column) const final override {
+    constexpr auto word_bits{input_parameter_column<T, ParameterHandler>::word_bits};
+    for (std::size_t word = 0; word < column.words(); ++word) {
+      auto missing{~(column.m_present[word] | column.m_failed[word]) &
+                   column.valid(word)};
+      column.m_present[word] |= missing;
+      for (; missing != 0; missing &= missing - 1) {
+        const auto i{word * word_bits +
+                     static_cast<std::size_t>(std::countr_zero(missing))};
+        column.m_handlers[i].insert(this->m_para.name(), m_value);
+        column.m_values[i] = m_value;
+      }
     }
   }
 
@@ -364,14 +554,26 @@ public:
    * @brief Checks if the parameter is present in the handler and sets default if absent.
    *
    * @param input The parameter handler to check against.
+   * @param value The resolved value of the parameter.
+   * @throws std::bad_any_cast if the stored value is not of type T.
+   */
+  void check(ParameterHandler & /*input*/,
+             typename base::value_pointer &value) const final override {
+    if (value != nullptr) {
+      using std::any_cast;
+      [[maybe_unused]] const auto &data{any_cast<T const &>(*value)};
+    }
+  }
+
+  /**
+   * @brief Marks every handler holding a value of the wrong type as failed.
+   *
+   * @param column The gathered parameter.
    */
-  void check(ParameterHandler &input) const final override {
-    if (input.contains(this->m_para.name())) {
-      try {
-        const auto value{input.template get<T>(this->m_para.name())};
-      } catch (...) {
-        throw;
-      }
+  void check_column(
+      input_parameter_column<T, ParameterHandler> &column) const final override {
+    for (std::size_t word = 0; word < column.words(); ++word) {
+      column.m_failed[word] |= column.m_mismatch[word];
     }
   }
 };
@@ -435,6 +637,26 @@ public:
    */
   virtual void check_parameter(ParameterHandler &) const = 0;
 
+  /**
+   * @brief Checks the parameter in all handlers of a range.
+   *
+   * @param handlers The parameter handlers to check.
+   * @return A mask with bit i set if handler i fails a check, see
+   * input_parameter_column.
+   */
+  virtual std::vector<std::uint64_t>
+  check_column(std::span<ParameterHandler> handlers) const = 0;
+
+  /**
+   * @brief Parses the text of a value, inserts it and checks the parameter.
+   *
+   * @param input The parameter handler to insert into.
+   * @param text The text of the value.
+   * @throws std::invalid_argument if the text is no valid value or a check
+   * fails.
+   */
+  virtual void parse(ParameterHandler &input, std::string_view text) const = 0;
+
   /**
    * @brief Returns the name of the parameter.
    *
@@ -494,11 +716,81 @@ public:
    * @param input The parameter handler to check against.
    */
   void check_parameter(ParameterHandler &input) const override {
+    typename input_parameter_check_base<T, KeyType, ParameterHandler>::value_pointer
+        value{input.find(this->name())};
     for (auto &check : m_checks) {
-      check->check(input);
+      check->check(input, value);
     }
   }
 
+  /**
+   * @brief Checks the parameter in all handlers of a range.
+   *
+   * Arithmetic parameters are gathered into an input_parameter_column once
+   * and every check runs over the whole column; other parameters are checked
+   * handler by handler. Side effects match check_parameter per handler.
+   *
+   * @param handlers The parameter handlers to check.
+   * @return A mask with bit i set if handler i fails a check.
+   */
+  std::vector<std::uint64_t>
+  check_column(std::span<ParameterHandler> handlers) const override {
+    using column_type = input_parameter_column<T, ParameterHandler>;
+    const auto words{(handlers.size() + column_type::word_bits - 1) /
+                     column_type::word_bits};
+    if constexpr (std::is_arithmetic_v<T>) {
+      column_type column{handlers, std::vector<T>(handlers.size()),
+                         std::vector<std::uint64_t>(words),
+                         std::vector<std::uint64_t>(words),
+                         std::vector<std::uint64_t>(words)};
+      for (std::size_t i = 0; i < handlers.size(); ++i) {
+        if (const auto *value{handlers[i].find(this->name())}) {
+          column_type::set(column.m_present, i);
+          using std::any_cast;
+          if (const auto *data{any_cast<T>(value)}) {
+            column.m_values[i] = *data;
+          } else {
+            column_type::set(column.m_mismatch, i);
+          }
+        }
+      }
+      for (const auto &check : m_checks) {
+        check->check_column(column);
+      }
+      return std::move(column.m_failed);
+    } else {
+      std::vector<std::uint64_t> failed(words);
+      for (std::size_t i = 0; i < handlers.size(); ++i) {
+        try {
+          check_parameter(handlers[i]);
+        } catch (std::exception const &) {
+          column_type::set(failed, i);
+        }
+      }
+      return failed;
+    }
+  }
+
+  /**
+   * @brief Parses the text of a value into T, inserts it and runs all checks.
+   *
+   * Arithmetic values are parsed with std::from_chars, see
+   * detail::parse_value.
+   *
+   * @param input The parameter handler to insert into.
+   * @param text The text of the value.
+   * @throws std::invalid_argument if the text is no valid T or a check fails.
+   */
+  void parse(ParameterHandler &input, std::string_view text) const override {
+    try {
+      input.insert(this->name(), detail::parse_value<T>(text));
+    } catch (std::invalid_argument const &error) {
+      throw std::invalid_argument("Parameter " + std::string(this->name()) +
+                                  ": " + error.what());
+    }
+    check_parameter(input);
+  }
+
   /**
    * @brief Adds a validation check for the parameter.
    *
@@ -520,6 +812,38 @@ private:
       m_checks; ///< List of checks associated with the input parameter.
 };
 
+/**
+ * @brief Error collected by the batched input_parameter_controller::check_parameter.
+ *
+ * @tparam KeyType The type used as the key for the parameters.
+ */
+template <typename KeyType> struct input_parameter_error {
+  std::size_t m_index;   ///< Position of the handler in the checked range.
+  KeyType m_name;        ///< Name of the parameter whose check failed.
+  std::string m_message; ///< Message of the exception thrown by the check.
+};
+
+/**
+ * @brief Failing handlers of one parameter, collected by
+ * input_parameter_controller::check_columns.
+ *
+ * @tparam KeyType The type used as the key for the parameters.
+ */
+template <typename KeyType> struct input_parameter_mask {
+  static constexpr std::size_t word_bits{
+      input_parameter_mask_word_bits}; ///< Handlers per mask word.
+
+  KeyType m_name;                      ///< Name of the parameter.
+  std::vector<std::uint64_t> m_failed; ///< Bit i set if handler i failed.
+
+  /**
+   * @brief Checks whether handler i failed.
+   */
+  [[nodiscard]] bool failed(std::size_t i) const noexcept {
+    return (m_failed[i / word_bits] >> (i % word_bits)) & 1u;
+  }
+};
+
 /**
  * @brief Class for controlling input parameters.
  *
@@ -597,6 +921,22 @@ public:
     return *m_data[name].get();
   }
 
+  /**
+   * @brief Looks up a parameter without inserting it.
+   *
+   * String-like keys are looked up transparently, e.g. from a
+   * std::string_view.
+   *
+   * @param name The name of the parameter.
+   * @return The parameter, or nullptr if it is not registered.
+   */
+  template <typename K>
+  const input_parameter_base<KeyType, ParameterHandler> *
+  find(K const &name) const {
+    const auto pos{m_data.find(name)};
+    return pos != m_data.end() ? pos->second.get() : nullptr;
+  }
+
   /**
    * @brief Checks all parameters in the controller against the provided handler.
    *
@@ -604,13 +944,109 @@ public:
    */
   auto check_parameter(ParameterHandler &parameter) {
     for (const auto &[key, check] : m_data) {
+      NUMSIM_CORE_INSTRUMENT("input_parameter_controller::check_parameter",
+                             key);
       check->check_parameter(parameter);
     }
   }
 
+  /**
+   * @brief Checks the parameters not contained in a set of already checked
+   * ones, e.g. the parameters an input did not provide after the others were
+   * parsed and checked.
+   *
+   * @tparam Set Any set of parameter pointers with `contains()`.
+   * @param parameter The parameter handler to check against.
+   * @param checked The parameters to skip, as returned by find().
+   */
+  template <typename Set>
+  auto check_remaining(ParameterHandler &parameter, Set const &checked) const {
+    for (const auto &[key, check] : m_data) {
+      if (checked.contains(check.get())) {
+        continue;
+      }
+      NUMSIM_CORE_INSTRUMENT("input_parameter_controller::check_parameter",
+                             key);
+      check->check_parameter(parameter);
+    }
+  }
+
+  /**
+   * @brief Checks all parameters against every handler of a range.
+   *
+   * The handlers are distributed over the threads of the executor in chunks.
+   * Each handler is checked by exactly one thread, running the parameters in
+   * the same order as the single-handler check_parameter, so side effects such
+   * as set_default are identical to a serial run. Failing checks do not stop
+   * the validation; every error is collected and the result is ordered by
+   * handler index and, within one handler, by check order.
+   *
+   * @tparam Range A random access range of ParameterHandler objects.
+   * @tparam Executor The executor running the checks, see parallel_executor.
+   * @param handlers The parameter handlers to check.
+   * @param executor The executor running the checks.
+   * @return All errors raised by the checks, empty if every handler is valid.
+   */
+  template <std::ranges::random_access_range Range,
+            typename Executor = parallel_executor>
+  auto check_parameter(Range &&handlers, Executor &&executor = Executor{}) const
+    requires std::same_as<std::ranges::range_value_t<Range>, ParameterHandler>
+  {
+    using error_type = input_parameter_error<KeyType>;
+    const auto count{static_cast<std::size_t>(std::ranges::size(handlers))};
+    const auto first{std::ranges::begin(handlers)};
+    std::vector<std::vector<error_type>> local_errors(count);
+    executor(count, [&](std::size_t index) {
+      auto &parameter{*(first + static_cast<std::ptrdiff_t>(index))};
+      for (const auto &[key, check] : m_data) {
+        try {
+          NUMSIM_CORE_INSTRUMENT(
+              "input_parameter_controller::check_parameter", key);
+          check->check_parameter(parameter);
+        } catch (std::exception const &error) {
+          local_errors[index].push_back(error_type{index, key, error.what()});
+        }
+      }
+    });
+
+    std::vector<error_type> errors;
+    for (auto &local : local_errors) {
+      std::move(local.begin(), local.end(), std::back_inserter(errors));
+    }
+    return errors;
+  }
+
+  /**
+   * @brief Checks all parameters against every handler of a contiguous range,
+   * one parameter at a time.
+   *
+   * Each parameter is looked up once per handler and gathered into a
+   * contiguous column; range, presence and type checks then run as loops over
+   * the column instead of one virtual call per handler. The failing handlers
+   * of a parameter are reported as a bitmask. Side effects such as
+   * set_default are those of check_parameter, but parameters are processed
+   * column by column.
+   *
+   * @param handlers The parameter handlers to check.
+   * @return The masks of all parameters with at least one failing handler.
+   */
+  auto check_columns(std::span<ParameterHandler> handlers) const {
+    std::vector<input_parameter_mask<KeyType>> masks;
+    for (const auto &[key, check] : m_data) {
+      NUMSIM_CORE_INSTRUMENT("input_parameter_controller::check_columns", key);
+      auto failed{check->check_column(handlers)};
+      if (std::any_of(failed.begin(), failed.end(),
+                      [](std::uint64_t word) { return word != 0; })) {
+        masks.push_back({key, std::move(failed)});
+      }
+    }
+    return masks;
+  }
+
 private:
-  std::unordered_map<KeyType,
-                     std::unique_ptr<input_parameter_base<KeyType, ParameterHandler>>>
+  transparent_map_t<
+      std::unordered_map, KeyType,
+      std::unique_ptr<input_parameter_base<KeyType, ParameterHandler>>>
       m_data; ///< Map of parameters managed by the controller.
 };
 
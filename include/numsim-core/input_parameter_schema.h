@@ -0,0 +1,228 @@
+#ifndef INPUT_PARAMETER_SCHEMA_H
+#define INPUT_PARAMETER_SCHEMA_H
+
+#include "numsim_core_utility.h"
+#include <any>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace numsim_core {
+
+/**
+ * @file input_parameter_schema.h
+ * @brief Compile-time alternative to input_parameter_controller.
+ *
+ * Parameters and their checks are declared as types, so validating a handler
+ * expands into a fixed sequence of inlined checks without virtual dispatch or
+ * heap-allocated check objects:
+ *
+ * @code
+ * using material_schema = numsim_core::input_parameter_schema<
+ *     std::string, numsim_core::parameter_handler<>,
+ *     schema::parameter<"E", double, schema::is_required,
+ *                       schema::check_range<0.0, 1.0e12>>,
+ *     schema::parameter<"name", std::string,
+ *                       schema::set_default_string<"steel">>>;
+ * material_schema::check_parameter(handler);
+ * @endcode
+ */
+namespace schema {
+
+/**
+ * @brief Check that throws if the parameter is missing.
+ */
+struct is_required {
+  /**
+   * @brief Checks if the parameter is present in the handler.
+   *
+   * @tparam T The type of the parameter.
+   * @param input The parameter handler to check against.
+   * @param key The key of the parameter.
+   * @param name The name of the parameter used in error messages.
+   * @param value The resolved value of the parameter, nullptr if absent.
+   * @throws std::invalid_argument if the parameter is missing.
+   */
+  template <typename T, typename ParameterHandler, typename KeyType,
+            typename Value>
+  static void check(ParameterHandler & /*input*/, KeyType const & /*key*/,
+                    std::string_view name, Value *&value) {
+    if (value == nullptr) {
+      throw std::invalid_argument("Parameter " + std::string(name) +
+                                  " is missing!");
+    }
+  }
+};
+
+/**
+ * @brief Check that throws if the parameter lies outside [Low, High].
+ *
+ * @tparam Low The lower bound of the range.
+ * @tparam High The upper bound of the range.
+ */
+template <auto Low, auto High> struct check_range {
+  /**
+   * @brief Checks if the parameter is within the specified range.
+   *
+   * @tparam T The type of the parameter.
+   * @param input The parameter handler to check against.
+   * @param key The key of the parameter.
+   * @param name The name of the parameter used in error messages.
+   * @param value The resolved value of the parameter, nullptr if absent.
+   * @throws std::invalid_argument if the value is out of range.
+   */
+  template <typename T, typename ParameterHandler, typename KeyType,
+            typename Value>
+  static void check(ParameterHandler & /*input*/, KeyType const & /*key*/,
+                    std::string_view name, Value *&value) {
+    if (value != nullptr) {
+      using std::any_cast;
+      const auto &data{any_cast<T const &>(*value)};
+      if (data < static_cast<T>(Low) || data > static_cast<T>(High)) {
+        throw std::invalid_argument("Parameter " + std::string(name) +
+                                    " out of range");
+      }
+    }
+  }
+};
+
+/**
+ * @brief Check that inserts a default value if the parameter is missing.
+ *
+ * @tparam Value The default value.
+ */
+template <auto Value> struct set_default {
+  /**
+   * @brief Sets the default value if the parameter is absent.
+   *
+   * @tparam T The type of the parameter.
+   * @param input The parameter handler to check against.
+   * @param key The key of the parameter.
+   * @param value The resolved value of the parameter.
+   */
+  template <typename T, typename ParameterHandler, typename KeyType,
+            typename Erased>
+  static void check(ParameterHandler &input, KeyType const &key,
+                    std::string_view /*name*/, Erased *&value) {
+    if (value == nullptr) {
+      input.insert(key, static_cast<T>(Value));
+      value = input.find(key);
+    }
+  }
+};
+
+/**
+ * @brief Check that inserts a default string if the parameter is missing.
+ *
+ * String literals cannot be deduced by `set_default`, hence the separate check.
+ *
+ * @tparam Value The default string.
+ */
+template <fixed_string Value> struct set_default_string {
+  /**
+   * @brief Sets the default value if the parameter is absent.
+   *
+   * @tparam T The type of the parameter, constructible from std::string_view.
+   * @param input The parameter handler to check against.
+   * @param key The key of the parameter.
+   * @param value The resolved value of the parameter.
+   */
+  template <typename T, typename ParameterHandler, typename KeyType,
+            typename Erased>
+  static void check(ParameterHandler &input, KeyType const &key,
+                    std::string_view /*name*/, Erased *&value) {
+    if (value == nullptr) {
+      input.insert(key, T(Value.view()));
+      value = input.find(key);
+    }
+  }
+};
+
+/**
+ * @brief Check that throws if the parameter is not of type T.
+ */
+struct check_data_type {
+  /**
+   * @brief Checks the stored type by accessing the parameter as T.
+   *
+   * @tparam T The type of the parameter.
+   * @param input The parameter handler to check against.
+   * @param key The key of the parameter.
+   * @param value The resolved value of the parameter.
+   */
+  template <typename T, typename ParameterHandler, typename KeyType,
+            typename Value>
+  static void check(ParameterHandler & /*input*/, KeyType const & /*key*/,
+                    std::string_view /*name*/, Value *&value) {
+    if (value != nullptr) {
+      using std::any_cast;
+      [[maybe_unused]] const auto &data{any_cast<T const &>(*value)};
+    }
+  }
+};
+
+/**
+ * @brief Declares one parameter of a schema together with its checks.
+ *
+ * The checks run in the order in which they are listed.
+ *
+ * @tparam Name The name of the parameter.
+ * @tparam T The type of the parameter.
+ * @tparam Checks The check types applied to the parameter.
+ */
+template <fixed_string Name, typename T, typename... Checks> struct parameter {
+  using value_type = T; ///< The type of the parameter.
+
+  /**
+   * @brief The name of the parameter.
+   */
+  static constexpr std::string_view name{Name.view()};
+
+  /**
+   * @brief Runs all checks of the parameter.
+   *
+   * The key is materialized once per KeyType, so no allocation happens on
+   * repeated validation, and the value is looked up once and shared by all
+   * checks.
+   *
+   * @tparam KeyType The key type of the parameter handler.
+   * @param input The parameter handler to check against.
+   */
+  template <typename KeyType, typename ParameterHandler>
+  static void check_parameter(ParameterHandler &input) {
+    static const KeyType key(name);
+    auto *value{input.find(key)};
+    (Checks::template check<T>(input, key, name, value), ...);
+  }
+};
+
+} // namespace schema
+
+/**
+ * @brief Compile-time counterpart of input_parameter_controller.
+ *
+ * @tparam KeyType The type used as the key for the parameters.
+ * @tparam ParameterHandler The type of the handler that manages parameters.
+ * @tparam Parameters The schema::parameter declarations.
+ */
+template <typename KeyType, typename ParameterHandler, typename... Parameters>
+struct input_parameter_schema {
+  /**
+   * @brief Checks all parameters of the schema against the provided handler.
+   *
+   * @param parameter The parameter handler to check against.
+   */
+  static void check_parameter(ParameterHandler &parameter) {
+    (Parameters::template check_parameter<KeyType>(parameter), ...);
+  }
+
+  /**
+   * @brief Returns the number of parameters in the schema.
+   */
+  static constexpr std::size_t size() noexcept { return sizeof...(Parameters); }
+};
+
+} // namespace numsim_core
+#endif // INPUT_PARAMETER_SCHEMA_H
@@ -3,8 +3,19 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <map>
 #include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace numsim_core {
 
@@ -13,21 +24,120 @@ static inline auto remove_character(std::string && input, char const& key){
     return input;
 }
 
+namespace detail {
+
+inline std::string_view trim(std::string_view input){
+    constexpr std::string_view whitespace{" \t\r\n"};
+    const auto first{input.find_first_not_of(whitespace)};
+    if(first == std::string_view::npos){
+        return {};
+    }
+    return input.substr(first, input.find_last_not_of(whitespace) - first + 1);
+}
+
+template<typename T>
+inline constexpr bool is_vector_v = false;
+
+template<typename T, typename Alloc>
+inline constexpr bool is_vector_v<std::vector<T, Alloc>> = true;
+
+template<typename T>
+bool from_chars_full(std::string_view input, T& value){
+    const auto [ptr, ec]{std::from_chars(input.data(), input.data() + input.size(), value)};
+    return ec == std::errc{} && ptr == input.data() + input.size();
+}
+
+//parses the text of a value into T without intermediate strings,
+//throws std::invalid_argument if the text is no valid T
+template<typename T>
+T parse_value(std::string_view input){
+    input = trim(input);
+    if constexpr (std::is_same_v<T, bool>){
+        if(input == "true" || input == "1"){
+            return true;
+        }
+        if(input == "false" || input == "0"){
+            return false;
+        }
+    }else if constexpr (std::is_arithmetic_v<T>){
+        T value{};
+        //from_chars does not accept a leading '+'
+        if(!input.empty() && input.front() == '+'){
+            input.remove_prefix(1);
+        }
+        if(from_chars_full(input, value)){
+            return value;
+        }
+    }else if constexpr (std::is_constructible_v<T, std::string_view>){
+        return T(input);
+    }else if constexpr (is_vector_v<T>){
+        //comma or whitespace separated list
+        T values;
+        while(!(input = trim(input)).empty()){
+            const auto end{std::min(input.find_first_of(", \t"), input.size())};
+            values.push_back(parse_value<typename T::value_type>(input.substr(0, end)));
+            input.remove_prefix(std::min(end + 1, input.size()));
+        }
+        return values;
+    }else{
+        throw std::invalid_argument("numsim_core::parse_value: type cannot be parsed from text");
+    }
+    throw std::invalid_argument("numsim_core::parse_value: invalid value " + std::string(input));
+}
+
+//inserts a value of the type its text spells: int, double, bool or string
+template<typename Handler>
+void insert_inferred(Handler& handler, std::string_view key, std::string_view input){
+    using key_type = typename Handler::key_type;
+    input = trim(input);
+    int integer{};
+    double floating{};
+    if(from_chars_full(input, integer)){
+        handler.insert(key_type(key), integer);
+    }else if(from_chars_full(input, floating)){
+        handler.insert(key_type(key), floating);
+    }else if(input == "true" || input == "false"){
+        handler.insert(key_type(key), input == "true");
+    }else{
+        handler.insert(key_type(key), std::string(input));
+    }
+}
+
+//the registered parameters parsed from an input
+template<typename Controller>
+using parsed_parameters = std::unordered_set<decltype(std::declval<Controller const&>().find(std::string_view{}))>;
+
+//registered parameters are parsed into their type, checked right away and
+//recorded in parsed, all other values are inserted with their inferred type
+template<typename Handler, typename Controller>
+void insert_parsed(Handler& handler, Controller const& controller, parsed_parameters<Controller>& parsed, std::string_view key, std::string_view input){
+    if(auto const* parameter{controller.find(key)}){
+        parameter->parse(handler, input);
+        parsed.insert(parameter);
+        return;
+    }
+    insert_inferred(handler, key, input);
+}
+
+}
+
+//command line arguments as views into argv, which outlives the parser
 class input_parser{
 public:
     input_parser (int &argc, char **argv){
         for (int i=1; i < argc; ++i){
-            std::string key{remove_character(std::string(argv[i]), '-')};
-            if(i < argc-1 && std::string(argv[i+1]).find("-")){
+            std::string_view key{argv[i]};
+            key.remove_prefix(std::min(key.find_first_not_of('-'), key.size()));
+            if(i < argc-1 && argv[i+1][0] != '-'){
                 ++i;
-                m_arguments[key] = std::string(argv[i]);
+                m_arguments.insert_or_assign(key, std::string_view(argv[i]));
             }else{
-                m_arguments[key] = "";
+                m_arguments.insert_or_assign(key, std::string_view());
             }
         }
     }
 
-    const std::string& value(const std::string & key) const{
+    std::string_view value(std::string_view key) const{
         const auto pos{m_arguments.find(key)};
         if(pos == m_arguments.end()){
             throw std::runtime_error("input_parser::value() no matching input found");
@@ -35,10 +145,35 @@ public:
         return pos->second;
     }
 
-    bool contains(const std::string & key) const{
+    //parses the value of key, see detail::parse_value
+    template<typename T>
+    T get(std::string_view key) const{
+        return detail::parse_value<T>(value(key));
+    }
+
+    bool contains(std::string_view key) const{
         return m_arguments.find(key) != m_arguments.cend();
     }
 
+    //inserts all arguments with their inferred type
+    template<typename Handler>
+    void parse(Handler& handler) const{
+        for(const auto& [key, value] : m_arguments){
+            detail::insert_inferred(handler, key, value);
+        }
+    }
+
+    //inserts all arguments, parsing and checking the parameters registered
+    //in the controller, then runs the checks of the missing ones
+    template<typename Handler, typename Controller>
+    void parse(Handler& handler, Controller& controller) const{
+        detail::parsed_parameters<Controller> parsed;
+        for(const auto& [key, value] : m_arguments){
+            detail::insert_parsed(handler, std::as_const(controller), parsed, key, value);
+        }
+        controller.check_remaining(handler, parsed);
+    }
+
     inline void add_help(std::string && key, std::string && name, std::string && description){
         m_help[std::move(key)] = std::make_pair(std::move(name), std::move(description));
     }
@@ -57,8 +192,118 @@ public:
 
 
 private:
-    std::map<std::string, std::string> m_arguments;
-    std::map<std::string, std::pair<std::string, std::string>> m_help;
+    std::map<std::string_view, std::string_view, std::less<>> m_arguments;
+    std::map<std::string, std::pair<std::string, std::string>, std::less<>> m_help;
+};
+
+//streaming reader for key = value files with optional [section] headers,
+//keys of a section are reported as section.key; lines starting with # or ;
+//are comments. The input is read in blocks and every line is handed out as
+//views into the block, so the memory use is independent of the file size.
+class config_reader{
+public:
+    explicit config_reader(std::istream& input, std::size_t block_size = std::size_t{1} << 20):
+        m_input(input),
+        m_buffer(std::max<std::size_t>(block_size, 64))
+    {}
+
+    //calls func(key, value) for every entry, errors thrown by func are
+    //reported with the line number
+    template<typename Function>
+    void for_each(Function&& func){
+        std::size_t filled{0};
+        while(true){
+            m_input.read(m_buffer.data() + filled, static_cast<std::streamsize>(m_buffer.size() - filled));
+            filled += static_cast<std::size_t>(m_input.gcount());
+            const std::string_view data(m_buffer.data(), filled);
+            std::size_t start{0};
+            for(auto end{data.find('\n')}; end != std::string_view::npos; end = data.find('\n', start)){
+                read_line(data.substr(start, end - start), func);
+                start = end + 1;
+            }
+            if(!m_input){
+                if(start < filled){
+                    read_line(data.substr(start), func);
+                }
+                return;
+            }
+            //keep the incomplete last line, grow if it fills the block
+            std::memmove(m_buffer.data(), m_buffer.data() + start, filled - start);
+            filled -= start;
+            if(filled == m_buffer.size()){
+                m_buffer.resize(2 * m_buffer.size());
+            }
+        }
+    }
+
+    //inserts all entries with their inferred type
+    template<typename Handler>
+    void read(Handler& handler){
+        for_each([&handler](std::string_view key, std::string_view value){
+            detail::insert_inferred(handler, key, value);
+        });
+    }
+
+    //inserts all entries, parsing and checking the parameters registered in
+    //the controller, then runs the checks of the missing ones
+    template<typename Handler, typename Controller>
+    void read(Handler& handler, Controller& controller){
+        detail::parsed_parameters<Controller> parsed;
+        for_each([&handler, &controller, &parsed](std::string_view key, std::string_view value){
+            detail::insert_parsed(handler, std::as_const(controller), parsed, key, value);
+        });
+        controller.check_remaining(handler, parsed);
+    }
+
+    std::size_t line() const {
+        return m_line;
+    }
+
+private:
+    template<typename Function>
+    void read_line(std::string_view text, Function& func){
+        ++m_line;
+        text = detail::trim(text);
+        if(text.empty() || text.front() == '#' || text.front() == ';'){
+            return;
+        }
+        if(text.front() == '['){
+            if(text.back() != ']'){
+                fail("expected ]");
+            }
+            m_section.assign(detail::trim(text.substr(1, text.size() - 2)));
+            return;
+        }
+        const auto pos{text.find('=')};
+        if(pos == std::string_view::npos){
+            fail("expected key = value");
+        }
+        const auto key{detail::trim(text.substr(0, pos))};
+        if(key.empty()){
+            fail("empty key");
+        }
+        std::string_view full_key{key};
+        if(!m_section.empty()){
+            m_key.assign(m_section).append(1, '.').append(key);
+            full_key = m_key;
+        }
+        try{
+            func(full_key, detail::trim(text.substr(pos + 1)));
+        }catch(std::invalid_argument const& error){
+            fail(error.what());
+        }
+    }
+
+    [[noreturn]] void fail(std::string_view message) const {
+        throw std::invalid_argument("numsim_core::config_reader: line " + std::to_string(m_line) + ": " + std::string(message));
+    }
+
+    std::istream& m_input;
+    std::vector<char> m_buffer;
+    std::string m_section;
+    //reused storage of section.key
+    std::string m_key;
+    std::size_t m_line{0};
 };
 
 }
@@ -0,0 +1,309 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace numsim_core {
+
+/**
+ * @brief Statistics collected for one key of an instrumented call site.
+ */
+struct key_statistics {
+  static constexpr std::size_t bucket_count{32}; ///< Histogram buckets.
+
+  std::uint64_t m_lookups{0};  ///< Number of recorded calls.
+  std::uint64_t m_misses{0};   ///< Calls left by an exception, e.g. a
+                               ///< missing key or a failed check.
+  std::uint64_t m_total_ns{0}; ///< Summed latency in nanoseconds.
+  std::array<std::uint64_t, bucket_count>
+      m_histogram{}; ///< Bucket 0 counts calls below 1 ns, bucket i calls
+                     ///< of [2^(i-1), 2^i) ns; the last one is open.
+
+  /**
+   * @brief Returns the histogram bucket of a latency.
+   */
+  static constexpr std::size_t bucket(std::uint64_t ns) noexcept {
+    return std::min<std::size_t>(std::bit_width(ns), bucket_count - 1);
+  }
+};
+
+/**
+ * @brief Process-wide store of the statistics of instrumented calls.
+ *
+ * Configuring with the CMake option `numsim-core_INSTRUMENTATION` defines
+ * NUMSIM_CORE_INSTRUMENTATION, and the hot paths of parameter_handler::get,
+ * query_map::get, query_map::final_queries, registry::build and
+ * input_parameter_controller::check_parameter then record every call per
+ * key. Without the definition the instrumentation macros expand to nothing
+ * and the hot paths are unchanged.
+ *
+ * Recording formats the key and takes a lock, so instrumented runs are
+ * slower; the recorded latency covers the instrumented call only.
+ */
+class instrumentation {
+public:
+  /**
+   * @brief True if the library hot paths are instrumented.
+   */
+#ifdef NUMSIM_CORE_INSTRUMENTATION
+  static constexpr bool enabled{true};
+#else
+  static constexpr bool enabled{false};
+#endif
+
+  /**
+   * @brief Returns the process-wide instance.
+   */
+  static instrumentation &instance() {
+    static instrumentation data;
+    return data;
+  }
+
+  /**
+   * @brief Records one call.
+   *
+   * @param site The call site, a string literal.
+   * @param key The key of the call.
+   * @param latency The duration of the call.
+   * @param miss True if the call failed.
+   */
+  void record(std::string_view site, std::string_view key,
+              std::chrono::nanoseconds latency, bool miss) {
+    const auto ns{static_cast<std::uint64_t>(std::max<std::int64_t>(
+        latency.count(), 0))};
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    auto &keys{m_sites[site]};
+    auto pos{keys.find(key)};
+    if (pos == keys.end()) {
+      pos = keys.emplace(std::string(key), key_statistics{}).first;
+    }
+    auto &statistics{pos->second};
+    ++statistics.m_lookups;
+    statistics.m_misses += miss ? 1 : 0;
+    statistics.m_total_ns += ns;
+    ++statistics.m_histogram[key_statistics::bucket(ns)];
+  }
+
+  /**
+   * @brief Returns the statistics of a key, if any call was recorded.
+   *
+   * @param site The call site.
+   * @param key The key.
+   */
+  std::optional<key_statistics> statistics(std::string_view site,
+                                           std::string_view key) const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto keys{m_sites.find(site)};
+    if (keys == m_sites.end()) {
+      return std::nullopt;
+    }
+    const auto pos{keys->second.find(key)};
+    if (pos == keys->second.end()) {
+      return std::nullopt;
+    }
+    return pos->second;
+  }
+
+  /**
+   * @brief Writes a table of all keys, the most expensive first.
+   *
+   * @param os The output stream.
+   */
+  void report(std::ostream &os) const {
+    const auto rows{sorted()};
+    os << std::left << std::setw(44) << "site" << std::setw(32) << "key"
+       << std::right << std::setw(12) << "lookups" << std::setw(10)
+       << "misses" << std::setw(14) << "total [us]" << std::setw(12)
+       << "mean [ns]" << '\n';
+    for (const auto &[site, key, statistics] : rows) {
+      const auto mean{statistics.m_lookups == 0
+                          ? 0.0
+                          : static_cast<double>(statistics.m_total_ns) /
+                                static_cast<double>(statistics.m_lookups)};
+      os << std::left << std::setw(44) << site << std::setw(32) << key
+         << std::right << std::setw(12) << statistics.m_lookups
+         << std::setw(10) << statistics.m_misses << std::setw(14)
+         << std::fixed << std::setprecision(3)
+         << 1.0e-3 * static_cast<double>(statistics.m_total_ns)
+         << std::setw(12) << std::setprecision(1) << mean << '\n';
+    }
+    os << std::defaultfloat;
+  }
+
+  /**
+   * @brief Writes all statistics as JSON, the most expensive first.
+   *
+   * The document is an object with an array `entries` of objects with the
+   * members site, key, lookups, misses, total_ns and histogram.
+   *
+   * @param os The output stream.
+   */
+  void write_json(std::ostream &os) const {
+    const auto rows{sorted()};
+    os << "{\"entries\":[";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      const auto &[site, key, statistics] = rows[i];
+      os << (i == 0 ? "" : ",") << "{\"site\":";
+      write_json_string(os, site);
+      os << ",\"key\":";
+      write_json_string(os, key);
+      os << ",\"lookups\":" << statistics.m_lookups
+         << ",\"misses\":" << statistics.m_misses
+         << ",\"total_ns\":" << statistics.m_total_ns << ",\"histogram\":[";
+      for (std::size_t bucket = 0; bucket < key_statistics::bucket_count;
+           ++bucket) {
+        os << (bucket == 0 ? "" : ",") << statistics.m_histogram[bucket];
+      }
+      os << "]}";
+    }
+    os << "]}";
+  }
+
+  /**
+   * @brief Removes all recorded statistics.
+   */
+  void reset() {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_sites.clear();
+  }
+
+private:
+  using row = std::tuple<std::string_view, std::string_view,
+                         key_statistics>; ///< One reported key.
+
+  instrumentation() = default;
+
+  /**
+   * @brief Returns all keys sorted by descending total latency.
+   */
+  std::vector<row> sorted() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<row> rows;
+    for (const auto &[site, keys] : m_sites) {
+      for (const auto &[key, statistics] : keys) {
+        rows.emplace_back(site, key, statistics);
+      }
+    }
+    std::stable_sort(rows.begin(), rows.end(), [](auto const &a, auto const &b) {
+      return std::get<2>(a).m_total_ns > std::get<2>(b).m_total_ns;
+    });
+    return rows;
+  }
+
+  /**
+   * @brief Writes a JSON string literal.
+   */
+  static void write_json_string(std::ostream &os, std::string_view text) {
+    static constexpr char hex[]{"0123456789abcdef"};
+    os << '"';
+    for (const auto c : text) {
+      if (c == '"' || c == '\\') {
+        os << '\\' << c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+      } else {
+        os << c;
+      }
+    }
+    os << '"';
+  }
+
+  mutable std::mutex m_mutex; ///< Guards m_sites.
+  std::map<std::string_view,
+           std::map<std::string, key_statistics, std::less<>>>
+      m_sites; ///< Statistics per call site and key.
+};
+
+namespace detail {
+/**
+ * @brief Formats a key of an instrumented call: strings as they are,
+ * numbers and enums by value, tuples as "(key0, key1, ...)".
+ */
+template <typename Key> std::string instrumentation_key(Key const &key) {
+  if constexpr (std::is_convertible_v<Key const &, std::string_view>) {
+    return std::string(std::string_view(key));
+  } else if constexpr (std::is_enum_v<Key>) {
+    return std::to_string(static_cast<std::underlying_type_t<Key>>(key));
+  } else if constexpr (std::is_arithmetic_v<Key>) {
+    return std::to_string(key);
+  } else if constexpr (requires { std::tuple_size<Key>::value; }) {
+    std::string result{"("};
+    std::apply(
+        [&](auto const &...keys) {
+          std::size_t index{0};
+          ((result += (index++ == 0 ? "" : ", ") + instrumentation_key(keys)),
+           ...);
+        },
+        key);
+    return result + ")";
+  } else {
+    return "?";
+  }
+}
+
+/**
+ * @brief Records the duration of its scope on destruction; leaving the scope
+ * by an exception counts as a miss.
+ */
+class instrumentation_scope {
+public:
+  template <typename Key>
+  instrumentation_scope(std::string_view site, Key const &key)
+      : m_site(site), m_key(instrumentation_key(key)),
+        m_exceptions(std::uncaught_exceptions()),
+        m_start(std::chrono::steady_clock::now()) {}
+
+  instrumentation_scope(instrumentation_scope const &) = delete;
+
+  instrumentation_scope &operator=(instrumentation_scope const &) = delete;
+
+  ~instrumentation_scope() {
+    const auto latency{std::chrono::steady_clock::now() - m_start};
+    try {
+      instrumentation::instance().record(
+          m_site, m_key,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(latency),
+          std::uncaught_exceptions() > m_exceptions);
+    } catch (...) {
+      // statistics are best effort and must not terminate an unwinding call
+    }
+  }
+
+private:
+  std::string_view m_site;                           ///< The call site.
+  std::string m_key;                                 ///< The formatted key.
+  int m_exceptions;                                  ///< Exceptions at entry.
+  std::chrono::steady_clock::time_point m_start;     ///< Entry time.
+};
+} // namespace detail
+
+} // namespace numsim_core
+
+#ifdef NUMSIM_CORE_INSTRUMENTATION
+/**
+ * @brief Records the rest of the enclosing scope as one call of `site` with
+ * the given key.
+ */
+#define NUMSIM_CORE_INSTRUMENT(site, key)                                      \
+  const ::numsim_core::detail::instrumentation_scope                           \
+      numsim_core_instrumentation_scope_(site, key)
+#else
+#define NUMSIM_CORE_INSTRUMENT(site, key) static_cast<void>(0)
+#endif
+
+#endif // INSTRUMENTATION_H
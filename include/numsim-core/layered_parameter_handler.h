@@ -0,0 +1,249 @@
+#ifndef LAYERED_PARAMETER_HANDLER_H
+#define LAYERED_PARAMETER_HANDLER_H
+
+#include "numsim_core_utility.h"
+#include "parameter_handler.h"
+#include <any>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace numsim_core {
+
+/**
+ * @brief A parameter_handler layer storing only the overrides of a parent.
+ *
+ * A layer references a read-only parent, either another layer or a plain
+ * parameter_handler, and resolves lookups through the chain from the layer
+ * itself towards the root: the nearest layer holding a key wins. Writes
+ * always go to the layer itself, so many children of one shared default
+ * store nothing but their differences and copy in O(overrides).
+ *
+ * Parents must outlive their children and must not be modified while
+ * children are read concurrently. A layer that is read often can be
+ * flattened into a single lookup.
+ *
+ * Used as the ParameterHandler of an input_parameter_controller, set_default
+ * only inserts a default if no layer of the chain holds the parameter, so
+ * checking the shared parent first stores the defaults once instead of in
+ * every child.
+ *
+ * @code
+ * numsim_core::layered_parameter_handler<> steel;
+ * steel.insert("E", 210000.0);
+ * steel.insert("nu", 0.3);
+ * std::vector<numsim_core::layered_parameter_handler<>> elements(
+ *     n, steel.child());
+ * elements[7].insert("E", 190000.0); // only element 7 stores an override
+ * @endcode
+ *
+ * @tparam KeyType Type of the keys used for storing parameters.
+ * @tparam TypeErasure Type used for the values stored in the handler.
+ * @tparam Map Storage policy of the layers.
+ */
+template <typename KeyType = std::string, typename TypeErasure = std::any,
+          template <class... ArgsMap> class Map = std::unordered_map>
+class layered_parameter_handler {
+public:
+  using handler_type = parameter_handler<KeyType, TypeErasure,
+                                         Map>; ///< Storage of one layer.
+  using key_type = KeyType;              ///< The key type.
+  using type_erasure_type = TypeErasure; ///< The type-erased value type.
+
+  /**
+   * @brief Constructs an empty root layer.
+   */
+  layered_parameter_handler() = default;
+
+  /**
+   * @brief Constructs an empty layer on top of a parameter_handler.
+   *
+   * @param parent The handler resolving keys not overridden here.
+   */
+  explicit layered_parameter_handler(handler_type const &parent)
+      : m_base(&parent) {}
+
+  /**
+   * @brief Returns an empty child layer of this layer.
+   */
+  [[nodiscard]] layered_parameter_handler child() const {
+    return layered_parameter_handler(this);
+  }
+
+  /**
+   * @brief Inserts or assigns a value in this layer.
+   *
+   * The parents are not changed; the value overrides theirs.
+   *
+   * @param name The key.
+   * @param value The value.
+   * @return A reference to the stored value.
+   */
+  template <typename T> decltype(auto) insert(KeyType name, T &&value) {
+    return m_data.insert(std::move(name), std::forward<T>(value));
+  }
+
+  /**
+   * @brief Looks up a key through the chain.
+   *
+   * @param name The key.
+   * @return The value of the nearest layer holding the key, or nullptr.
+   */
+  template <typename K> TypeErasure const *find(K const &name) const {
+    auto const *layer{this};
+    while (true) {
+      if (auto const *value{layer->m_data.find(name)}) {
+        return value;
+      }
+      if (layer->m_parent == nullptr) {
+        return layer->m_base != nullptr ? layer->m_base->find(name) : nullptr;
+      }
+      layer = layer->m_parent;
+    }
+  }
+
+  /**
+   * @brief Checks whether a key is stored in any layer of the chain.
+   *
+   * @param name The key.
+   */
+  template <typename K> bool contains(K const &name) const {
+    return find(name) != nullptr;
+  }
+
+  /**
+   * @brief Retrieves the type-erased value resolved through the chain.
+   *
+   * @param name The key.
+   * @throws std::invalid_argument if the key is not found.
+   */
+  template <typename K> TypeErasure const &data(K const &name) const {
+    auto const *value{find(name)};
+    if (value == nullptr) {
+      throw std::invalid_argument("Key " + to_key_string(name) + " not found");
+    }
+    return *value;
+  }
+
+  /**
+   * @brief Retrieves a value resolved through the chain.
+   *
+   * @tparam T The type of the value.
+   * @param name The key.
+   * @throws std::invalid_argument if the key is not found.
+   * @throws std::bad_any_cast if the stored value is not of type T.
+   */
+  template <typename T, typename K> T const &get(K const &name) const {
+    using std::any_cast;
+    return any_cast<T const &>(data(name));
+  }
+
+  /**
+   * @brief Returns a modifiable value of this layer, copying it from the
+   * nearest parent holding it first (copy-on-write).
+   *
+   * @tparam T The type of the value.
+   * @param name The key.
+   * @throws std::invalid_argument if the key is not found.
+   * @throws std::bad_any_cast if the stored value is not of type T.
+   */
+  template <typename T> T &modify(KeyType const &name) {
+    using std::any_cast;
+    if (auto *value{m_data.find(name)}) {
+      return any_cast<T &>(*value);
+    }
+    return any_cast<T &>(m_data.insert_data(name, data(name)));
+  }
+
+  /**
+   * @brief Copies all values resolved through the chain into this layer and
+   * detaches it from its parents.
+   *
+   * Afterwards every lookup of the layer is a single map lookup, and the
+   * parents may be changed or destroyed. Deferred values are computed and
+   * copied as explicit values, as their producers read the layer they were
+   * registered in.
+   */
+  void flatten() {
+    if (m_parent == nullptr && m_base == nullptr) {
+      return;
+    }
+    handler_type flat;
+    copy_chain(*this, flat);
+    m_data = std::move(flat);
+    m_parent = nullptr;
+    m_base = nullptr;
+  }
+
+  /**
+   * @brief Returns the overrides stored in this layer.
+   */
+  [[nodiscard]] handler_type const &overrides() const noexcept {
+    return m_data;
+  }
+
+  /**
+   * @brief Returns the parent layer, or nullptr.
+   */
+  [[nodiscard]] layered_parameter_handler const *parent() const noexcept {
+    return m_parent;
+  }
+
+  /**
+   * @brief Returns the number of layers of the chain, including a base
+   * parameter_handler.
+   */
+  [[nodiscard]] std::size_t depth() const noexcept {
+    std::size_t count{1};
+    auto const *layer{this};
+    for (; layer->m_parent != nullptr; layer = layer->m_parent) {
+      ++count;
+    }
+    return layer->m_base != nullptr ? count + 1 : count;
+  }
+
+  /**
+   * @brief Removes the overrides of this layer.
+   */
+  void clear() { m_data.clear(); }
+
+private:
+  /**
+   * @brief Constructs an empty layer on top of another layer.
+   */
+  explicit layered_parameter_handler(layered_parameter_handler const *parent)
+      : m_parent(parent) {}
+
+  /**
+   * @brief Copies the values of a chain root first, so nearer layers win.
+   */
+  static void copy_chain(layered_parameter_handler const &layer,
+                         handler_type &flat) {
+    if (layer.m_parent != nullptr) {
+      copy_chain(*layer.m_parent, flat);
+    } else if (layer.m_base != nullptr) {
+      flat = *layer.m_base;
+      layer.m_base->for_each_deferred(
+          [&flat](auto const &name, auto const &value) {
+            flat.insert_data(name, value);
+          });
+    }
+    for (const auto &[name, value] : layer.m_data) {
+      flat.insert_data(name, value);
+    }
+    layer.m_data.for_each_deferred(
+        [&flat](auto const &name, auto const &value) {
+          flat.insert_data(name, value);
+        });
+  }
+
+  handler_type m_data;                                ///< The overrides.
+  layered_parameter_handler const *m_parent{nullptr}; ///< Parent layer.
+  handler_type const *m_base{nullptr};                ///< Base of the root.
+};
+
+} // namespace numsim_core
+
+#endif // LAYERED_PARAMETER_HANDLER_H
@@ -8,23 +8,216 @@
 #include <typeindex>
 #include <typeinfo>
 #include <utility>
+#include <cstddef>
 #include <iomanip>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 
 namespace numsim_core {
 
-template <class T, typename... Args, class F>
-inline std::pair<const std::type_index,
-                 std::function<void(std::any const &, Args...)>>
-to_any_visitor(F const &f) {
-  return {std::type_index(typeid(T)),
-          [g = f](std::any const &a, Args &&...args) {
+/**
+ * @brief Describes how stored types of a type erasure are identified.
+ *
+ * Specializations provide a `key_type`, `key<T>()` returning the key of a
+ * type, `key(data)` returning the key of the stored type and `name(data)`
+ * returning a printable type name.
+ *
+ * @tparam TypeErasure The type erasure, e.g. std::any.
+ */
+template <typename TypeErasure> struct type_erasure_traits;
+
+/**
+ * @brief Type erasure traits for std::any, keyed by std::type_index.
+ */
+template <> struct type_erasure_traits<std::any> {
+  using key_type = std::type_index;
+
+  template <typename T> static key_type key() noexcept {
+    return std::type_index(typeid(T));
+  }
+
+  static key_type key(std::any const &data) noexcept {
+    return std::type_index(data.type());
+  }
+
+  static std::string name(std::any const &data) { return data.type().name(); }
+};
+
+/**
+ * @brief A move-only callable wrapper storing the callable in place.
+ *
+ * Unlike std::function, inplace_function never allocates: callables larger
+ * than `Capacity` bytes are rejected at compile time. Calling the wrapper is
+ * one indirect call.
+ *
+ * @tparam Signature The call signature, e.g. `void(int)`.
+ * @tparam Capacity The size of the internal buffer in bytes.
+ */
+template <typename Signature, std::size_t Capacity = 6 * sizeof(void *)>
+class inplace_function;
+
+template <typename Result, typename... Args, std::size_t Capacity>
+class inplace_function<Result(Args...), Capacity> {
+public:
+  /**
+   * @brief Constructs an empty wrapper.
+   */
+  inplace_function() noexcept = default;
+
+  /**
+   * @brief Constructs an empty wrapper.
+   */
+  inplace_function(std::nullptr_t) noexcept {}
+
+  /**
+   * @brief Stores a callable.
+   *
+   * @tparam F The type of the callable.
+   * @param func The callable, moved or copied into the buffer.
+   */
+  template <typename F>
+    requires(!std::is_same_v<std::decay_t<F>, inplace_function> &&
+             std::is_invocable_r_v<Result, std::decay_t<F> &, Args...>)
+  inplace_function(F &&func) {
+    using callable = std::decay_t<F>;
+    static_assert(sizeof(callable) <= Capacity,
+                  "inplace_function: callable exceeds the buffer capacity");
+    static_assert(alignof(callable) <= alignof(std::max_align_t),
+                  "inplace_function: callable is over-aligned");
+    static_assert(std::is_nothrow_move_constructible_v<callable>,
+                  "inplace_function: callable must be nothrow movable");
+    ::new (static_cast<void *>(m_storage)) callable(std::forward<F>(func));
+    m_invoke = &invoke<callable>;
+    m_manage = &manage<callable>;
+  }
+
+  /**
+   * @brief Move constructor, the source becomes empty.
+   */
+  inplace_function(inplace_function &&other) noexcept {
+    move_from(other);
+  }
+
+  /**
+   * @brief Move assignment operator, the source becomes empty.
+   */
+  inplace_function &operator=(inplace_function &&other) noexcept {
+    if (this != &other) {
+      reset();
+      move_from(other);
+    }
+    return *this;
+  }
+
+  inplace_function(inplace_function const &) = delete;
+
+  inplace_function &operator=(inplace_function const &) = delete;
+
+  /**
+   * @brief Destroys the stored callable.
+   */
+  ~inplace_function() { reset(); }
+
+  /**
+   * @brief Checks whether a callable is stored.
+   */
+  explicit operator bool() const noexcept { return m_invoke != nullptr; }
+
+  /**
+   * @brief Calls the stored callable.
+   *
+   * @param args The arguments passed to the callable.
+   * @throws std::bad_function_call if the wrapper is empty.
+   */
+  Result operator()(Args... args) const {
+    if (m_invoke == nullptr) {
+      throw std::bad_function_call();
+    }
+    return m_invoke(m_storage, std::forward<Args>(args)...);
+  }
+
+private:
+  using invoke_ptr = Result (*)(std::byte *, Args &&...);
+  using manage_ptr = void (*)(std::byte *from, std::byte *to) noexcept;
+
+  template <typename F>
+  static Result invoke(std::byte *storage, Args &&...args) {
+    return std::invoke(*std::launder(reinterpret_cast<F *>(storage)),
+                       std::forward<Args>(args)...);
+  }
+
+  // Moves the callable to `to` if given, then destroys it in `from`
+  template <typename F>
+  static void manage(std::byte *from, std::byte *to) noexcept {
+    auto *func{std::launder(reinterpret_cast<F *>(from))};
+    if (to != nullptr) {
+      ::new (static_cast<void *>(to)) F(std::move(*func));
+    }
+    func->~F();
+  }
+
+  void move_from(inplace_function &other) noexcept {
+    if (other.m_manage != nullptr) {
+      other.m_manage(other.m_storage, m_storage);
+    }
+    m_invoke = std::exchange(other.m_invoke, nullptr);
+    m_manage = std::exchange(other.m_manage, nullptr);
+  }
+
+  void reset() noexcept {
+    if (m_manage != nullptr) {
+      m_manage(m_storage, nullptr);
+      m_invoke = nullptr;
+      m_manage = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) mutable std::byte m_storage[Capacity]; ///< Buffer.
+  invoke_ptr m_invoke{nullptr}; ///< Calls the stored callable.
+  manage_ptr m_manage{nullptr}; ///< Moves and destroys the stored callable.
+};
+
+template <class TypeErasure, class T, typename... Args, class F>
+inline std::pair<const typename type_erasure_traits<TypeErasure>::key_type,
+                 inplace_function<void(TypeErasure const &, Args...)>>
+to_erased_visitor(F const &f) {
+  return {type_erasure_traits<TypeErasure>::template key<T>(),
+          [g = f](TypeErasure const &a, Args &&...args) {
+            using std::any_cast;
             if constexpr (std::is_void_v<T>)
               g();
             else
-              g(std::any_cast<T const &>(a), std::forward<Args>(args)...);
+              g(any_cast<T const &>(a), std::forward<Args>(args)...);
           }};
 }
 
+template <class T, typename... Args, class F>
+inline std::pair<const std::type_index,
+                 inplace_function<void(std::any const &, Args...)>>
+to_any_visitor(F const &f) {
+  return to_erased_visitor<std::any, T, Args...>(f);
+}
+
+/**
+ * @brief Builds a visitor map from visitors created by to_erased_visitor.
+ *
+ * The visitors are moved into the map, so move-only callables are supported.
+ *
+ * @tparam Map The map type.
+ * @param visitors The key/visitor pairs.
+ * @return The map.
+ */
+template <typename Map, typename... Visitors>
+inline Map make_visitor_map(Visitors &&...visitors) {
+  Map map;
+  map.reserve(sizeof...(Visitors));
+  (map.insert(std::forward<Visitors>(visitors)), ...);
+  return map;
+}
+
 namespace detail {
 template <class AlwaysVoid, template<class...> class Op, class... Args>
 struct detector {
@@ -42,6 +235,254 @@ using is_detected = typename detail::detector<void, Op, Args...>::value_t;
 
 template <template<class...> class Op, class... Args>
 const auto is_detected_v = is_detected<Op, Args...>::value;
+
+/**
+ * @brief A string literal usable as a non-type template parameter.
+ *
+ * @tparam N The size of the literal including the terminating null character.
+ */
+template <std::size_t N> struct fixed_string {
+  /**
+   * @brief Constructs the fixed_string from a string literal.
+   *
+   * @param str The string literal.
+   */
+  constexpr fixed_string(char const (&str)[N]) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+      m_data[i] = str[i];
+    }
+  }
+
+  /**
+   * @brief Returns the string without the terminating null character.
+   */
+  [[nodiscard]] constexpr std::string_view view() const noexcept {
+    return {m_data, N - 1};
+  }
+
+  /**
+   * @brief Returns the length of the string.
+   */
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return N - 1; }
+
+  char m_data[N]{}; ///< The characters including the null terminator.
+};
+
+/**
+ * @brief Converts a key to a std::string for diagnostic messages.
+ *
+ * String-like keys (including std::pmr::string and std::string_view) are
+ * copied, arithmetic keys are converted with std::to_string.
+ *
+ * @tparam Key The key type.
+ * @param key The key to convert.
+ * @return The textual representation of the key.
+ */
+template <typename Key> inline std::string to_key_string(Key const &key) {
+  if constexpr (std::is_convertible_v<Key const &, std::string_view>) {
+    return std::string(std::string_view(key));
+  } else {
+    return std::to_string(key);
+  }
+}
+
+/**
+ * @brief Trait telling whether references to mapped values of a map template
+ * stay valid when other keys are inserted.
+ *
+ * Node-based maps such as std::map and std::unordered_map guarantee this;
+ * storage that relocates its entries specializes the trait to false.
+ *
+ * @tparam Map The map template.
+ */
+template <template <class...> class Map>
+struct has_stable_references : std::true_type {};
+
+template <template <class...> class Map>
+constexpr bool has_stable_references_v = has_stable_references<Map>::value;
+
+/**
+ * @brief Transparent hash for string-like keys.
+ *
+ * Hashes everything convertible to std::string_view with
+ * std::hash<std::string_view>, which equals std::hash<std::string>, so
+ * std::string, std::pmr::string, std::string_view and string literals can be
+ * used to look up the same entry without building a temporary key.
+ */
+struct string_hash {
+  using is_transparent = void; ///< Enables heterogeneous lookup.
+
+  /**
+   * @brief Hashes a string-like key.
+   *
+   * @param key The key to hash.
+   * @return The hash of the key.
+   */
+  std::size_t operator()(std::string_view key) const noexcept {
+    return std::hash<std::string_view>{}(key);
+  }
+};
+
+/**
+ * @brief Whether a key type is string-like, i.e. convertible to
+ * std::string_view.
+ */
+template <typename Key>
+constexpr bool is_string_key_v =
+    std::is_convertible_v<Key const &, std::string_view>;
+
+/**
+ * @brief Whether a function object enables heterogeneous lookup.
+ */
+template <typename T>
+constexpr bool is_transparent_v = requires { typename T::is_transparent; };
+
+/**
+ * @brief Whether `K` may be used to look up a `Key` without conversion.
+ *
+ * This is the case for every string-like `K` other than `Key` itself when
+ * `Key` is string-like.
+ */
+template <typename K, typename Key>
+constexpr bool is_heterogeneous_key_v =
+    !std::is_same_v<std::remove_cvref_t<K>, Key> && is_string_key_v<Key> &&
+    std::is_convertible_v<K const &, std::string_view>;
+
+/**
+ * @brief Hash used for keys of type Key: string_hash for string-like keys,
+ * std::hash<Key> otherwise.
+ */
+template <typename Key>
+using key_hash_t =
+    std::conditional_t<is_string_key_v<Key>, string_hash, std::hash<Key>>;
+
+/**
+ * @brief Key equality used for keys of type Key: the transparent
+ * std::equal_to<> for string-like keys, std::equal_to<Key> otherwise.
+ */
+template <typename Key>
+using key_equal_t = std::conditional_t<is_string_key_v<Key>, std::equal_to<>,
+                                       std::equal_to<Key>>;
+
+namespace detail {
+/**
+ * @brief Selects transparent function objects for a map template.
+ *
+ * Hash maps (having a `hasher`) get key_hash_t and key_equal_t, ordered maps
+ * (having a `key_compare`) get std::less<> for string-like keys. Any other map
+ * template is used unchanged.
+ */
+template <template <class...> class Map, typename Key, typename Value>
+struct transparent_map {
+  using type = Map<Key, Value>; ///< Fallback: the map unchanged.
+};
+
+template <template <class...> class Map, typename Key, typename Value>
+  requires requires { typename Map<Key, Value>::hasher; }
+struct transparent_map<Map, Key, Value> {
+  using type = Map<Key, Value, key_hash_t<Key>,
+                   key_equal_t<Key>>; ///< Hash map with transparent lookup.
+};
+
+template <template <class...> class Map, typename Key, typename Value>
+  requires(requires { typename Map<Key, Value>::key_compare; } &&
+           is_string_key_v<Key>)
+struct transparent_map<Map, Key, Value> {
+  using type =
+      Map<Key, Value, std::less<>>; ///< Ordered map with transparent lookup.
+};
+} // namespace detail
+
+/**
+ * @brief `Map<Key, Value>` with heterogeneous lookup enabled where the map
+ * template supports it.
+ */
+template <template <class...> class Map, typename Key, typename Value>
+using transparent_map_t =
+    typename detail::transparent_map<Map, Key, Value>::type;
+
+/**
+ * @brief Combined hash of all elements of a key tuple.
+ *
+ * Every element is hashed with the key_hash_t of the corresponding element of
+ * Tuple, so tuples of references such as `std::forward_as_tuple(keys...)` hash
+ * equal to the stored key and can be looked up without building a Tuple.
+ *
+ * @tparam Tuple The stored key tuple.
+ */
+template <typename Tuple> struct tuple_hash {
+  using is_transparent = void; ///< Enables heterogeneous lookup.
+
+  /**
+   * @brief Hashes a tuple whose elements are comparable to those of Tuple.
+   *
+   * @param keys The tuple to hash.
+   * @return The combined hash.
+   */
+  template <typename Other>
+  std::size_t operator()(Other const &keys) const noexcept {
+    return hash_impl(keys,
+                     std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+  }
+
+private:
+  /**
+   * @brief Combines the element hashes in index order.
+   */
+  template <typename Other, std::size_t... Index>
+  static std::size_t hash_impl(Other const &keys,
+                               std::index_sequence<Index...>) noexcept {
+    std::size_t seed{0};
+    ((seed ^= key_hash_t<std::tuple_element_t<Index, Tuple>>{}(
+                  std::get<Index>(keys)) +
+              0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)),
+     ...);
+    return seed;
+  }
+};
+
+/**
+ * @brief Transparent element-wise equality for key tuples.
+ */
+struct tuple_equal {
+  using is_transparent = void; ///< Enables heterogeneous lookup.
+
+  /**
+   * @brief Compares two tuples of the same size element by element.
+   */
+  template <typename Lhs, typename Rhs>
+  bool operator()(Lhs const &lhs, Rhs const &rhs) const {
+    return equal_impl(lhs, rhs,
+                      std::make_index_sequence<std::tuple_size_v<Lhs>>{});
+  }
+
+private:
+  /**
+   * @brief Compares the elements in index order.
+   */
+  template <typename Lhs, typename Rhs, std::size_t... Index>
+  static bool equal_impl(Lhs const &lhs, Rhs const &rhs,
+                         std::index_sequence<Index...>) {
+    return ((std::get<Index>(lhs) == std::get<Index>(rhs)) && ...);
+  }
+};
+
+/**
+ * @brief Joins the textual representation of all keys of a tuple.
+ *
+ * @param keys The key tuple.
+ * @return The keys formatted as "(key0, key1, ...)".
+ */
+template <typename Tuple> inline std::string to_key_string_tuple(Tuple const &keys) {
+  std::string result{"("};
+  std::apply(
+      [&](auto const &...key) {
+        std::size_t index{0};
+        ((result += (index++ == 0 ? "" : ", ") + to_key_string(key)), ...);
+      },
+      keys);
+  return result + ")";
+}
 }
 
 #endif // UVWBASE_UTILITY_H
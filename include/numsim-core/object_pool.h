@@ -0,0 +1,254 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace numsim_core {
+
+/**
+ * @brief A type-specific slab allocator recycling the storage of destroyed
+ * objects.
+ *
+ * Storage is obtained from the heap in slabs of `SlabSize` objects and never
+ * returned before the pool is destroyed. Freed blocks are kept in an intrusive
+ * free list, so once the pool has grown to the peak number of live objects,
+ * creating and destroying objects does not touch malloc anymore.
+ *
+ * All member functions are thread-safe.
+ *
+ * @tparam T The type of the pooled objects.
+ * @tparam SlabSize The number of objects per slab.
+ */
+template <typename T, std::size_t SlabSize = 64> class object_pool {
+  static_assert(SlabSize > 0, "object_pool requires a non-empty slab");
+
+public:
+  /**
+   * @brief Default constructor, no storage is allocated.
+   */
+  object_pool() = default;
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  object_pool(object_pool const &) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   */
+  object_pool &operator=(object_pool const &) = delete;
+
+  /**
+   * @brief Returns the process-wide pool of T.
+   *
+   * The pool is intentionally never destroyed, so objects may outlive static
+   * destruction order without touching a dead pool.
+   */
+  static object_pool &instance() {
+    static auto *pool{new object_pool()};
+    return *pool;
+  }
+
+  /**
+   * @brief Returns uninitialized storage for one T.
+   */
+  [[nodiscard]] void *allocate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_free == nullptr) {
+      grow();
+    }
+    auto *block{m_free};
+    m_free = block->m_next;
+    ++m_size;
+    return block->m_storage;
+  }
+
+  /**
+   * @brief Returns storage obtained from allocate() to the pool.
+   *
+   * @param ptr The storage to release.
+   */
+  void deallocate(void *ptr) noexcept {
+    auto *block{::new (ptr) node};
+    std::lock_guard<std::mutex> lock(m_mutex);
+    block->m_next = m_free;
+    m_free = block;
+    --m_size;
+  }
+
+  /**
+   * @brief Constructs a T in pooled storage.
+   *
+   * @param args The arguments forwarded to the constructor of T.
+   * @return A pointer to the new object.
+   */
+  template <typename... Args> [[nodiscard]] T *create(Args &&...args) {
+    auto *storage{allocate()};
+    try {
+      return ::new (storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(storage);
+      throw;
+    }
+  }
+
+  /**
+   * @brief Destroys an object created by create() and recycles its storage.
+   *
+   * @param ptr The object to destroy.
+   */
+  void destroy(T *ptr) noexcept {
+    ptr->~T();
+    deallocate(ptr);
+  }
+
+  /**
+   * @brief Returns the number of live objects.
+   */
+  [[nodiscard]] std::size_t size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+  }
+
+  /**
+   * @brief Returns the number of objects the allocated slabs can hold.
+   */
+  [[nodiscard]] std::size_t capacity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slabs.size() * SlabSize;
+  }
+
+private:
+  /**
+   * @brief A block of storage, linked into the free list while unused.
+   */
+  union node {
+    node *m_next;                                  ///< Next free block.
+    alignas(T) std::byte m_storage[sizeof(T)];     ///< Object storage.
+  };
+
+  /**
+   * @brief Allocates a new slab and links its blocks into the free list.
+   */
+  void grow() {
+    m_slabs.push_back(std::make_unique<node[]>(SlabSize));
+    auto *slab{m_slabs.back().get()};
+    for (std::size_t i = SlabSize; i-- > 0;) {
+      slab[i].m_next = m_free;
+      m_free = &slab[i];
+    }
+  }
+
+  mutable std::mutex m_mutex;                ///< Guards the free list.
+  std::vector<std::unique_ptr<node[]>> m_slabs; ///< The allocated slabs.
+  node *m_free{nullptr};                     ///< Head of the free list.
+  std::size_t m_size{0};                     ///< Number of live objects.
+};
+
+/**
+ * @brief Deleter of objects built through a registry_entry.
+ *
+ * The deleter remembers how the object was constructed, so heap and pooled
+ * objects can share one smart pointer type. A default constructed deleter
+ * deletes with `delete`.
+ *
+ * @tparam Base The static type of the managed pointer.
+ */
+template <typename Base> class object_deleter {
+public:
+  /**
+   * @brief Signature of the function destroying an object.
+   */
+  using destroy_ptr = void (*)(Base *) noexcept;
+
+  /**
+   * @brief Constructs a deleter using `delete`.
+   */
+  constexpr object_deleter() noexcept = default;
+
+  /**
+   * @brief Constructs a deleter using the given destroy function.
+   *
+   * @param destroy The function destroying the object.
+   */
+  constexpr explicit object_deleter(destroy_ptr destroy) noexcept
+      : m_destroy(destroy) {}
+
+  /**
+   * @brief Destroys the object.
+   *
+   * @param ptr The object to destroy.
+   */
+  void operator()(Base *ptr) const noexcept { m_destroy(ptr); }
+
+  /**
+   * @brief Returns a deleter returning objects of type Derived to their
+   * object_pool.
+   *
+   * @tparam Derived The dynamic type of the managed objects.
+   */
+  template <typename Derived> static constexpr object_deleter pooled() noexcept {
+    return object_deleter(&destroy_pooled<Derived>);
+  }
+
+private:
+  /**
+   * @brief Destroys a heap allocated object.
+   */
+  static void destroy_heap(Base *ptr) noexcept { delete ptr; }
+
+  /**
+   * @brief Destroys a pooled object, adjusting the pointer to the full object.
+   */
+  template <typename Derived> static void destroy_pooled(Base *ptr) noexcept {
+    object_pool<Derived>::instance().destroy(static_cast<Derived *>(ptr));
+  }
+
+  destroy_ptr m_destroy{&destroy_heap}; ///< Function destroying the object.
+};
+
+/**
+ * @brief Construction policy allocating every object with `new`.
+ */
+struct heap_construction {
+  /**
+   * @brief Constructs a Derived on the heap.
+   *
+   * @tparam Derived The type to construct.
+   * @tparam Base The static type of the returned pointer.
+   * @param args The arguments forwarded to the constructor.
+   */
+  template <typename Derived, typename Base, typename... Args>
+  static std::unique_ptr<Base, object_deleter<Base>> construct(Args &&...args) {
+    return std::unique_ptr<Base, object_deleter<Base>>(
+        new Derived(std::forward<Args>(args)...));
+  }
+};
+
+/**
+ * @brief Construction policy taking objects from a per-type object_pool.
+ */
+struct pool_construction {
+  /**
+   * @brief Constructs a Derived in the object_pool of Derived.
+   *
+   * @tparam Derived The type to construct.
+   * @tparam Base The static type of the returned pointer.
+   * @param args The arguments forwarded to the constructor.
+   */
+  template <typename Derived, typename Base, typename... Args>
+  static std::unique_ptr<Base, object_deleter<Base>> construct(Args &&...args) {
+    return std::unique_ptr<Base, object_deleter<Base>>(
+        object_pool<Derived>::instance().create(std::forward<Args>(args)...),
+        object_deleter<Base>::template pooled<Derived>());
+  }
+};
+
+} // namespace numsim_core
+
+#endif // OBJECT_POOL_H
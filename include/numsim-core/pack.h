@@ -0,0 +1,234 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include "numsim_core_utility.h"
+#include "snapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace numsim_core {
+
+/**
+ * @file pack.h
+ * @brief Flattening parameter sets into one buffer for collective transfer.
+ *
+ * pack() serializes a parameter_handler, a query_map or a flat_query_map
+ * into one contiguous buffer in the snapshot format, unpack() rebuilds the
+ * contents from it. broadcast() combines both around a user supplied byte
+ * broadcast, so a parameter set is distributed with two collectives instead
+ * of one message per entry, independent of the message passing library:
+ *
+ * @code
+ * numsim_core::broadcast(handler, rank == 0, [&](void *data, std::size_t size) {
+ *   MPI_Bcast(data, static_cast<int>(size), MPI_BYTE, 0, MPI_COMM_WORLD);
+ * });
+ * @endcode
+ *
+ * The value types are those of to_snapshot(). Buffers of a query_map encode
+ * its key tuple and are only understood by a map with the same key types.
+ */
+
+namespace detail {
+/**
+ * @brief Appends the binary representation of one key to a packed key.
+ *
+ * String-like keys are stored with their length, arithmetic and enum keys
+ * by value.
+ */
+template <typename Key> void pack_key(std::string &out, Key const &key) {
+  if constexpr (is_string_key_v<Key>) {
+    const std::string_view value(key);
+    const auto size{static_cast<std::uint32_t>(value.size())};
+    out.append(reinterpret_cast<char const *>(&size), sizeof(size));
+    out.append(value);
+  } else {
+    static_assert(std::is_arithmetic_v<Key> || std::is_enum_v<Key>,
+                  "pack: keys must be string-like, arithmetic or enums");
+    out.append(reinterpret_cast<char const *>(&key), sizeof(Key));
+  }
+}
+
+/**
+ * @brief Reads one key from the front of a packed key.
+ *
+ * @throws std::runtime_error if the packed key is too short.
+ */
+template <typename Key> Key unpack_key(std::string_view &in) {
+  const auto take{[&in](std::size_t size) {
+    if (in.size() < size) {
+      throw std::runtime_error("numsim_core::unpack: corrupt key");
+    }
+    const auto bytes{in.substr(0, size)};
+    in.remove_prefix(size);
+    return bytes;
+  }};
+  if constexpr (is_string_key_v<Key>) {
+    std::uint32_t size;
+    std::memcpy(&size, take(sizeof(size)).data(), sizeof(size));
+    return Key(take(size));
+  } else {
+    Key key;
+    std::memcpy(&key, take(sizeof(Key)).data(), sizeof(Key));
+    return key;
+  }
+}
+
+/**
+ * @brief Unpacks a complete key tuple.
+ */
+template <typename Tuple, std::size_t... Index>
+Tuple unpack_keys(std::string_view in, std::index_sequence<Index...>) {
+  // braced initialization evaluates the keys in order
+  Tuple keys{unpack_key<std::tuple_element_t<Index, Tuple>>(in)...};
+  if (!in.empty()) {
+    throw std::runtime_error("numsim_core::unpack: corrupt key");
+  }
+  return keys;
+}
+
+/**
+ * @brief Checks whether the leading keys equal the given prefix.
+ */
+template <typename Keys, typename Prefix, std::size_t... Index>
+bool matches_prefix(Keys const &keys, Prefix const &prefix,
+                    std::index_sequence<Index...>) {
+  return ((std::get<Index>(keys) == std::get<Index>(prefix)) && ...);
+}
+
+/**
+ * @brief Whether a container stores its values under key tuples.
+ */
+template <typename Container>
+concept keyed_by_tuple = requires { typename Container::tuple_type; };
+} // namespace detail
+
+/**
+ * @brief Packs all parameters of a parameter_handler.
+ *
+ * @param handler The handler to pack.
+ * @return The packed buffer.
+ * @throws std::runtime_error if a parameter has an unsupported type.
+ */
+template <typename Handler>
+  requires(!detail::keyed_by_tuple<Handler>)
+std::vector<std::byte> pack(Handler const &handler) {
+  return to_snapshot(handler);
+}
+
+/**
+ * @brief Packs the values of a query_map or flat_query_map, optionally only
+ * a subtree.
+ *
+ * @param map The map to pack.
+ * @param prefix Leading keys selecting the subtree; all values if empty.
+ * @return The packed buffer.
+ * @throws std::runtime_error if a value has an unsupported type.
+ */
+template <detail::keyed_by_tuple Map, typename... Prefix>
+std::vector<std::byte> pack(Map const &map, Prefix const &...prefix) {
+  using type_erasure = typename Map::type_erasure_type;
+  static_assert(sizeof...(Prefix) <= std::tuple_size_v<typename Map::tuple_type>,
+                "pack: more prefix keys than key levels");
+  std::vector<std::string> keys;
+  std::vector<type_erasure const *> values;
+  const auto expected{std::forward_as_tuple(prefix...)};
+  map.for_each([&](type_erasure const &value, auto const &...key) {
+    if (!detail::matches_prefix(std::forward_as_tuple(key...), expected,
+                                std::index_sequence_for<Prefix...>{})) {
+      return;
+    }
+    auto &packed{keys.emplace_back()};
+    (detail::pack_key(packed, key), ...);
+    values.push_back(&value);
+  });
+
+  std::vector<std::pair<std::string_view, type_erasure const *>> entries;
+  entries.reserve(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    entries.emplace_back(keys[i], values[i]);
+  }
+  return detail::write_snapshot_entries(entries);
+}
+
+/**
+ * @brief Inserts the parameters of a packed buffer into a parameter_handler.
+ *
+ * See snapshot_view::load().
+ *
+ * @param buffer The packed buffer, aligned to 8 bytes.
+ * @param handler The handler to fill; existing keys are overwritten.
+ * @throws std::runtime_error if the buffer is not a valid packed buffer.
+ */
+template <typename Handler>
+  requires(!detail::keyed_by_tuple<Handler>)
+void unpack(std::span<std::byte const> buffer, Handler &handler) {
+  snapshot_view(buffer).load(handler);
+}
+
+/**
+ * @brief Sets the values of a packed buffer in a query_map or
+ * flat_query_map.
+ *
+ * @param buffer The packed buffer, aligned to 8 bytes.
+ * @param map The map to fill; existing values are overwritten.
+ * @throws std::runtime_error if the buffer is not a valid packed buffer.
+ */
+template <detail::keyed_by_tuple Map>
+void unpack(std::span<std::byte const> buffer, Map &map) {
+  using tuple_type = typename Map::tuple_type;
+  const snapshot_view view(buffer);
+  for (const auto &item : view) {
+    auto keys{detail::unpack_keys<tuple_type>(
+        item.m_key,
+        std::make_index_sequence<std::tuple_size_v<tuple_type>>{})};
+    snapshot_view::visit(item, [&](auto &&value) {
+      std::apply(
+          [&](auto &&...key) {
+            map.set(typename Map::type_erasure_type(
+                        std::forward<decltype(value)>(value)),
+                    std::move(key)...);
+          },
+          std::move(keys));
+    });
+  }
+}
+
+/**
+ * @brief Distributes a container from a root process to all others.
+ *
+ * The root packs the container, then the size and the buffer are passed to
+ * `bcast`, which must broadcast the bytes at the given address from the
+ * root to all processes. The other processes unpack the buffer into their
+ * container.
+ *
+ * @param container The parameter_handler, query_map or flat_query_map.
+ * @param root Whether the calling process is the root.
+ * @param bcast Called as `bcast(void *data, std::size_t size)`.
+ */
+template <typename Container, typename Broadcast>
+void broadcast(Container &container, bool root, Broadcast &&bcast) {
+  std::vector<std::byte> buffer;
+  if (root) {
+    buffer = pack(container);
+  }
+  auto size{static_cast<std::uint64_t>(buffer.size())};
+  bcast(static_cast<void *>(&size), sizeof(size));
+  buffer.resize(static_cast<std::size_t>(size));
+  bcast(static_cast<void *>(buffer.data()), buffer.size());
+  if (!root) {
+    unpack(buffer, container);
+  }
+}
+
+} // namespace numsim_core
+
+#endif // PACK_H
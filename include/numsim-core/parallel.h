@@ -0,0 +1,241 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace numsim_core {
+
+namespace detail {
+
+/**
+ * @brief Worker threads of a parallel_executor, started on first use and
+ * reused by all later calls.
+ */
+class thread_pool {
+public:
+  /**
+   * @brief Constructs a pool without starting its threads.
+   *
+   * @param size The number of worker threads.
+   */
+  explicit thread_pool(unsigned size) noexcept : m_size(size) {}
+
+  thread_pool(thread_pool const &) = delete;
+  thread_pool &operator=(thread_pool const &) = delete;
+
+  ~thread_pool() { stop(); }
+
+  /**
+   * @brief Calls `job()` on the calling thread and on `helpers` worker
+   * threads and returns once all calls have returned.
+   *
+   * Only one job runs at a time; while the pool is busy, e.g. for a call
+   * from within a job, nothing is run and false is returned.
+   *
+   * @param helpers The number of worker threads, at most the pool size.
+   * @param job A callable that does not throw.
+   * @return Whether the job was run.
+   * @throws std::system_error if the threads cannot be started.
+   */
+  template <typename Job> bool run(unsigned helpers, Job &job) {
+    if (m_busy.exchange(true, std::memory_order_acquire)) {
+      return false;
+    }
+    struct release {
+      std::atomic<bool> &m_flag;
+      ~release() { m_flag.store(false, std::memory_order_release); }
+    } const busy{m_busy};
+    start();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_job = &job;
+      m_invoke = [](void *context) { (*static_cast<Job *>(context))(); };
+      m_helpers = helpers;
+      m_running = helpers;
+      ++m_epoch;
+    }
+    m_wake.notify_all();
+    job();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_running == 0; });
+    return true;
+  }
+
+private:
+  /**
+   * @brief Starts the worker threads if they are not running; the threads
+   * already started are joined if one cannot be.
+   */
+  void start() {
+    if (!m_workers.empty()) {
+      return;
+    }
+    try {
+      m_workers.reserve(m_size);
+      for (unsigned i = 0; i < m_size; ++i) {
+        m_workers.emplace_back([this, i, epoch = m_epoch] { work(i, epoch); });
+      }
+    } catch (...) {
+      stop();
+      throw;
+    }
+  }
+
+  /**
+   * @brief Stops and joins the worker threads.
+   */
+  void stop() noexcept {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto &worker : m_workers) {
+      worker.join();
+    }
+    m_workers.clear();
+    m_stop = false;
+  }
+
+  /**
+   * @brief The loop of worker `index`, running every job that asks for it.
+   */
+  void work(unsigned index, std::size_t seen) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      m_wake.wait(lock, [&] { return m_stop || m_epoch != seen; });
+      if (m_stop) {
+        return;
+      }
+      seen = m_epoch;
+      if (index >= m_helpers) {
+        continue;
+      }
+      const auto invoke{m_invoke};
+      auto *const job{m_job};
+      lock.unlock();
+      invoke(job);
+      lock.lock();
+      if (--m_running == 0) {
+        m_done.notify_one();
+      }
+    }
+  }
+
+  unsigned m_size;                    ///< Number of worker threads.
+  std::vector<std::thread> m_workers; ///< The started worker threads.
+  std::atomic<bool> m_busy{false};    ///< Set while a job runs.
+  std::mutex m_mutex;                 ///< Guards the job state below.
+  std::condition_variable m_wake;     ///< Signals a new job or stop.
+  std::condition_variable m_done;     ///< Signals the end of a job.
+  void *m_job{nullptr};               ///< The current job.
+  void (*m_invoke)(void *){nullptr};  ///< Calls the current job.
+  unsigned m_helpers{0};              ///< Workers taking part in the job.
+  unsigned m_running{0};              ///< Workers still running the job.
+  std::size_t m_epoch{0};             ///< Number of jobs started.
+  bool m_stop{false};                 ///< Asks the workers to exit.
+};
+
+} // namespace detail
+
+/**
+ * @brief A minimal executor that runs an index range on a set of threads.
+ *
+ * Indices are handed out in chunks from a shared atomic counter, so threads
+ * that finish early keep pulling work and uneven workloads balance out. The
+ * executor is the default for all batched and parallel operations in
+ * numsim-core; any callable with the signature
+ * `void(std::size_t count, Function &&f)` can be used in its place.
+ *
+ * The threads are started on the first parallel call and reused by all
+ * later calls, and by copies of the executor, until the last copy is
+ * destroyed. A call made while the threads are busy, from another thread or
+ * from within `f`, runs on the calling thread alone.
+ */
+class parallel_executor {
+public:
+  /**
+   * @brief Constructs an executor.
+   *
+   * @param threads The number of threads, 0 selects
+   * std::thread::hardware_concurrency().
+   * @param grain The number of indices a thread takes at once.
+   */
+  explicit parallel_executor(unsigned threads = 0, std::size_t grain = 16)
+      : m_threads(threads != 0 ? threads
+                               : std::max(1u, std::thread::hardware_concurrency())),
+        m_grain(std::max<std::size_t>(grain, 1)),
+        m_pool(std::make_shared<detail::thread_pool>(m_threads - 1)) {}
+
+  /**
+   * @brief Returns the number of threads used by the executor.
+   */
+  [[nodiscard]] unsigned threads() const noexcept { return m_threads; }
+
+  /**
+   * @brief Calls `func(i)` for every `i` in `[0, count)`.
+   *
+   * The call returns once all indices are processed. If `func` throws, the
+   * remaining indices are skipped and the first exception is rethrown.
+   *
+   * @tparam Function The type of the callable.
+   * @param count The number of indices.
+   * @param func The callable invoked for each index.
+   * @throws std::system_error if the threads cannot be started; the threads
+   * already started are joined first.
+   */
+  template <typename Function>
+  void operator()(std::size_t count, Function &&func) const {
+    const auto chunks{(count + m_grain - 1) / m_grain};
+    const auto workers{
+        static_cast<unsigned>(std::min<std::size_t>(m_threads, chunks))};
+    if (workers > 1) {
+      std::atomic<std::size_t> next{0};
+      std::exception_ptr error{nullptr};
+      std::mutex error_mutex;
+      auto work{[&]() noexcept {
+        try {
+          for (auto begin{next.fetch_add(m_grain)}; begin < count;
+               begin = next.fetch_add(m_grain)) {
+            const auto end{std::min(begin + m_grain, count)};
+            for (auto i{begin}; i < end; ++i) {
+              func(i);
+            }
+          }
+        } catch (...) {
+          next.store(count);
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }};
+      if (m_pool->run(workers - 1, work)) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+        return;
+      }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+  }
+
+private:
+  unsigned m_threads;   ///< Number of threads.
+  std::size_t m_grain;  ///< Number of indices per chunk.
+  std::shared_ptr<detail::thread_pool> m_pool; ///< The worker threads.
+};
+
+} // namespace numsim_core
+
+#endif // PARALLEL_H
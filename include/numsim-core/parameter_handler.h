@@ -2,10 +2,21 @@
 #define PARAMETER_HANDLER_H
 
 #include "any_printer.h"
+#include "flat_hash_map.h"
+#include "instrumentation.h"
+#include <algorithm>
 #include <any>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace numsim_core {
 
@@ -20,19 +31,170 @@ namespace numsim_core {
  * @tparam KeyType Type of the keys used for storing parameters (default is
  * std::string).
  * @tparam TypeErasure Type used for the values stored in the handler (default
- * is std::any).
+ * is std::any), any type supporting `any_cast` such as numsim_core::small_any.
+ * @tparam Map Storage policy, a map template such as std::unordered_map
+ * (default) or numsim_core::flat_hash_map. String-like keys are stored with
+ * transparent hashing, so lookups from std::string_view or string literals do
+ * not construct a temporary KeyType.
  */
-template <typename KeyType = std::string, typename TypeErasure = std::any>
+template <typename KeyType = std::string, typename TypeErasure = std::any,
+          template <class... ArgsMap> class Map = std::unordered_map>
 class parameter_handler {
 public:
   using key_type =
       KeyType; ///< Alias for the key type used in the parameter handler.
+  using map_type =
+      transparent_map_t<Map, KeyType,
+                        TypeErasure>; ///< Alias for the underlying storage type.
+  using allocator_type =
+      typename map_type::allocator_type; ///< Allocator of the storage.
+  using type_erasure_type =
+      TypeErasure; ///< Alias for the type-erased value type.
+  using deferred_producer = inplace_function<TypeErasure(
+      parameter_handler const &)>; ///< Computes a deferred value.
+
+  /**
+   * @brief A pre-resolved, typed accessor to a single parameter.
+   *
+   * A handle caches a pointer to the stored value, so accessing it involves
+   * neither hashing nor a type check. It is bound to the generation of the
+   * handler it was resolved from: any insert() that may move or replace
+   * stored values, every clear(), assignment and move invalidate outstanding
+   * handles, and accessing an invalidated handle throws instead of dangling.
+   *
+   * @note A handle must not outlive the handler it was resolved from.
+   *
+   * @tparam T The type of the referenced parameter.
+   */
+  template <typename T> class handle {
+  public:
+    /**
+     * @brief Constructs an empty, invalid handle.
+     */
+    handle() = default;
+
+    /**
+     * @brief Checks whether the handle still refers to a live value.
+     *
+     * @return True if the owning handler was not modified since resolving.
+     */
+    [[nodiscard]] bool valid() const noexcept {
+      return m_owner != nullptr && m_owner->m_generation == m_generation;
+    }
+
+    /**
+     * @brief Checks whether the handle still refers to a live value.
+     */
+    explicit operator bool() const noexcept { return valid(); }
+
+    /**
+     * @brief Accesses the referenced value.
+     *
+     * @return A reference to the parameter value.
+     * @throws std::runtime_error if the handle was invalidated.
+     */
+    T &get() const {
+      if (!valid()) {
+        throw std::runtime_error("parameter_handler::handle::get() handle "
+                                 "is invalid");
+      }
+      return *m_data;
+    }
+
+    /**
+     * @brief Accesses the referenced value.
+     */
+    T &operator*() const { return get(); }
+
+    /**
+     * @brief Accesses members of the referenced value.
+     */
+    T *operator->() const { return &get(); }
+
+  private:
+    friend class parameter_handler;
+
+    /**
+     * @brief Binds the handle to a value of the given handler.
+     */
+    handle(parameter_handler const &owner, T &data) noexcept
+        : m_owner(&owner), m_data(&data), m_generation(owner.m_generation) {}
+
+    parameter_handler const *m_owner{nullptr}; ///< The owning handler.
+    T *m_data{nullptr};             ///< Cached pointer to the stored value.
+    std::size_t m_generation{0};    ///< Handler generation at resolve time.
+  };
 
   /**
    * @brief Constructs an empty parameter handler.
    */
   parameter_handler() {}
 
+  /**
+   * @brief Constructs an empty parameter handler whose storage, including the
+   * key strings of allocator-aware key types, uses the given allocator.
+   *
+   * Combined with a std::pmr::monotonic_buffer_resource, a whole parameter set
+   * is released at once together with the resource.
+   *
+   * @param alloc The allocator of the underlying storage.
+   */
+  explicit parameter_handler(allocator_type const &alloc) : m_data(alloc) {}
+
+  /**
+   * @brief Copies a handler; handles resolved from other stay bound to it.
+   */
+  parameter_handler(parameter_handler const &other)
+      : m_data(other.m_data), m_deferred(other.m_deferred),
+        m_dependents(other.m_dependents) {}
+
+  /**
+   * @brief Moves a handler and invalidates the handles resolved from other.
+   */
+  parameter_handler(parameter_handler &&other) noexcept(
+      std::is_nothrow_move_constructible_v<map_type> &&
+      std::is_nothrow_move_constructible_v<decltype(m_deferred)> &&
+      std::is_nothrow_move_constructible_v<decltype(m_dependents)>)
+      : m_data(std::move(other.m_data)),
+        m_deferred(std::move(other.m_deferred)),
+        m_dependents(std::move(other.m_dependents)) {
+    ++other.m_generation;
+  }
+
+  /**
+   * @brief Copies a handler and invalidates the handles resolved from this
+   * one.
+   *
+   * The generation is advanced past that of both handlers instead of being
+   * copied, so no handle of this handler can report a valid state.
+   */
+  parameter_handler &operator=(parameter_handler const &other) {
+    if (this != &other) {
+      m_data = other.m_data;
+      m_deferred = other.m_deferred;
+      m_dependents = other.m_dependents;
+      m_generation = std::max(m_generation, other.m_generation) + 1;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Moves a handler and invalidates the handles resolved from both.
+   */
+  parameter_handler &operator=(parameter_handler &&other) noexcept(
+      std::is_nothrow_move_assignable_v<map_type> &&
+      std::is_nothrow_move_assignable_v<decltype(m_deferred)> &&
+      std::is_nothrow_move_assignable_v<decltype(m_dependents)>) {
+    if (this != &other) {
+      m_data = std::move(other.m_data);
+      m_deferred = std::move(other.m_deferred);
+      m_dependents = std::move(other.m_dependents);
+      m_generation = std::max(m_generation, other.m_generation) + 1;
+      ++other.m_generation;
+    }
+    return *this;
+  }
+
   /**
    * @brief Inserts or assigns a value to the specified key.
    *
@@ -45,8 +207,7 @@ public:
    * @return A reference to the inserted or updated value.
    */
   template <typename T> T &insert(KeyType &&name, T &&value) {
-    auto iter{m_data.insert_or_assign(std::move(name), std::move(value))};
-    return std::any_cast<T &>(iter.first->second);
+    return insert_impl<T>(std::move(name), std::forward<T>(value));
   }
 
   /**
@@ -61,8 +222,7 @@ public:
    * @return A reference to the inserted or updated value.
    */
   template <typename T> T &insert(KeyType const &name, T &&value) {
-    auto iter{m_data.insert_or_assign(name, std::move(value))};
-    return std::any_cast<T &>(iter.first->second);
+    return insert_impl<T>(name, std::forward<T>(value));
   }
 
   /**
@@ -77,8 +237,7 @@ public:
    * @return A reference to the inserted or updated value.
    */
   template <typename T> T &insert(KeyType &&name, T const&value) {
-    auto iter{m_data.insert_or_assign(std::move(name), value)};
-    return std::any_cast<T &>(iter.first->second);
+    return insert_impl<T>(std::move(name), value);
   }
 
   /**
@@ -93,8 +252,73 @@ public:
    * @return A reference to the inserted or updated value.
    */
   template <typename T> T &insert(KeyType const &name, T const&value) {
-    auto iter{m_data.insert_or_assign(name, value)};
-    return std::any_cast<T &>(iter.first->second);
+    return insert_impl<T>(name, value);
+  }
+
+  /**
+   * @brief Inserts or assigns an already type-erased value.
+   *
+   * @param name The key under which the value is stored.
+   * @param value The type-erased value, e.g. taken from another handler.
+   * @return A reference to the stored type-erased value.
+   */
+  TypeErasure &insert_data(KeyType const &name, TypeErasure const &value) {
+    auto [pos, inserted]{m_data.insert_or_assign(name, value)};
+    if (!inserted || !has_stable_references_v<Map>) {
+      ++m_generation;
+    }
+    assigned(pos->first);
+    return pos->second;
+  }
+
+  /**
+   * @brief Registers a value computed on first access and cached.
+   *
+   * The producer is called with the handler the first time the key is read
+   * through get(), data(), find() or resolve(), and its result is cached.
+   * Inserting one of the dependencies, or a value some dependency is
+   * computed from, drops the cache, so the value is recomputed on the next
+   * access. Inserting an explicit value for the key replaces the deferred
+   * one. Values changed through references returned by get() do not
+   * invalidate; insert them instead. Deferred values are not part of
+   * begin(), end() and size(); for_each_deferred() visits them.
+   *
+   * @code
+   * handler.insert_deferred("mu", {"E", "nu"}, [](auto const &h) {
+   *   return h.template get<double>("E") /
+   *          (2.0 * (1.0 + h.template get<double>("nu")));
+   * });
+   * @endcode
+   *
+   * @tparam Producer A callable `T(parameter_handler const &)` small enough
+   * for a deferred_producer; dependencies must not form a cycle.
+   * @param name The key of the value.
+   * @param dependencies The keys the producer reads.
+   * @param producer The callable computing the value.
+   */
+  template <typename Producer>
+  void insert_deferred(KeyType const &name, std::vector<KeyType> dependencies,
+                       Producer &&producer) {
+    deferred_producer function{
+        [producer = std::forward<Producer>(producer)](
+            parameter_handler const &handler) -> TypeErasure {
+          return TypeErasure(producer(handler));
+        }};
+    m_data.erase(name);
+    m_deferred.insert_or_assign(
+        name,
+        deferred_entry{
+            std::make_shared<const deferred_producer>(std::move(function)),
+            std::make_shared<deferred_cache>()});
+    for (auto &dependency : dependencies) {
+      auto &dependents{m_dependents[std::move(dependency)]};
+      if (std::find(dependents.begin(), dependents.end(), name) ==
+          dependents.end()) {
+        dependents.push_back(name);
+      }
+    }
+    ++m_generation;
+    invalidate_dependents(name);
   }
 
   /**
@@ -108,11 +332,8 @@ public:
    * @throws std::invalid_argument if the key is not found.
    */
   template <typename T> const T &get(KeyType &&name) const {
-    auto pos{m_data.find(name)};
-    if (pos == m_data.end()) {
-      throw std::invalid_argument("Key " + name + " not found");
-    }
-    return std::any_cast<const T &>((pos->second));
+    using std::any_cast;
+    return any_cast<const T &>(value_or_throw(*this, name));
   }
 
   /**
@@ -128,11 +349,8 @@ public:
    * @throws std::invalid_argument if the key is not found.
    */
   template <typename T> const T &get(KeyType const &name) const {
-    auto pos{m_data.find(name)};
-    if (pos == m_data.end()) {
-      throw std::invalid_argument("Key " + name + " not found");
-    }
-    return std::any_cast<const T &>((pos->second));
+    using std::any_cast;
+    return any_cast<const T &>(value_or_throw(*this, name));
   }
 
   /**
@@ -146,11 +364,8 @@ public:
    * @throws std::invalid_argument if the key is not found.
    */
   template <typename T> T &get(KeyType &&name) {
-    auto pos{m_data.find(name)};
-    if (pos == m_data.end()) {
-      throw std::invalid_argument("Key " + name + " not found");
-    }
-    return std::any_cast<const T &>((pos->second));
+    using std::any_cast;
+    return any_cast<T &>(value_or_throw(*this, name));
   }
 
   /**
@@ -166,11 +381,35 @@ public:
    * @throws std::invalid_argument if the key is not found.
    */
   template <typename T> T &get(KeyType const &name) {
-    auto pos{m_data.find(name)};
-    if (pos == m_data.end()) {
-      throw std::invalid_argument("Key " + name + " not found");
-    }
-    return std::any_cast<const T &>((pos->second));
+    using std::any_cast;
+    return any_cast<T &>(value_or_throw(*this, name));
+  }
+
+  /**
+   * @brief Resolves a key once into a typed handle for repeated access.
+   *
+   * @tparam T The type of the parameter.
+   * @param name The key of the parameter.
+   * @return A handle to the stored value.
+   * @throws std::invalid_argument if the key is not found.
+   * @throws std::bad_any_cast if the stored value is not of type T.
+   */
+  template <typename T> handle<T> resolve(KeyType const &name) {
+    return handle<T>(*this, get<T>(name));
+  }
+
+  /**
+   * @brief Resolves a key once into a typed handle for repeated read access
+   * (const overload).
+   *
+   * @tparam T The type of the parameter.
+   * @param name The key of the parameter.
+   * @return A handle to the stored value.
+   * @throws std::invalid_argument if the key is not found.
+   * @throws std::bad_any_cast if the stored value is not of type T.
+   */
+  template <typename T> handle<T const> resolve(KeyType const &name) const {
+    return handle<T const>(*this, get<T>(name));
   }
 
   /**
@@ -183,11 +422,7 @@ public:
    * @throws std::invalid_argument if the key is not found.
    */
   const TypeErasure &data(KeyType &&name) const {
-    auto pos{m_data.find(name)};
-    if (pos == m_data.end()) {
-      throw std::invalid_argument("Key " + name + " not found");
-    }
-    return pos->second;
+    return value_or_throw(*this, name);
   }
 
   /**
@@ -202,11 +437,30 @@ public:
    * @throws std::invalid_argument if the key is not found.
    */
   const TypeErasure &data(KeyType const &name) const {
+    return value_or_throw(*this, name);
+  }
+
+  /**
+   * @brief Looks up the type-erased value associated with the specified key.
+   *
+   * @param name The key to look up.
+   * @return A pointer to the stored value, or nullptr if the key is not found.
+   */
+  TypeErasure *find(KeyType const &name) {
     auto pos{m_data.find(name)};
-    if (pos == m_data.end()) {
-      throw std::invalid_argument("Key " + name + " not found");
-    }
-    return pos->second;
+    return pos == m_data.end() ? deferred_value(name) : &pos->second;
+  }
+
+  /**
+   * @brief Looks up the type-erased value associated with the specified key
+   * (const overload).
+   *
+   * @param name The key to look up.
+   * @return A pointer to the stored value, or nullptr if the key is not found.
+   */
+  TypeErasure const *find(KeyType const &name) const {
+    auto pos{m_data.find(name)};
+    return pos == m_data.end() ? deferred_value(name) : &pos->second;
   }
 
   /**
@@ -216,7 +470,7 @@ public:
    * @return True if the key exists; false otherwise.
    */
   auto contains(KeyType &&name) const {
-    return m_data.find(name) != m_data.end();
+    return m_data.find(name) != m_data.end() || is_deferred(name);
   }
 
   /**
@@ -229,7 +483,184 @@ public:
    * @return True if the key exists; false otherwise.
    */
   auto contains(KeyType const &name) const {
-    return m_data.find(name) != m_data.end();
+    return m_data.find(name) != m_data.end() || is_deferred(name);
+  }
+
+  /**
+   * @brief Retrieves a value by a key of a different string-like type.
+   *
+   * Looks the key up without constructing a KeyType, e.g. from a
+   * std::string_view or a string literal.
+   *
+   * @tparam T The type of the value being retrieved.
+   * @tparam K The string-like type of the key.
+   * @param name The key for which the value is to be retrieved.
+   * @return A reference to the value associated with the key.
+   * @throws std::invalid_argument if the key is not found.
+   */
+  template <typename T, typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  T &get(K const &name) {
+    using std::any_cast;
+    return any_cast<T &>(value_or_throw(*this, name));
+  }
+
+  /**
+   * @brief Retrieves a value by a key of a different string-like type (const
+   * overload).
+   *
+   * @tparam T The type of the value being retrieved.
+   * @tparam K The string-like type of the key.
+   * @param name The key for which the value is to be retrieved.
+   * @return A const reference to the value associated with the key.
+   * @throws std::invalid_argument if the key is not found.
+   */
+  template <typename T, typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  const T &get(K const &name) const {
+    using std::any_cast;
+    return any_cast<const T &>(value_or_throw(*this, name));
+  }
+
+  /**
+   * @brief Resolves a key of a different string-like type into a handle.
+   *
+   * @tparam T The type of the parameter.
+   * @tparam K The string-like type of the key.
+   * @param name The key of the parameter.
+   * @return A handle to the stored value.
+   */
+  template <typename T, typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  handle<T> resolve(K const &name) {
+    return handle<T>(*this, get<T>(name));
+  }
+
+  /**
+   * @brief Resolves a key of a different string-like type into a handle
+   * (const overload).
+   *
+   * @tparam T The type of the parameter.
+   * @tparam K The string-like type of the key.
+   * @param name The key of the parameter.
+   * @return A handle to the stored value.
+   */
+  template <typename T, typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  handle<T const> resolve(K const &name) const {
+    return handle<T const>(*this, get<T>(name));
+  }
+
+  /**
+   * @brief Retrieves the type-erased value by a key of a different
+   * string-like type.
+   *
+   * @tparam K The string-like type of the key.
+   * @param name The key for which the value is to be retrieved.
+   * @return A const reference to the type-erased value.
+   * @throws std::invalid_argument if the key is not found.
+   */
+  template <typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  const TypeErasure &data(K const &name) const {
+    return value_or_throw(*this, name);
+  }
+
+  /**
+   * @brief Looks up a key of a different string-like type.
+   *
+   * @tparam K The string-like type of the key.
+   * @param name The key to look up.
+   * @return A pointer to the stored value, or nullptr if the key is not found.
+   */
+  template <typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  TypeErasure *find(K const &name) {
+    auto pos{m_data.find(name)};
+    return pos == m_data.end() ? deferred_value(name) : &pos->second;
+  }
+
+  /**
+   * @brief Looks up a key of a different string-like type (const overload).
+   *
+   * @tparam K The string-like type of the key.
+   * @param name The key to look up.
+   * @return A pointer to the stored value, or nullptr if the key is not found.
+   */
+  template <typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  TypeErasure const *find(K const &name) const {
+    auto pos{m_data.find(name)};
+    return pos == m_data.end() ? deferred_value(name) : &pos->second;
+  }
+
+  /**
+   * @brief Checks if a key of a different string-like type exists.
+   *
+   * @tparam K The string-like type of the key.
+   * @param name The key to check for existence.
+   * @return True if the key exists; false otherwise.
+   */
+  template <typename K>
+    requires is_heterogeneous_key_v<K, KeyType>
+  bool contains(K const &name) const {
+    return m_data.find(name) != m_data.end() || is_deferred(name);
+  }
+
+  /**
+   * @brief Returns an iterator to the first key-value pair.
+   *
+   * The iteration order is the order of the storage policy.
+   */
+  auto begin() const noexcept { return m_data.begin(); }
+
+  /**
+   * @brief Returns an iterator past the last key-value pair.
+   */
+  auto end() const noexcept { return m_data.end(); }
+
+  /**
+   * @brief Returns the number of stored parameters.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_data.size(); }
+
+  /**
+   * @brief Calls a function with the key and value of every deferred value,
+   * computing the values not yet cached.
+   *
+   * Together with begin() and end() this visits every key get() can read.
+   *
+   * @param function Called as
+   * `function(KeyType const &, TypeErasure const &)`.
+   */
+  template <typename Function>
+  void for_each_deferred(Function &&function) const {
+    for (const auto &entry : m_deferred) {
+      function(entry.first, *deferred_value(entry.first));
+    }
+  }
+
+  /**
+   * @brief Returns the allocator of the underlying storage.
+   */
+  allocator_type get_allocator() const noexcept {
+    return m_data.get_allocator();
+  }
+
+  /**
+   * @brief Reserves storage for at least `count` parameters, if the storage
+   * policy supports it.
+   *
+   * Reserving may move stored values, so all outstanding handles are
+   * invalidated.
+   *
+   * @param count The number of parameters.
+   */
+  void reserve(std::size_t count) {
+    if constexpr (requires { m_data.reserve(count); }) {
+      m_data.reserve(count);
+      ++m_generation;
+    }
   }
 
   /**
@@ -240,21 +671,212 @@ public:
   void print(std::ostream &os) {
     for (const auto &[name, type] : m_data) {
       os << name << ": ";
-      os << ::print(type)
-         << "\n"; // Assuming a global print function exists for TypeErasure
+      os << basic_any_print_wrapper<TypeErasure>(type) << "\n";
+    }
+  }
+
+  /**
+   * @brief Prints all key-value pairs through the bulk printing path.
+   *
+   * The layout is that of print(std::ostream &), but numbers are formatted
+   * with std::to_chars in their shortest round-trip representation.
+   *
+   * @param printer The printer to write to.
+   */
+  void print(basic_value_printer<TypeErasure> &printer) const {
+    auto &out{printer.buffer()};
+    for (const auto &[name, value] : m_data) {
+      if constexpr (is_string_key_v<KeyType>) {
+        out.write(std::string_view(name));
+      } else {
+        out.write_number(name);
+      }
+      out.write(": ");
+      printer(value);
+      out.put('\n');
     }
   }
 
   /**
    * @brief Clears all key-value pairs from the parameter handler.
+   *
+   * All outstanding handles are invalidated.
    */
-  void clear() { m_data.clear(); }
+  void clear() {
+    m_data.clear();
+    m_deferred.clear();
+    m_dependents.clear();
+    ++m_generation;
+  }
 
 private:
-  std::unordered_map<KeyType, TypeErasure>
-      m_data; ///< Internal storage for key-value pairs.
+  /**
+   * @brief Cache of a deferred value, shared by copies of the handler until
+   * a dependency changes.
+   */
+  struct deferred_cache {
+    std::once_flag m_once;               ///< Guards the computation.
+    std::optional<TypeErasure> m_value; ///< The computed value.
+  };
+
+  /**
+   * @brief A registered deferred value.
+   */
+  struct deferred_entry {
+    std::shared_ptr<const deferred_producer> m_producer; ///< The producer.
+    std::shared_ptr<deferred_cache> m_cache;             ///< Its result.
+  };
+
+  /**
+   * @brief Returns the value stored or computed for a key or throws.
+   *
+   * @throws std::invalid_argument if the key is not found.
+   */
+  template <typename Self, typename K>
+  static auto value_or_throw(Self &self, K const &name)
+      -> std::conditional_t<std::is_const_v<Self>, TypeErasure const &,
+                            TypeErasure &> {
+    NUMSIM_CORE_INSTRUMENT("parameter_handler::get", name);
+    auto pos{self.m_data.find(name)};
+    if (pos != self.m_data.end()) {
+      return pos->second;
+    }
+    if (auto *value{self.deferred_value(name)}) {
+      return *value;
+    }
+    throw std::invalid_argument("Key " + to_key_string(name) + " not found");
+  }
+
+  /**
+   * @brief Checks whether a deferred value is registered for a key.
+   */
+  template <typename K> bool is_deferred(K const &name) const {
+    return !m_deferred.empty() && m_deferred.find(name) != m_deferred.end();
+  }
+
+  /**
+   * @brief Returns the deferred value of a key, computing it on first use,
+   * or nullptr if none is registered.
+   *
+   * Concurrent readers compute the value once; if the producer throws, the
+   * next access tries again.
+   */
+  template <typename K> TypeErasure *deferred_value(K const &name) const {
+    if (m_deferred.empty()) {
+      return nullptr;
+    }
+    const auto pos{m_deferred.find(name)};
+    if (pos == m_deferred.end()) {
+      return nullptr;
+    }
+    auto &cache{*pos->second.m_cache};
+    std::call_once(cache.m_once, [&] {
+      cache.m_value.emplace((*pos->second.m_producer)(*this));
+    });
+    return &*cache.m_value;
+  }
+
+  /**
+   * @brief Drops a deferred value replaced by an explicit one and the caches
+   * depending on the key.
+   */
+  void assigned(KeyType const &name) {
+    if (m_deferred.empty()) {
+      return;
+    }
+    const auto pos{m_deferred.find(name)};
+    if (pos != m_deferred.end()) {
+      // handles may point into the cache freed with the entry
+      m_deferred.erase(pos);
+      ++m_generation;
+    }
+    invalidate_dependents(name);
+  }
+
+  /**
+   * @brief Gives all deferred values depending directly or transitively on a
+   * key a fresh cache.
+   *
+   * The state of the old cache is never read: it may be shared with copies
+   * of the handler that are computing it concurrently.
+   */
+  void invalidate_dependents(KeyType const &name) {
+    const auto dependents{m_dependents.find(name)};
+    if (dependents == m_dependents.end()) {
+      return;
+    }
+    for (const auto &dependent : dependents->second) {
+      const auto pos{m_deferred.find(dependent)};
+      if (pos == m_deferred.end()) {
+        continue;
+      }
+      pos->second.m_cache = std::make_shared<deferred_cache>();
+      ++m_generation;
+      invalidate_dependents(dependent);
+    }
+  }
+
+  /**
+   * @brief Inserts or assigns a value and invalidates handles if stored values
+   * may have been moved or replaced.
+   */
+  template <typename T, typename Key, typename Value>
+  T &insert_impl(Key &&name, Value &&value) {
+    auto [pos, inserted]{m_data.insert_or_assign(std::forward<Key>(name),
+                                                 std::forward<Value>(value))};
+    if (!inserted || !has_stable_references_v<Map>) {
+      ++m_generation;
+    }
+    assigned(pos->first);
+    using std::any_cast;
+    return any_cast<T &>(pos->second);
+  }
+
+  map_type m_data; ///< Internal storage for key-value pairs.
+  transparent_map_t<std::unordered_map, KeyType, deferred_entry>
+      m_deferred; ///< Registered deferred values.
+  transparent_map_t<std::unordered_map, KeyType, std::vector<KeyType>>
+      m_dependents; ///< Deferred values depending on a key.
+  std::size_t m_generation{0}; ///< Bumped whenever handles are invalidated.
 };
 
+/**
+ * @brief A parameter handler backed by the open-addressing flat_hash_map.
+ *
+ * @tparam KeyType Type of the keys used for storing parameters.
+ * @tparam TypeErasure Type used for the values stored in the handler.
+ */
+template <typename KeyType = std::string, typename TypeErasure = std::any>
+using flat_parameter_handler =
+    parameter_handler<KeyType, TypeErasure, flat_hash_map>;
+
+namespace pmr {
+/**
+ * @brief A parameter handler with std::pmr::string keys stored in a
+ * std::pmr::unordered_map.
+ *
+ * @note Values stored in std::any that exceed its small buffer are still
+ * allocated with the global heap; use small_any to keep them inline.
+ *
+ * @tparam TypeErasure Type used for the values stored in the handler.
+ */
+template <typename TypeErasure = std::any>
+using parameter_handler =
+    numsim_core::parameter_handler<std::pmr::string, TypeErasure,
+                                   std::pmr::unordered_map>;
+
+/**
+ * @brief A parameter handler with std::pmr::string keys stored in a
+ * pmr::flat_hash_map.
+ *
+ * @tparam TypeErasure Type used for the values stored in the handler.
+ */
+template <typename TypeErasure = std::any>
+using flat_parameter_handler =
+    numsim_core::parameter_handler<std::pmr::string, TypeErasure,
+                                   pmr::flat_hash_map>;
+} // namespace pmr
+
 //#include <gtest/gtest.h>
 //#include <any>
 //#include <string>
@@ -1,17 +1,141 @@
 #ifndef QUERY_MAP_H
 #define QUERY_MAP_H
 
+#include "instrumentation.h"
+#include "numsim_core_utility.h"
+#include "parallel.h"
 #include <type_traits>
 #include <any>
+#include <cstdint>
 #include <functional>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace numsim_core {
 
+namespace detail {
+/**
+ * @brief A stored value together with the version of its last change.
+ *
+ * @tparam TypeErasure The type used for type erasure.
+ */
+template <typename TypeErasure> struct query_slot {
+  TypeErasure m_value{};       ///< The stored value.
+  std::uint64_t m_version{0}; ///< Stamp of the last change.
+};
+
+/**
+ * @brief A deferred query with its key tuple and cached resolution.
+ *
+ * @tparam Function The type of the query function.
+ * @tparam Tuple The type of the key tuple.
+ * @tparam TypeErasure The type used for type erasure.
+ */
+template <typename Function, typename Tuple, typename TypeErasure>
+struct query_entry {
+  Function m_func;                             ///< The query function.
+  Tuple m_keys;                                ///< The keys of the target.
+  query_slot<TypeErasure> *m_slot{nullptr};    ///< The resolved target.
+  std::uint64_t m_generation{0}; ///< Map generation of the resolution.
+  std::uint64_t m_seen{0};       ///< Target version of the last run.
+};
+
+/**
+ * @brief Runs a resolved query if its target changed since its last run.
+ *
+ * @param entry The query.
+ */
+template <typename Entry> void run_query(Entry &entry) {
+  auto &slot{*entry.m_slot};
+  if (entry.m_seen != slot.m_version) {
+    entry.m_func(slot.m_value);
+    entry.m_seen = slot.m_version;
+  }
+}
+
+/**
+ * @brief Partition of resolved queries into groups sharing a target slot.
+ *
+ * Queries of one group conflict and run one after another in the order they
+ * were added; different groups touch different values and run concurrently.
+ */
+class query_schedule {
+public:
+  /**
+   * @brief Checks whether the partition matches the queries.
+   *
+   * @param queries The number of queries.
+   * @param generation The map generation the queries are resolved against.
+   */
+  [[nodiscard]] bool is_current(std::size_t queries,
+                                std::uint64_t generation) const noexcept {
+    return m_valid && m_queries == queries && m_generation == generation;
+  }
+
+  /**
+   * @brief Groups the resolved queries by their target slot.
+   *
+   * @param entries The resolved queries.
+   * @param generation The map generation the queries are resolved against.
+   */
+  template <typename Entries>
+  void build(Entries const &entries, std::uint64_t generation) {
+    std::unordered_map<void const *, std::size_t> group_of;
+    std::vector<std::size_t> group(entries.size());
+    std::vector<std::size_t> sizes;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      auto [pos, inserted]{
+          group_of.try_emplace(entries[i].m_slot, sizes.size())};
+      if (inserted) {
+        sizes.push_back(0);
+      }
+      group[i] = pos->second;
+      ++sizes[group[i]];
+    }
+    m_offsets.assign(sizes.size() + 1, 0);
+    for (std::size_t g = 0; g < sizes.size(); ++g) {
+      m_offsets[g + 1] = m_offsets[g] + sizes[g];
+    }
+    std::vector<std::size_t> next(m_offsets.begin(), m_offsets.end() - 1);
+    m_order.resize(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      m_order[next[group[i]]++] = i;
+    }
+    m_queries = entries.size();
+    m_generation = generation;
+    m_valid = true;
+  }
+
+  /**
+   * @brief Runs the changed queries, one task per group.
+   *
+   * @param entries The resolved queries.
+   * @param executor The executor running the groups.
+   */
+  template <typename Entries, typename Executor>
+  void run(Entries &entries, Executor &&executor) const {
+    executor(m_offsets.size() - 1, [&](std::size_t g) {
+      for (auto i{m_offsets[g]}; i < m_offsets[g + 1]; ++i) {
+        run_query(entries[m_order[i]]);
+      }
+    });
+  }
+
+private:
+  std::vector<std::size_t> m_order;      ///< Query indices grouped by slot.
+  std::vector<std::size_t> m_offsets{0}; ///< Start of every group.
+  std::size_t m_queries{0};              ///< Number of partitioned queries.
+  std::uint64_t m_generation{0};         ///< Map generation of the partition.
+  bool m_valid{false};                   ///< Whether a partition was built.
+};
+} // namespace detail
+
 /**
  * @brief A template class that maps a list of keys to values, allowing for
  * flexible querying and type erasure.
@@ -21,9 +145,15 @@ namespace numsim_core {
  * provided as a tuple, and the values can be retrieved or set using a
  * type-erased approach. The class supports querying with custom functions.
  *
+ * Deferred queries are resolved to their target value once and re-run by
+ * final_queries() only if the value changed since their last run. A value
+ * counts as changed when it is stored with `set` or accessed through the
+ * non-const `get`.
+ *
  * @tparam List The tuple type representing the keys.
  * @tparam Map A template class for the map implementation (e.g.,
- * std::unordered_map).
+ * std::unordered_map). String-like keys are stored with transparent lookup,
+ * so `get` with std::string_view or string literals does not allocate.
  * @tparam TypeErasure The type used for type erasure, defaulting to std::any.
  */
 template <typename List, template <class... ArgsMap> class Map,
@@ -50,9 +180,10 @@ private:
   struct query_map_data<_List<_First, _Keys...>> {
     using tuple_type = std::tuple<_First, _Keys...>; ///< The type representing
                                                      ///< the keys as a tuple.
-    using map_type =
-        Map<_First, typename query_map_data<std::tuple<_Keys...>>::
-                        map_type>; ///< The map type for key-value pairs.
+    using map_type = transparent_map_t<
+        Map, _First,
+        typename query_map_data<std::tuple<_Keys...>>::
+            map_type>; ///< The map type for key-value pairs.
   };
 
   /**
@@ -65,8 +196,12 @@ private:
   struct query_map_data<_List<_First>> {
     using tuple_type =
         std::tuple<_First>; ///< The type representing the key as a tuple.
-    using map_type = Map<_First, TypeErasure>; ///< The map type for key-value
-                                               ///< pairs with type erasure.
+    using map_type =
+        transparent_map_t<Map, _First,
+                          detail::query_slot<TypeErasure>>; ///< The map type
+                                                            ///< for key-value
+                                                            ///< pairs with
+                                                            ///< type erasure.
   };
 
 public:
@@ -88,8 +223,11 @@ public:
   /**
    * @brief The signature for query functions, which take a reference to
    * type-erased data.
+   *
+   * Query functions are stored in place, so registering queries does not
+   * allocate per callable.
    */
-  using query_fun_sig = std::function<void(type_erasure_type &)>;
+  using query_fun_sig = inplace_function<void(type_erasure_type &)>;
 
   /**
    * @brief Retrieves the key type at the specified index.
@@ -105,11 +243,26 @@ public:
   using index_sequence =
       std::make_index_sequence<std::tuple_size_v<tuple_type>>;
 
+  /**
+   * @brief The allocator type of the outermost map.
+   */
+  using allocator_type = typename map_type::allocator_type;
+
   /**
    * @brief Default constructor for query_map.
    */
   query_map() {}
 
+  /**
+   * @brief Constructs a query_map whose maps use the given allocator.
+   *
+   * With scoped allocators such as std::pmr::polymorphic_allocator, the nested
+   * maps and allocator-aware keys propagate the allocator automatically.
+   *
+   * @param alloc The allocator of the outermost map.
+   */
+  explicit query_map(allocator_type const &alloc) : m_data(alloc) {}
+
   /**
    * @brief Sets a value in the map with the specified keys.
    *
@@ -130,15 +283,18 @@ public:
    * @brief Retrieves a value from the map using the specified keys.
    *
    * This overload is non-const and allows for modifications to the retrieved
-   * value.
+   * value, so the value is marked as changed.
    *
    * @tparam Keys The types of the keys used to access the map.
    * @param keys The keys used to retrieve the value.
    * @return A reference to the retrieved value.
    */
   template <typename... Keys> auto &get(Keys &&...keys) {
-    return get_list_first(std::make_tuple(std::forward<Keys>(keys)...),
-                          index_sequence{});
+    NUMSIM_CORE_INSTRUMENT("query_map::get", std::forward_as_tuple(keys...));
+    auto &slot{get_list_first(std::forward_as_tuple(std::as_const(keys)...),
+                              index_sequence{})};
+    slot.m_version = ++m_clock;
+    return slot.m_value;
   }
 
   /**
@@ -152,21 +308,90 @@ public:
    * @param keys The keys to associate with the query.
    */
   template <typename... Keys> void query(query_fun_sig &&func, Keys &&...keys) {
-    m_queries.emplace_back(
-        std::make_pair(std::forward<query_fun_sig>(func),
-                       std::make_tuple(std::forward<Keys>(keys)...)));
+    m_queries.push_back(
+        {std::forward<query_fun_sig>(func),
+         tuple_type(std::forward<Keys>(keys)...)});
   }
 
   /**
-   * @brief Executes all stored query functions using the current map data.
+   * @brief Executes the stored query functions whose value changed.
+   *
+   * Every query runs on its first call and afterwards only if its value was
+   * changed since its last run. Queries run in the order they were added.
+   *
+   * @throws std::invalid_argument if the keys of a query are not found.
    */
   void final_queries() {
-    for (auto &[func, id] : m_queries) {
-      func(get_list_first(id, index_sequence{}));
+    for (auto &entry : m_queries) {
+      NUMSIM_CORE_INSTRUMENT("query_map::final_queries", entry.m_keys);
+      resolve(entry);
+      detail::run_query(entry);
+    }
+  }
+
+  /**
+   * @brief Executes the stored query functions whose value changed in
+   * parallel.
+   *
+   * Queries targeting the same value form a group and run one after another
+   * in the order they were added; different groups run concurrently on the
+   * executor. Query functions of different groups must therefore not share
+   * unsynchronized state.
+   *
+   * @tparam Executor The executor type, see parallel_executor.
+   * @param executor The executor running the groups.
+   * @throws std::invalid_argument if the keys of a query are not found.
+   */
+  template <typename Executor> void final_queries(Executor &&executor) {
+    NUMSIM_CORE_INSTRUMENT("query_map::final_queries",
+                           std::string_view("(parallel)"));
+    for (auto &entry : m_queries) {
+      resolve(entry);
+    }
+    if (!m_schedule.is_current(m_queries.size(), m_generation)) {
+      m_schedule.build(m_queries, m_generation);
+    }
+    m_schedule.run(m_queries, std::forward<Executor>(executor));
+  }
+
+  /**
+   * @brief Marks all queries to run on the next call of final_queries().
+   */
+  void invalidate_queries() noexcept {
+    for (auto &entry : m_queries) {
+      entry.m_seen = 0;
     }
   }
 
+  /**
+   * @brief Calls a function for every stored value.
+   *
+   * @tparam Function The function type.
+   * @param func Called as `func(value, keys...)`, in the order of the maps.
+   */
+  template <typename Function> void for_each(Function &&func) const {
+    for_each_imp(m_data, func);
+  }
+
 private:
+  /**
+   * @brief Recursive helper of for_each() walking one map level.
+   *
+   * @param map The current map being processed.
+   * @param func The function to call.
+   * @param keys The keys of the enclosing levels.
+   */
+  template <typename MapPart, typename Function, typename... Keys>
+  static void for_each_imp(MapPart const &map, Function &func,
+                           Keys const &...keys) {
+    for (const auto &[key, value] : map) {
+      if constexpr (sizeof...(Keys) + 1 == std::tuple_size_v<tuple_type>) {
+        func(value.m_value, keys..., key);
+      } else {
+        for_each_imp(value, func, keys..., key);
+      }
+    }
+  }
 
   /**
    * @brief Retrieves a value from the map using the specified keys.
@@ -179,8 +404,25 @@ private:
    * @return A const reference to the retrieved value.
    */
   template <typename... Keys> auto const &get(Keys &&...keys) const {
-    return get_list_first(std::make_tuple(std::forward<Keys>(keys)...),
-                          index_sequence{});
+    NUMSIM_CORE_INSTRUMENT("query_map::get", std::forward_as_tuple(keys...));
+    return get_list_first(std::forward_as_tuple(std::as_const(keys)...),
+                          index_sequence{})
+        .m_value;
+  }
+
+  /**
+   * @brief Returns the target slot of a query, resolving it if the map
+   * structure changed since the last resolution.
+   *
+   * @param entry The query.
+   * @return The target slot.
+   */
+  template <typename Entry> auto &resolve(Entry &entry) {
+    if (entry.m_slot == nullptr || entry.m_generation != m_generation) {
+      entry.m_slot = &get_list_first(entry.m_keys, index_sequence{});
+      entry.m_generation = m_generation;
+    }
+    return *entry.m_slot;
   }
 
   /**
@@ -198,49 +440,34 @@ private:
   template <typename _List, std::size_t First, std::size_t... Seq>
   auto &get_list_first(_List const &key_list,
                        std::index_sequence<First, Seq...>) {
-    const auto &key{std::get<First>(key_list)};
-    if (m_data.find(key) == m_data.end()) {
-      const auto str{[&key]() {
-        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(key)>,
-                                      std::string>) {
-          return key;
-        } else {
-          return std::to_string(key);
-        }
-      }};
-      throw std::invalid_argument(std::string("key ") + str() + std::string(" not found"));
-    }
-    return get_list_impl(m_data[key], key_list, std::index_sequence<Seq...>{});
+    return get_list_impl(m_data, key_list,
+                         std::index_sequence<First, Seq...>{});
   }
 
   /**
-   * @brief Retrieves a value from the map using the provided keys and the last
-   * index.
+   * @brief Retrieves a value from the map, resolving one key per level.
+   *
+   * Every level is resolved with a single lookup.
    *
    * @tparam DataMap The type of the data map.
    * @tparam _List The list type of keys.
-   * @tparam Last The last index of keys.
+   * @tparam Next The index of the key of the current level.
+   * @tparam Seq The indices of the remaining keys.
    * @param map The data map to retrieve values from.
    * @param key_list The list of keys.
    * @return A reference to the retrieved value.
    * @throws std::invalid_argument if the key is not found in the map.
    */
-  template <typename DataMap, typename _List, std::size_t Last>
+  template <typename DataMap, typename _List, std::size_t Next,
+            std::size_t... Seq>
   auto &get_list_impl(DataMap &map, _List const &key_list,
-                      std::index_sequence<Last>) {
-    const auto &key{std::get<Last>(key_list)};
-    if (map.find(key) == map.end()) {
-      const auto str{[&key]() {
-        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(key)>,
-                                      std::string>) {
-          return key;
-        } else {
-          return std::to_string(key);
-        }
-      }};
-      throw std::invalid_argument(std::string("key ") + str() + std::string(" not found"));
+                      std::index_sequence<Next, Seq...>) {
+    const auto &key{std::get<Next>(key_list)};
+    auto pos{map.find(key)};
+    if (pos == map.end()) {
+      throw std::invalid_argument("key " + to_key_string(key) + " not found");
     }
-    return map[key];
+    return get_list_impl(pos->second, key_list, std::index_sequence<Seq...>{});
   }
 
   /**
@@ -276,7 +503,9 @@ private:
             typename... Keys>
   void set_imp(MapPart &map, Data &&data, First &&first,
                Keys &&...keys) {
-    set_imp(map[first], std::forward<Data>(data), keys...);
+    auto [pos, inserted]{map.try_emplace(std::forward<First>(first))};
+    m_generation += inserted;
+    set_imp(pos->second, std::forward<Data>(data), keys...);
   }
 
   /**
@@ -291,12 +520,304 @@ private:
    */
   template <typename MapPart, typename Data, typename Last>
   void set_imp(MapPart &map, Data &&data, Last &&last) {
-    map[last] = std::forward<Data>(data);
+    auto [pos, inserted]{map.try_emplace(std::forward<Last>(last))};
+    m_generation += inserted;
+    pos->second.m_value = std::forward<Data>(data);
+    pos->second.m_version = ++m_clock;
   }
 
   map_type m_data{}; ///< The internal map that holds the key-value pairs.
-  std::vector<std::pair<query_fun_sig, tuple_type>>
+  std::vector<detail::query_entry<query_fun_sig, tuple_type, TypeErasure>>
+      m_queries{}; ///< A collection of queries to be executed later.
+  std::uint64_t m_clock{0};      ///< Stamp of the latest change.
+  std::uint64_t m_generation{0}; ///< Counts insertions into the maps.
+  detail::query_schedule m_schedule{}; ///< Groups for parallel queries.
+};
+
+/**
+ * @brief A query_map storing all values in one hash table keyed by the
+ * complete key tuple.
+ *
+ * flat_query_map offers the `set`/`get`/`query`/`final_queries` interface of
+ * query_map, but instead of one nested map per key level it keeps a single
+ * `Map<tuple_type, TypeErasure>` with a combined tuple_hash. A lookup
+ * therefore costs one hash computation and one probe, independent of the
+ * number of keys, and is performed on a tuple of references to the arguments
+ * without copying them. The nested structure is only available as a view,
+ * see nested_view().
+ *
+ * @tparam List The tuple type representing the keys.
+ * @tparam Map A template class for the map implementation (e.g.,
+ * std::unordered_map), taking key, value, hash and key equality.
+ * @tparam TypeErasure The type used for type erasure, defaulting to std::any.
+ */
+template <typename List, template <class... ArgsMap> class Map,
+          typename TypeErasure = std::any>
+class flat_query_map {
+public:
+  /**
+   * @brief The type of the nested query_map with the same keys.
+   */
+  using nested_type = query_map<List, Map, TypeErasure>;
+
+  /**
+   * @brief The type of the tuple representing the keys.
+   */
+  using tuple_type = typename nested_type::tuple_type;
+
+  /**
+   * @brief The type of the map used to store values.
+   */
+  using map_type = Map<tuple_type, detail::query_slot<TypeErasure>,
+                       tuple_hash<tuple_type>, tuple_equal>;
+
+  /**
+   * @brief The type used for type erasure.
+   */
+  using type_erasure_type = TypeErasure;
+
+  /**
+   * @brief The signature for query functions, which take a reference to
+   * type-erased data.
+   *
+   * Query functions are stored in place, so registering queries does not
+   * allocate per callable.
+   */
+  using query_fun_sig = inplace_function<void(type_erasure_type &)>;
+
+  /**
+   * @brief The allocator type of the map.
+   */
+  using allocator_type = typename map_type::allocator_type;
+
+  /**
+   * @brief The type of the nested view returned by nested_view().
+   */
+  using nested_view_type = query_map<List, Map, TypeErasure *>;
+
+  /**
+   * @brief Default constructor for flat_query_map.
+   */
+  flat_query_map() {}
+
+  /**
+   * @brief Constructs a flat_query_map whose map uses the given allocator.
+   *
+   * @param alloc The allocator of the map.
+   */
+  explicit flat_query_map(allocator_type const &alloc) : m_data(alloc) {}
+
+  /**
+   * @brief Sets a value in the map with the specified keys.
+   *
+   * @tparam T The type of the data to be stored.
+   * @tparam Keys The types of the keys used to access the map.
+   * @param data The data to be stored.
+   * @param keys The keys to associate with the value.
+   */
+  template <typename T, typename... Keys>
+  void set(T &&data, Keys &&...keys) {
+    check_key_count<Keys...>();
+    auto pos{m_data.find(std::forward_as_tuple(std::as_const(keys)...))};
+    if (pos == m_data.end()) {
+      pos = m_data.try_emplace(tuple_type(std::forward<Keys>(keys)...)).first;
+      ++m_generation;
+    }
+    pos->second.m_value = std::forward<T>(data);
+    pos->second.m_version = ++m_clock;
+  }
+
+  /**
+   * @brief Retrieves a value from the map using the specified keys.
+   *
+   * The value is marked as changed.
+   *
+   * @tparam Keys The types of the keys used to access the map.
+   * @param keys The keys used to retrieve the value.
+   * @return A reference to the retrieved value.
+   * @throws std::invalid_argument if the key combination is not found.
+   */
+  template <typename... Keys> auto &get(Keys const &...keys) {
+    check_key_count<Keys...>();
+    NUMSIM_CORE_INSTRUMENT("flat_query_map::get",
+                           std::forward_as_tuple(keys...));
+    auto &slot{get_impl(m_data, std::forward_as_tuple(keys...))};
+    slot.m_version = ++m_clock;
+    return slot.m_value;
+  }
+
+  /**
+   * @brief Retrieves a value from the map using the specified keys (const
+   * overload).
+   *
+   * @tparam Keys The types of the keys used to access the map.
+   * @param keys The keys used to retrieve the value.
+   * @return A const reference to the retrieved value.
+   * @throws std::invalid_argument if the key combination is not found.
+   */
+  template <typename... Keys> auto const &get(Keys const &...keys) const {
+    check_key_count<Keys...>();
+    NUMSIM_CORE_INSTRUMENT("flat_query_map::get",
+                           std::forward_as_tuple(keys...));
+    return get_impl(m_data, std::forward_as_tuple(keys...)).m_value;
+  }
+
+  /**
+   * @brief Checks if a value is stored for the key combination.
+   *
+   * @tparam Keys The types of the keys.
+   * @param keys The keys to look up.
+   * @return True if the key combination exists; false otherwise.
+   */
+  template <typename... Keys> bool contains(Keys const &...keys) const {
+    check_key_count<Keys...>();
+    return m_data.find(std::forward_as_tuple(keys...)) != m_data.end();
+  }
+
+  /**
+   * @brief Adds a query function to be executed later.
+   *
+   * @tparam Keys The types of the keys associated with the query.
+   * @param func The function to execute during the query.
+   * @param keys The keys to associate with the query.
+   */
+  template <typename... Keys> void query(query_fun_sig &&func, Keys &&...keys) {
+    check_key_count<Keys...>();
+    m_queries.push_back({std::forward<query_fun_sig>(func),
+                         tuple_type(std::forward<Keys>(keys)...)});
+  }
+
+  /**
+   * @brief Executes the stored query functions whose value changed, see
+   * query_map::final_queries().
+   *
+   * @throws std::invalid_argument if the keys of a query are not found.
+   */
+  void final_queries() {
+    for (auto &entry : m_queries) {
+      NUMSIM_CORE_INSTRUMENT("query_map::final_queries", entry.m_keys);
+      resolve(entry);
+      detail::run_query(entry);
+    }
+  }
+
+  /**
+   * @brief Executes the stored query functions whose value changed in
+   * parallel.
+   *
+   * Queries targeting the same value form a group and run one after another
+   * in the order they were added; different groups run concurrently on the
+   * executor. Query functions of different groups must therefore not share
+   * unsynchronized state.
+   *
+   * @tparam Executor The executor type, see parallel_executor.
+   * @param executor The executor running the groups.
+   * @throws std::invalid_argument if the keys of a query are not found.
+   */
+  template <typename Executor> void final_queries(Executor &&executor) {
+    NUMSIM_CORE_INSTRUMENT("query_map::final_queries",
+                           std::string_view("(parallel)"));
+    for (auto &entry : m_queries) {
+      resolve(entry);
+    }
+    if (!m_schedule.is_current(m_queries.size(), m_generation)) {
+      m_schedule.build(m_queries, m_generation);
+    }
+    m_schedule.run(m_queries, std::forward<Executor>(executor));
+  }
+
+  /**
+   * @brief Marks all queries to run on the next call of final_queries().
+   */
+  void invalidate_queries() noexcept {
+    for (auto &entry : m_queries) {
+      entry.m_seen = 0;
+    }
+  }
+
+  /**
+   * @brief Calls a function for every stored value.
+   *
+   * @tparam Function The function type.
+   * @param func Called as `func(value, keys...)`, in the order of the map.
+   */
+  template <typename Function> void for_each(Function &&func) const {
+    for (const auto &[keys, slot] : m_data) {
+      std::apply([&](auto const &...key) { func(slot.m_value, key...); },
+                 keys);
+    }
+  }
+
+  /**
+   * @brief Returns the number of stored values.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_data.size(); }
+
+  /**
+   * @brief Builds the nested representation of the stored keys.
+   *
+   * The view is a query_map whose leaves point into this map. It stays valid
+   * as long as no value is added to or removed from this map.
+   *
+   * @return The nested view.
+   */
+  nested_view_type nested_view() {
+    nested_view_type view;
+    for (auto &[keys, slot] : m_data) {
+      std::apply([&](auto const &...key) { view.set(&slot.m_value, key...); },
+                 keys);
+    }
+    return view;
+  }
+
+private:
+  /**
+   * @brief Checks at compile time that a complete key list is provided.
+   */
+  template <typename... Keys> static constexpr void check_key_count() {
+    static_assert(sizeof...(Keys) == std::tuple_size_v<tuple_type>,
+                  "flat_query_map requires one argument per key");
+  }
+
+  /**
+   * @brief Looks up the key tuple with a single probe.
+   *
+   * @param data The map to search.
+   * @param keys The key tuple.
+   * @return A reference to the stored value.
+   * @throws std::invalid_argument if the key combination is not found.
+   */
+  template <typename Data, typename Keys>
+  static auto &get_impl(Data &data, Keys const &keys) {
+    auto pos{data.find(keys)};
+    if (pos == data.end()) {
+      throw std::invalid_argument("key " + to_key_string_tuple(keys) +
+                                  " not found");
+    }
+    return pos->second;
+  }
+
+  /**
+   * @brief Returns the target slot of a query, resolving it if the map
+   * structure changed since the last resolution.
+   *
+   * @param entry The query.
+   * @return The target slot.
+   */
+  template <typename Entry> auto &resolve(Entry &entry) {
+    if (entry.m_slot == nullptr || entry.m_generation != m_generation) {
+      entry.m_slot = &get_impl(m_data, entry.m_keys);
+      entry.m_generation = m_generation;
+    }
+    return *entry.m_slot;
+  }
+
+  map_type m_data{}; ///< The flat map that holds the key-value pairs.
+  std::vector<detail::query_entry<query_fun_sig, tuple_type, TypeErasure>>
       m_queries{}; ///< A collection of queries to be executed later.
+  std::uint64_t m_clock{0};      ///< Stamp of the latest change.
+  std::uint64_t m_generation{0}; ///< Counts insertions into the map.
+  detail::query_schedule m_schedule{}; ///< Groups for parallel queries.
 };
 
 /**
@@ -306,6 +827,30 @@ private:
 using double_query_map =
     query_map<std::tuple<std::string, std::string>, std::unordered_map>;
 
+/**
+ * @brief double_query_map with flat storage keyed by the (model, field) pair.
+ */
+using flat_double_query_map =
+    flat_query_map<std::tuple<std::string, std::string>, std::unordered_map>;
+
+namespace pmr {
+/**
+ * @brief double_query_map with std::pmr::string keys and
+ * std::pmr::unordered_map storage.
+ */
+using double_query_map =
+    query_map<std::tuple<std::pmr::string, std::pmr::string>,
+              std::pmr::unordered_map>;
+
+/**
+ * @brief flat_double_query_map with std::pmr::string keys and
+ * std::pmr::unordered_map storage.
+ */
+using flat_double_query_map =
+    flat_query_map<std::tuple<std::pmr::string, std::pmr::string>,
+                   std::pmr::unordered_map>;
+} // namespace pmr
+
 
 
 //#include <gtest/gtest.h>
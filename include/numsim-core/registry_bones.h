@@ -1,11 +1,20 @@
 #ifndef REGISTRY_BONES_H
 #define REGISTRY_BONES_H
 
+#include "instrumentation.h"
+#include "numsim_core_utility.h"
+#include "object_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <map>
 #include <stdexcept>
-#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
 namespace numsim_core {
@@ -14,11 +23,26 @@ namespace numsim_core {
 #define combineNames(X, Y) combineNamesImpl(X, Y)
 
 
+//records a registration descriptor, the entry is created on first access
 #define RegisterObject(Registry, Name, ObjectType) \
-    static auto _##Registry##_##Name = Registry::add_object<ObjectType>(#Name);
+    static Registry::registration _##Registry##_##Name{#Name, std::type_identity<ObjectType>{}};
     //static auto combineNames(_##Registry##_##Name_, __COUNTER__) = Registry::add_object<ObjectType>(#Name);
 
 
+namespace detail {
+//build function stored in an entry: entries with a construction policy decide
+//where objects live, otherwise objects are allocated with new. Args are
+//deduced from Entry::build_ptr, reference parameters are forwarded
+template<typename Entry, typename Derived, typename ...Args>
+typename Entry::pointer build_object(Args... args){
+    if constexpr (requires { Entry::template construct<Derived>(std::forward<Args>(args)...); }){
+        return Entry::template construct<Derived>(std::forward<Args>(args)...);
+    }else{
+        return typename Entry::pointer(new Derived(std::forward<Args>(args)...));
+    }
+}
+}
+
 template<template<class...> class Map,
          typename Key,
          typename Entry>
@@ -33,6 +57,68 @@ public:
     using entry_type = Entry;
     //Pointer<BaseType>(*)(Args...);
 
+    /**
+     * @brief A name resolved to its entry, building objects without map access.
+     */
+    class builder
+    {
+    public:
+        builder() = default;
+
+        explicit builder(entry_type& entry):m_entry(&entry){}
+
+        template<typename ...Args>
+        pointer operator()(Args&&... args) const {
+            return m_entry->build(std::forward<Args>(args)...);
+        }
+
+        entry_type const& entity() const {
+            return *m_entry;
+        }
+
+        explicit operator bool() const {
+            return m_entry != nullptr;
+        }
+
+    private:
+        entry_type* m_entry{nullptr};
+    };
+
+    /**
+     * @brief A registration recorded during static initialization.
+     *
+     * RegisterObject defines one per name. Constructing it stores the name
+     * and a setup function pointer and links it into a list of pending
+     * registrations, without allocating. The entries are created on the
+     * first access to the registry, in registration order.
+     *
+     * Linking is synchronized with the first access, but a registration
+     * linked while other threads build from the unfrozen registry is not,
+     * just like add_object.
+     */
+    class registration
+    {
+    public:
+        template<typename T>
+        registration(char const* name, std::type_identity<T>) noexcept
+            :m_name(name), m_setup(&setup_entry<T>){
+            const std::lock_guard<std::mutex> lock(m_pending_mutex);
+            m_next = m_pending.load(std::memory_order_relaxed);
+            m_pending.store(this, std::memory_order_release);
+        }
+
+        registration(registration const &) = delete;
+
+        registration & operator=(registration const &) = delete;
+
+    private:
+        friend class registry;
+
+        char const* m_name;
+        void(*m_setup)(entry_type&, key_type const&);
+        registration* m_next{nullptr};
+    };
+
     registry(registry const &) = delete;
 
     registry(registry &&) = delete;
@@ -41,18 +127,26 @@ public:
 
     registry & operator=(registry const &) = delete;
 
+    /**
+     * @brief Returns the registry, creating the entries of pending
+     * registrations first.
+     *
+     * Concurrent first accesses create the entries once. Registrations
+     * linked after freeze(), e.g. by a library loaded later, are not added.
+     */
     static registry & get(){
         static registry rig;
+        if(m_pending.load(std::memory_order_acquire) != nullptr &&
+           !rig.m_frozen.load(std::memory_order_acquire)){
+            rig.add_pending();
+        }
         return rig;
     }
 
     template<typename T>
     static constexpr inline char add_object(key_type const& name){
-        auto entry = std::make_unique<Entry>();
-        entry->template setup<T>(name, &build_func<T>);
-//        entry.m_build_ptr = &build_func<T>;
-//        entry.m_name = name;
-        get().m_entries[name] = std::move(entry);
+        throw_if_frozen("add_object");
+        get().set_entry(name, &setup_entry<T>);
         return '0';
     }
 
@@ -64,38 +158,262 @@ public:
         return m_entries.end();
     }
 
-    static constexpr inline entry_type const& entity(key_type const& name){
-        auto pos{get().m_entries.find(name)};
+    template<typename K>
+    static constexpr inline entry_type const& entity(K const& name){
+        return find_or_throw(name);
+    }
+
+    template<typename K, typename ...Args>
+    static constexpr inline auto build(K const& name, Args&&... args){
+        NUMSIM_CORE_INSTRUMENT("registry::build", name);
+        return find_or_throw(name).build(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Resolves a name once into a builder.
+     *
+     * The builder keeps a pointer to the entry, so building through it does
+     * not access the map. Registering the name again sets up the same entry
+     * in place, so the builder then builds the new type; erasing the name
+     * invalidates it.
+     */
+    template<typename K>
+    static inline auto resolve(K const& name){
+        return builder(find_or_throw(name));
+    }
+
+    /**
+     * @brief Converts the registry into an immutable sorted array.
+     *
+     * Call once after static registration, before building from several
+     * threads. Afterwards build, entity and resolve perform a binary search
+     * over contiguous storage and may be called concurrently without locks,
+     * while add_object and erase throw std::logic_error.
+     */
+    static inline void freeze(){
+        auto& rig{get()};
+        if(rig.m_frozen.load(std::memory_order_relaxed)){
+            return;
+        }
+        rig.m_sorted.clear();
+        rig.m_sorted.reserve(rig.m_entries.size());
+        for(auto& [name, entry] : rig.m_entries){
+            rig.m_sorted.emplace_back(name, entry.get());
+        }
+        std::sort(rig.m_sorted.begin(), rig.m_sorted.end(), [](auto const& lhs, auto const& rhs){
+            return std::less<>{}(lhs.first, rhs.first);
+        });
+        rig.m_frozen.store(true, std::memory_order_release);
+    }
+
+    static inline bool is_frozen(){
+        return get().m_frozen.load(std::memory_order_acquire);
+    }
+
+    template<typename K>
+    static constexpr inline auto erase(K const& name){
+        throw_if_frozen("erase");
+        auto pos{find_entry(name)};
+        if(pos != get().m_entries.end()){
+            get().m_entries.erase(pos);
+        }
+    }
+
+private:
+
+    template<typename T>
+    static void setup_entry(entry_type& entry, key_type const& name){
+        entry.template setup<T>(name, &detail::build_object<Entry, T>);
+    }
+
+    //the list is linked newest first: reverse it so that later
+    //registrations of a name replace earlier ones. The list is cleared
+    //only after all entries were added, so a thread seeing no pending
+    //registrations also sees the entries
+    void add_pending(){
+        const std::lock_guard<std::mutex> lock(m_pending_mutex);
+        auto pending{m_pending.load(std::memory_order_relaxed)};
+        if(pending == nullptr || m_frozen.load(std::memory_order_relaxed)){
+            return;
+        }
+        registration* ordered{nullptr};
+        while(pending != nullptr){
+            auto next{pending->m_next};
+            pending->m_next = ordered;
+            ordered = pending;
+            pending = next;
+        }
+        for(; ordered != nullptr; ordered = ordered->m_next){
+            set_entry(key_type(ordered->m_name), ordered->m_setup);
+        }
+        m_pending.store(nullptr, std::memory_order_release);
+    }
+
+    //an existing entry is set up again in place, so builders resolved from
+    //it stay valid
+    void set_entry(key_type const& name, void(*setup)(entry_type&, key_type const&)){
+        auto pos{m_entries.find(name)};
+        if(pos != m_entries.end()){
+            setup(*pos->second, name);
+            return;
+        }
+        auto entry = std::make_unique<Entry>();
+        setup(*entry, name);
+        m_entries.emplace(name, std::move(entry));
+    }
+
+    static void throw_if_frozen(char const* function){
+        if(is_frozen()){
+            throw std::logic_error(std::string("uvwBase::registry::") + function + "() registry is frozen");
+        }
+    }
+
+    //binary search in the frozen array
+    template<typename K>
+    static entry_type* find_sorted(K const& name){
+        auto const& sorted{get().m_sorted};
+        auto pos{std::lower_bound(sorted.begin(), sorted.end(), name, [](auto const& lhs, auto const& key){
+            return std::less<>{}(lhs.first, key);
+        })};
+        if(pos == sorted.end() || std::less<>{}(name, pos->first)){
+            return nullptr;
+        }
+        return pos->second;
+    }
+
+    template<typename K>
+    static entry_type& find_or_throw(K const& name){
+        if(is_frozen()){
+            entry_type* entry{nullptr};
+            if constexpr (requires { std::less<>{}(name, std::declval<key_type const&>()); }){
+                entry = find_sorted(name);
+            }else{
+                entry = find_sorted(key_type(name));
+            }
+            if(entry == nullptr){
+                throw std::runtime_error("uvwBase::registry::build() "+to_key_string(name)+" is not a valid input");
+            }
+            return *entry;
+        }
+        auto pos{find_entry(name)};
         if(pos == get().m_entries.end()){
-            throw std::runtime_error("uvwBase::registry::build() "+name+" is not a valid input");
+            throw std::runtime_error("uvwBase::registry::build() "+to_key_string(name)+" is not a valid input");
         }
         return *(pos->second).get();
     }
 
-    template<typename ...Args>
-    static constexpr inline auto build(key_type const& name, Args... args){
-        auto pos{get().m_entries.find(name)};
-        if(pos == get().m_entries.end()){
-            throw std::runtime_error("uvwBase::registry::build() "+name+" is not a valid input");
+    //looks up a name without building a key_type if the map is transparent,
+    //otherwise falls back to a temporary key_type
+    template<typename K>
+    static auto find_entry(K const& name){
+        auto& entries{get().m_entries};
+        if constexpr (requires { entries.find(name); }){
+            return entries.find(name);
+        }else{
+            return entries.find(key_type(name));
         }
-        return std::move(get().m_entries[name]->build(args...));
     }
 
-    static constexpr inline auto erase(key_type const& name){
-        get().m_entries.erase(name);
+    registry(){}
+
+    transparent_map_t<Map, Key, std::unique_ptr<Entry>> m_entries;
+    std::vector<std::pair<Key, Entry*>> m_sorted;
+    std::atomic<bool> m_frozen{false};
+    static inline std::atomic<registration*> m_pending{nullptr};
+    static inline std::mutex m_pending_mutex;
+};
+
+
+namespace detail {
+//binds an argument to a parameter of type Arg&&: references and rvalues of Arg
+//are passed through, everything else is converted to a temporary Arg
+template<typename Arg, typename T>
+constexpr decltype(auto) bind_parameter(T&& value){
+    if constexpr (std::is_reference_v<Arg> ||
+                  (std::is_same_v<std::remove_cvref_t<T>, Arg> && !std::is_lvalue_reference_v<T>)){
+        return std::forward<T>(value);
+    }else{
+        return Arg(std::forward<T>(value));
     }
+}
+}
 
-private:
+/**
+ * @brief Standard registry entry building objects of a common base type.
+ *
+ * Built objects are returned as `std::unique_ptr<Base, object_deleter<Base>>`.
+ * With pool_construction every registered type gets its own object_pool, so
+ * building and destroying objects recycles slab storage instead of calling
+ * malloc.
+ *
+ * @tparam Base The common base type of the registered objects.
+ * @tparam Construction The construction policy, heap_construction or
+ * pool_construction.
+ * @tparam Args The constructor arguments of the registered objects.
+ */
+template<typename Base, typename Construction, typename ...Args>
+class registry_entry
+{
+public:
+    using base_type = Base;
+    using construction_type = Construction;
+    using pointer = std::unique_ptr<Base, object_deleter<Base>>;
+    //arguments are passed as Args&&: references are forwarded unchanged and
+    //by-value arguments are moved into the constructor
+    using build_ptr = pointer(*)(Args&&...);
 
-    template<typename Derived, typename ...Args>
-    static pointer build_func(Args... args){
-        return std::move(pointer(new Derived(args...)));
+    /**
+     * @brief Stores the name and build function of a registered type.
+     */
+    template<typename T>
+    void setup(std::string const& name, build_ptr func){
+        m_name = name;
+        m_build_ptr = func;
     }
 
-    registry(){}
+    /**
+     * @brief Constructs a Derived according to the construction policy.
+     */
+    template<typename Derived, typename ...CtorArgs>
+    static pointer construct(CtorArgs&&... args){
+        return Construction::template construct<Derived, Base>(std::forward<CtorArgs>(args)...);
+    }
 
-    Map<Key, std::unique_ptr<Entry>> m_entries;
+    /**
+     * @brief Builds an object of the registered type.
+     *
+     * Arguments bound to reference parameters are passed through without a
+     * copy; lvalues of by-value parameters are copied once.
+     */
+    template<typename ...CallArgs>
+    pointer build(CallArgs&&... args) const {
+        static_assert(sizeof...(CallArgs) == sizeof...(Args), "registry_entry::build() wrong number of arguments");
+        return m_build_ptr(detail::bind_parameter<Args>(std::forward<CallArgs>(args))...);
+    }
+
+    /**
+     * @brief Returns the name the type was registered with.
+     */
+    std::string const& name() const {
+        return m_name;
+    }
+
+private:
+    std::string m_name;
+    build_ptr m_build_ptr{nullptr};
 };
 
+/**
+ * @brief registry_entry allocating objects with new.
+ */
+template<typename Base, typename ...Args>
+using heap_registry_entry = registry_entry<Base, heap_construction, Args...>;
+
+/**
+ * @brief registry_entry recycling objects in per-type object pools.
+ */
+template<typename Base, typename ...Args>
+using pooled_registry_entry = registry_entry<Base, pool_construction, Args...>;
+
 }
 #endif // REGISTRY_BONES_H
@@ -0,0 +1,442 @@
+#ifndef SMALL_ANY_H
+#define SMALL_ANY_H
+
+#include "any_printer.h"
+#include "static_indexing.h"
+#include <any>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace numsim_core {
+
+/**
+ * @brief Tag type of the id family used by small_any.
+ *
+ * All small_any instantiations share this family, so a given type has the
+ * same id regardless of the buffer size.
+ */
+struct small_any_family {};
+
+namespace detail {
+/**
+ * @brief Detects specializations of std::in_place_type_t.
+ */
+template <typename T> struct is_in_place_type : std::false_type {};
+
+template <typename T>
+struct is_in_place_type<std::in_place_type_t<T>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_in_place_type_v = is_in_place_type<T>::value;
+} // namespace detail
+
+/**
+ * @brief A type-erased value container with a configurable inline buffer.
+ *
+ * small_any is a drop-in replacement for std::any as the `TypeErasure`
+ * argument of parameter_handler and query_map. Values whose size and
+ * alignment fit into the inline buffer are stored without heap allocation,
+ * larger ones fall back to the heap. Type checks compare a dense id obtained
+ * from static_type_id() instead of `std::type_info` objects.
+ *
+ * @tparam Size The size of the inline buffer in bytes, by default large enough
+ * for a 3x3 tensor of doubles.
+ */
+template <std::size_t Size = 9 * sizeof(double)> class small_any {
+public:
+  /**
+   * @brief The size of the inline buffer in bytes.
+   */
+  static constexpr std::size_t buffer_size{Size};
+
+  /**
+   * @brief Checks whether values of type T are stored inline.
+   *
+   * @tparam T The type of the value.
+   */
+  template <typename T>
+  static constexpr bool fits_inline{
+      sizeof(T) <= Size && alignof(T) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<T>};
+
+  /**
+   * @brief Constructs an empty small_any.
+   */
+  small_any() noexcept = default;
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param other The small_any to copy from.
+   */
+  small_any(small_any const &other) {
+    if (other.m_vtable != nullptr) {
+      other.m_vtable->copy(other, *this);
+      m_vtable = other.m_vtable;
+      m_type = other.m_type;
+    }
+  }
+
+  /**
+   * @brief Move constructor, leaves `other` empty.
+   *
+   * @param other The small_any to move from.
+   */
+  small_any(small_any &&other) noexcept {
+    if (other.m_vtable != nullptr) {
+      other.m_vtable->move(other, *this);
+      m_vtable = std::exchange(other.m_vtable, nullptr);
+      m_type = std::exchange(other.m_type, empty_type());
+    }
+  }
+
+  /**
+   * @brief Constructs a small_any holding a copy of `value`.
+   *
+   * @tparam T The type of the value.
+   * @param value The value to store.
+   */
+  template <typename T,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<T>, small_any> &&
+                !detail::is_in_place_type_v<std::decay_t<T>>>>
+  small_any(T &&value) {
+    emplace<std::decay_t<T>>(std::forward<T>(value));
+  }
+
+  /**
+   * @brief Constructs a value of type T in place.
+   *
+   * @tparam T The type of the value.
+   * @tparam Args The types of the constructor arguments.
+   * @param args The constructor arguments.
+   */
+  template <typename T, typename... Args>
+  explicit small_any(std::in_place_type_t<T>, Args &&...args) {
+    emplace<T>(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Destructor.
+   */
+  ~small_any() { reset(); }
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The small_any to copy from.
+   * @return Reference to this object.
+   */
+  small_any &operator=(small_any const &other) {
+    if (this != &other) {
+      small_any(other).swap(*this);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The small_any to move from.
+   * @return Reference to this object.
+   */
+  small_any &operator=(small_any &&other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.m_vtable != nullptr) {
+        other.m_vtable->move(other, *this);
+        m_vtable = std::exchange(other.m_vtable, nullptr);
+        m_type = std::exchange(other.m_type, empty_type());
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Assigns a new value.
+   *
+   * @tparam T The type of the value.
+   * @param value The value to store.
+   * @return Reference to this object.
+   */
+  template <typename T,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<T>, small_any>>>
+  small_any &operator=(T &&value) {
+    emplace<std::decay_t<T>>(std::forward<T>(value));
+    return *this;
+  }
+
+  /**
+   * @brief Destroys the current value and constructs a new one in place.
+   *
+   * @tparam T The type of the new value.
+   * @tparam Args The types of the constructor arguments.
+   * @param args The constructor arguments.
+   * @return A reference to the new value.
+   */
+  template <typename T, typename... Args> T &emplace(Args &&...args) {
+    static_assert(std::is_copy_constructible_v<T>,
+                  "small_any requires copy constructible types");
+    reset();
+    T *data{nullptr};
+    if constexpr (fits_inline<T>) {
+      data = ::new (static_cast<void *>(m_buffer))
+          T(std::forward<Args>(args)...);
+    } else {
+      data = new T(std::forward<Args>(args)...);
+      ::new (static_cast<void *>(m_buffer)) T *(data);
+    }
+    m_vtable = &vtable_for<T>;
+    m_type = static_type_id<T, small_any_family>();
+    return *data;
+  }
+
+  /**
+   * @brief Destroys the contained value, if any.
+   */
+  void reset() noexcept {
+    if (m_vtable != nullptr) {
+      m_vtable->destroy(*this);
+      m_vtable = nullptr;
+      m_type = empty_type();
+    }
+  }
+
+  /**
+   * @brief Swaps the contents with another small_any.
+   *
+   * @param other The small_any to swap with.
+   */
+  void swap(small_any &other) noexcept {
+    small_any tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  /**
+   * @brief Checks whether a value is stored.
+   */
+  [[nodiscard]] bool has_value() const noexcept { return m_vtable != nullptr; }
+
+  /**
+   * @brief Returns the id of the stored type, or the id of `void` if empty.
+   */
+  [[nodiscard]] type_id type() const noexcept { return m_type; }
+
+  /**
+   * @brief Returns a pointer to the stored value if it is of type T.
+   *
+   * @tparam T The requested type.
+   * @return A pointer to the value, or nullptr on type mismatch.
+   */
+  template <typename T> [[nodiscard]] T *data() noexcept {
+    return m_type == static_type_id<T, small_any_family>() ? ptr<T>()
+                                                           : nullptr;
+  }
+
+  /**
+   * @brief Returns a pointer to the stored value if it is of type T (const
+   * overload).
+   *
+   * @tparam T The requested type.
+   * @return A pointer to the value, or nullptr on type mismatch.
+   */
+  template <typename T> [[nodiscard]] T const *data() const noexcept {
+    return m_type == static_type_id<T, small_any_family>() ? ptr<T>()
+                                                           : nullptr;
+  }
+
+private:
+  /**
+   * @brief Table of type-specific operations.
+   */
+  struct vtable_type {
+    void (*destroy)(small_any &) noexcept;            ///< Destroys the value.
+    void (*copy)(small_any const &, small_any &);     ///< Copies the value.
+    void (*move)(small_any &, small_any &) noexcept;  ///< Moves the value.
+  };
+
+  /**
+   * @brief Returns the id used for an empty small_any.
+   */
+  static type_id empty_type() noexcept {
+    return static_type_id<void, small_any_family>();
+  }
+
+  /**
+   * @brief Returns a pointer to the stored value without type check.
+   */
+  template <typename T> T *ptr() noexcept {
+    if constexpr (fits_inline<T>) {
+      return std::launder(reinterpret_cast<T *>(m_buffer));
+    } else {
+      return *std::launder(reinterpret_cast<T **>(m_buffer));
+    }
+  }
+
+  /**
+   * @brief Returns a pointer to the stored value without type check (const
+   * overload).
+   */
+  template <typename T> T const *ptr() const noexcept {
+    return const_cast<small_any *>(this)->template ptr<T>();
+  }
+
+  /**
+   * @brief The operation table for type T.
+   */
+  template <typename T>
+  static constexpr vtable_type vtable_for{
+      [](small_any &self) noexcept {
+        if constexpr (fits_inline<T>) {
+          self.template ptr<T>()->~T();
+        } else {
+          delete self.template ptr<T>();
+        }
+      },
+      [](small_any const &src, small_any &dst) {
+        if constexpr (fits_inline<T>) {
+          ::new (static_cast<void *>(dst.m_buffer)) T(*src.template ptr<T>());
+        } else {
+          ::new (static_cast<void *>(dst.m_buffer))
+              T *(new T(*src.template ptr<T>()));
+        }
+      },
+      [](small_any &src, small_any &dst) noexcept {
+        if constexpr (fits_inline<T>) {
+          ::new (static_cast<void *>(dst.m_buffer))
+              T(std::move(*src.template ptr<T>()));
+          src.template ptr<T>()->~T();
+        } else {
+          ::new (static_cast<void *>(dst.m_buffer)) T *(src.template ptr<T>());
+        }
+      }};
+
+  alignas(std::max_align_t) std::byte m_buffer[Size < sizeof(void *)
+                                                   ? sizeof(void *)
+                                                   : Size]; ///< Inline storage.
+  vtable_type const *m_vtable{nullptr}; ///< Operations of the stored type.
+  type_id m_type{empty_type()};         ///< Id of the stored type.
+};
+
+/**
+ * @brief Returns a pointer to the value of a small_any if it holds a T.
+ *
+ * @tparam T The requested type.
+ * @param data Pointer to the small_any.
+ * @return A pointer to the value, or nullptr.
+ */
+template <typename T, std::size_t Size>
+inline T const *any_cast(small_any<Size> const *data) noexcept {
+  return data != nullptr ? data->template data<T>() : nullptr;
+}
+
+/**
+ * @brief Returns a pointer to the value of a small_any if it holds a T.
+ *
+ * @tparam T The requested type.
+ * @param data Pointer to the small_any.
+ * @return A pointer to the value, or nullptr.
+ */
+template <typename T, std::size_t Size>
+inline T *any_cast(small_any<Size> *data) noexcept {
+  return data != nullptr ? data->template data<T>() : nullptr;
+}
+
+/**
+ * @brief Accesses the value of a small_any.
+ *
+ * @tparam T The requested type, possibly a reference.
+ * @param data The small_any.
+ * @return The value converted to T.
+ * @throws std::bad_any_cast if the small_any does not hold the requested type.
+ */
+template <typename T, std::size_t Size>
+inline T any_cast(small_any<Size> const &data) {
+  using type = std::remove_cvref_t<T>;
+  auto const *value{data.template data<type>()};
+  if (value == nullptr) {
+    throw std::bad_any_cast();
+  }
+  return static_cast<T>(*value);
+}
+
+/**
+ * @brief Accesses the value of a small_any.
+ *
+ * @tparam T The requested type, possibly a reference.
+ * @param data The small_any.
+ * @return The value converted to T.
+ * @throws std::bad_any_cast if the small_any does not hold the requested type.
+ */
+template <typename T, std::size_t Size>
+inline T any_cast(small_any<Size> &data) {
+  using type = std::remove_cvref_t<T>;
+  auto *value{data.template data<type>()};
+  if (value == nullptr) {
+    throw std::bad_any_cast();
+  }
+  return static_cast<T>(*value);
+}
+
+/**
+ * @brief Accesses the value of an rvalue small_any.
+ *
+ * @tparam T The requested type, possibly a reference.
+ * @param data The small_any.
+ * @return The value converted to T.
+ * @throws std::bad_any_cast if the small_any does not hold the requested type.
+ */
+template <typename T, std::size_t Size>
+inline T any_cast(small_any<Size> &&data) {
+  using type = std::remove_cvref_t<T>;
+  auto *value{data.template data<type>()};
+  if (value == nullptr) {
+    throw std::bad_any_cast();
+  }
+  return static_cast<T>(std::move(*value));
+}
+
+/**
+ * @brief Type erasure traits for small_any, keyed by the dense static id.
+ *
+ * @tparam Size The size of the inline buffer.
+ */
+template <std::size_t Size> struct type_erasure_traits<small_any<Size>> {
+  using key_type = type_id; ///< The key identifying a stored type.
+
+  /**
+   * @brief Returns the key of type T.
+   */
+  template <typename T> static key_type key() noexcept {
+    return static_type_id<T, small_any_family>();
+  }
+
+  /**
+   * @brief Returns the key of the type stored in `data`.
+   */
+  static key_type key(small_any<Size> const &data) noexcept {
+    return data.type();
+  }
+
+  /**
+   * @brief Returns a printable name of the type stored in `data`.
+   */
+  static std::string name(small_any<Size> const &data) {
+    return std::to_string(data.type());
+  }
+};
+
+} // namespace numsim_core
+
+template <std::size_t Size>
+inline auto print(numsim_core::small_any<Size> const &data) {
+  return numsim_core::basic_any_print_wrapper<numsim_core::small_any<Size>>(
+      data);
+}
+
+#endif // SMALL_ANY_H
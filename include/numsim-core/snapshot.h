@@ -0,0 +1,809 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "numsim_core_utility.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#define NUMSIM_CORE_HAS_MMAP 1
+#endif
+
+namespace numsim_core {
+
+/**
+ * @file snapshot.h
+ * @brief Binary snapshots of parameter_handler contents.
+ *
+ * A snapshot stores every parameter as key, type tag and payload. Entries are
+ * sorted by key and every payload is aligned to 8 bytes, so a snapshot can be
+ * used in place, e.g. from a memory mapped file: snapshot_view indexes the
+ * entries with one linear pass and hands out strings and numeric arrays as
+ * views into the buffer without copying.
+ *
+ * @code
+ * numsim_core::write_snapshot(handler, "restart.snap");
+ * numsim_core::snapshot_file file("restart.snap");
+ * auto stiffness{file.view().find("K")->array<double>()};
+ * file.view().load(restarted_handler);
+ * @endcode
+ *
+ * Snapshots use the byte order of the machine that wrote them; loading a
+ * snapshot of a different byte order throws.
+ */
+
+/**
+ * @brief Type tags of the values a snapshot can store.
+ */
+enum class snapshot_tag : std::uint8_t {
+  int32 = 1,         ///< int
+  uint32,            ///< unsigned
+  int64,             ///< long
+  float32,           ///< float
+  float64,           ///< double
+  boolean,           ///< bool
+  string,            ///< std::string
+  int32_array,       ///< std::vector<int>
+  float64_array,     ///< std::vector<double>
+  string_array,      ///< std::vector<std::string>
+  int_double_string, ///< std::tuple<int, double, std::string>
+};
+
+namespace detail {
+inline constexpr std::array<char, 8> snapshot_magic{'N', 'S', 'I', 'M',
+                                                    'S', 'N', 'P', '1'};
+inline constexpr std::uint32_t snapshot_version{1};
+inline constexpr std::uint32_t snapshot_byte_order{0x01020304};
+inline constexpr std::size_t snapshot_alignment{8};
+
+/**
+ * @brief Leading block of a snapshot.
+ */
+struct snapshot_header {
+  std::array<char, 8> m_magic;  ///< Identifies the format.
+  std::uint32_t m_byte_order;   ///< snapshot_byte_order as written.
+  std::uint32_t m_version;      ///< Format version.
+  std::uint64_t m_count;        ///< Number of entries.
+  std::uint64_t m_size;         ///< Size of the snapshot in bytes.
+};
+
+/**
+ * @brief Leading block of every entry, followed by the key and the payload.
+ */
+struct snapshot_entry_header {
+  std::uint32_t m_key_size;              ///< Length of the key.
+  std::uint8_t m_tag;                    ///< The snapshot_tag of the value.
+  std::array<std::uint8_t, 3> m_padding; ///< Unused.
+  std::uint64_t m_payload_size;          ///< Size of the payload in bytes.
+};
+
+static_assert(sizeof(snapshot_header) == 32);
+static_assert(sizeof(snapshot_entry_header) == 16);
+static_assert(sizeof(int) == 4, "snapshots store int as 32 bit integer");
+
+constexpr std::size_t align_snapshot(std::size_t size) noexcept {
+  return (size + snapshot_alignment - 1) & ~(snapshot_alignment - 1);
+}
+
+/**
+ * @brief Appends binary data to a byte buffer.
+ */
+class snapshot_writer {
+public:
+  explicit snapshot_writer(std::vector<std::byte> &buffer) : m_buffer(buffer) {}
+
+  void write(void const *data, std::size_t size) {
+    auto const *bytes{static_cast<std::byte const *>(data)};
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+  }
+
+  template <typename T> void write_value(T const &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    write(&value, sizeof(T));
+  }
+
+  void write_string(std::string_view value) {
+    write_value(static_cast<std::uint64_t>(value.size()));
+    write(value.data(), value.size());
+  }
+
+  void align() { m_buffer.resize(align_snapshot(m_buffer.size())); }
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_buffer.size(); }
+
+  [[nodiscard]] std::vector<std::byte> &buffer() noexcept { return m_buffer; }
+
+private:
+  std::vector<std::byte> &m_buffer;
+};
+
+/**
+ * @brief Reads binary data from a payload, checking its bounds.
+ */
+class snapshot_reader {
+public:
+  explicit snapshot_reader(std::span<std::byte const> data) : m_data(data) {}
+
+  std::span<std::byte const> read(std::size_t size) {
+    if (size > m_data.size() - m_offset) {
+      throw std::runtime_error("numsim_core::snapshot: truncated payload");
+    }
+    auto bytes{m_data.subspan(m_offset, size)};
+    m_offset += size;
+    return bytes;
+  }
+
+  template <typename T> T read_value() {
+    T value;
+    std::memcpy(&value, read(sizeof(T)).data(), sizeof(T));
+    return value;
+  }
+
+  std::string_view read_string() {
+    const auto size{read_value<std::uint64_t>()};
+    auto bytes{read(static_cast<std::size_t>(size))};
+    return {reinterpret_cast<char const *>(bytes.data()), bytes.size()};
+  }
+
+  std::string_view read_rest() {
+    auto bytes{read(m_data.size() - m_offset)};
+    return {reinterpret_cast<char const *>(bytes.data()), bytes.size()};
+  }
+
+private:
+  std::span<std::byte const> m_data;
+  std::size_t m_offset{0};
+};
+
+/**
+ * @brief Encoding of one value type, specialized for every snapshot_tag.
+ */
+template <typename T> struct snapshot_codec;
+
+template <typename T, snapshot_tag Tag, typename Stored = T>
+struct snapshot_scalar_codec {
+  static constexpr snapshot_tag tag{Tag};
+
+  static void encode(snapshot_writer &writer, T const &value) {
+    writer.write_value(static_cast<Stored>(value));
+  }
+
+  static T decode(std::span<std::byte const> payload) {
+    snapshot_reader reader(payload);
+    return static_cast<T>(reader.read_value<Stored>());
+  }
+};
+
+template <>
+struct snapshot_codec<int>
+    : snapshot_scalar_codec<int, snapshot_tag::int32, std::int32_t> {};
+template <>
+struct snapshot_codec<unsigned>
+    : snapshot_scalar_codec<unsigned, snapshot_tag::uint32, std::uint32_t> {};
+template <>
+struct snapshot_codec<long>
+    : snapshot_scalar_codec<long, snapshot_tag::int64, std::int64_t> {};
+template <>
+struct snapshot_codec<float>
+    : snapshot_scalar_codec<float, snapshot_tag::float32> {};
+template <>
+struct snapshot_codec<double>
+    : snapshot_scalar_codec<double, snapshot_tag::float64> {};
+template <>
+struct snapshot_codec<bool>
+    : snapshot_scalar_codec<bool, snapshot_tag::boolean, std::uint8_t> {};
+
+template <> struct snapshot_codec<std::string> {
+  static constexpr snapshot_tag tag{snapshot_tag::string};
+
+  static void encode(snapshot_writer &writer, std::string const &value) {
+    writer.write(value.data(), value.size());
+  }
+
+  static std::string decode(std::span<std::byte const> payload) {
+    return std::string(snapshot_reader(payload).read_rest());
+  }
+};
+
+template <typename T, snapshot_tag Tag> struct snapshot_array_codec {
+  static constexpr snapshot_tag tag{Tag};
+
+  static void encode(snapshot_writer &writer, std::vector<T> const &value) {
+    writer.write(value.data(), value.size() * sizeof(T));
+  }
+
+  static std::vector<T> decode(std::span<std::byte const> payload) {
+    if (payload.size() % sizeof(T) != 0) {
+      throw std::runtime_error("numsim_core::snapshot: truncated payload");
+    }
+    std::vector<T> value(payload.size() / sizeof(T));
+    std::memcpy(value.data(), payload.data(), payload.size());
+    return value;
+  }
+};
+
+template <>
+struct snapshot_codec<std::vector<int>>
+    : snapshot_array_codec<int, snapshot_tag::int32_array> {};
+template <>
+struct snapshot_codec<std::vector<double>>
+    : snapshot_array_codec<double, snapshot_tag::float64_array> {};
+
+template <> struct snapshot_codec<std::vector<std::string>> {
+  static constexpr snapshot_tag tag{snapshot_tag::string_array};
+
+  static void encode(snapshot_writer &writer,
+                     std::vector<std::string> const &value) {
+    writer.write_value(static_cast<std::uint64_t>(value.size()));
+    for (const auto &entry : value) {
+      writer.write_string(entry);
+    }
+  }
+
+  static std::vector<std::string> decode(std::span<std::byte const> payload) {
+    snapshot_reader reader(payload);
+    const auto size{reader.read_value<std::uint64_t>()};
+    if (size > payload.size() / sizeof(std::uint64_t)) {
+      throw std::runtime_error("numsim_core::snapshot: truncated payload");
+    }
+    std::vector<std::string> value;
+    value.reserve(static_cast<std::size_t>(size));
+    for (std::uint64_t i = 0; i < size; ++i) {
+      value.emplace_back(reader.read_string());
+    }
+    return value;
+  }
+};
+
+template <> struct snapshot_codec<std::tuple<int, double, std::string>> {
+  static constexpr snapshot_tag tag{snapshot_tag::int_double_string};
+
+  static void encode(snapshot_writer &writer,
+                     std::tuple<int, double, std::string> const &value) {
+    writer.write_value(static_cast<std::int32_t>(std::get<0>(value)));
+    writer.write_value(std::get<1>(value));
+    writer.write(std::get<2>(value).data(), std::get<2>(value).size());
+  }
+
+  static std::tuple<int, double, std::string>
+  decode(std::span<std::byte const> payload) {
+    snapshot_reader reader(payload);
+    const auto first{reader.read_value<std::int32_t>()};
+    const auto second{reader.read_value<double>()};
+    return {first, second, std::string(reader.read_rest())};
+  }
+};
+
+/**
+ * @brief The value types a snapshot can store.
+ */
+using snapshot_types =
+    std::tuple<int, unsigned, long, float, double, bool, std::string,
+               std::vector<int>, std::vector<double>, std::vector<std::string>,
+               std::tuple<int, double, std::string>>;
+
+/**
+ * @brief Encoders of all snapshot_types, keyed by the stored type of the
+ * type erasure.
+ */
+template <typename TypeErasure> struct snapshot_encoders {
+  using traits = type_erasure_traits<TypeErasure>;
+  using visitor_map = std::unordered_map<
+      typename traits::key_type,
+      inplace_function<snapshot_tag(TypeErasure const &, snapshot_writer &)>>;
+
+  template <typename T> static auto make_encoder() {
+    return std::pair<const typename traits::key_type,
+                     typename visitor_map::mapped_type>{
+        traits::template key<T>(),
+        [](TypeErasure const &data, snapshot_writer &writer) {
+          using std::any_cast;
+          snapshot_codec<T>::encode(writer, any_cast<T const &>(data));
+          return snapshot_codec<T>::tag;
+        }};
+  }
+
+  static visitor_map make() {
+    return std::apply(
+        [](auto... types) {
+          return make_visitor_map<visitor_map>(
+              make_encoder<decltype(types)>()...);
+        },
+        snapshot_types{});
+  }
+
+  static inline const visitor_map encoders{make()};
+};
+
+/**
+ * @brief Writes one entry, aligning key and payload to 8 bytes.
+ */
+template <typename TypeErasure>
+void write_snapshot_entry(snapshot_writer &writer, std::string_view key,
+                          TypeErasure const &value) {
+  using traits = type_erasure_traits<TypeErasure>;
+  auto const &encoders{snapshot_encoders<TypeErasure>::encoders};
+  const auto pos{encoders.find(traits::key(value))};
+  if (pos == encoders.end()) {
+    throw std::runtime_error("numsim_core::snapshot: type " +
+                             traits::name(value) + " of parameter " +
+                             std::string(key) + " cannot be stored");
+  }
+  const auto header_offset{writer.size()};
+  writer.write_value(snapshot_entry_header{});
+  writer.write(key.data(), key.size());
+  writer.align();
+  const auto payload_offset{writer.size()};
+  const auto tag{pos->second(value, writer)};
+  const snapshot_entry_header header{
+      static_cast<std::uint32_t>(key.size()), static_cast<std::uint8_t>(tag),
+      {}, static_cast<std::uint64_t>(writer.size() - payload_offset)};
+  std::memcpy(writer.buffer().data() + header_offset, &header, sizeof(header));
+  writer.align();
+}
+
+/**
+ * @brief Decodes a value of the given tag and passes it to a function.
+ *
+ * @return False if the tag is unknown.
+ */
+template <typename Function, typename... Types>
+bool visit_snapshot_value(snapshot_tag tag, std::span<std::byte const> payload,
+                          Function &&func,
+                          std::tuple<Types...> const * /*types*/) {
+  return ((tag == snapshot_codec<Types>::tag
+               ? (func(snapshot_codec<Types>::decode(payload)), true)
+               : false) ||
+          ...);
+}
+
+/**
+ * @brief Writes a snapshot of key/value pairs, sorting them by key.
+ *
+ * @param entries The keys and values; the keys are opaque byte strings.
+ * @return The snapshot.
+ */
+template <typename TypeErasure>
+std::vector<std::byte> write_snapshot_entries(
+    std::vector<std::pair<std::string_view, TypeErasure const *>> &entries) {
+  std::sort(entries.begin(), entries.end(),
+            [](auto const &lhs, auto const &rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  std::vector<std::byte> buffer;
+  buffer.reserve(sizeof(snapshot_header) + entries.size() * 48);
+  snapshot_writer writer(buffer);
+  writer.write_value(snapshot_header{});
+  for (const auto &[key, value] : entries) {
+    write_snapshot_entry(writer, key, *value);
+  }
+  const snapshot_header header{snapshot_magic, snapshot_byte_order,
+                               snapshot_version,
+                               static_cast<std::uint64_t>(entries.size()),
+                               static_cast<std::uint64_t>(buffer.size())};
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  return buffer;
+}
+} // namespace detail
+
+/**
+ * @brief Serializes all parameters of a handler into a snapshot buffer.
+ *
+ * Supported are the value types any_print_wrapper prints by value: int,
+ * unsigned, long, float, double, bool, std::string, std::vector of int,
+ * double and std::string, and std::tuple<int, double, std::string>.
+ * Deferred values are computed and stored like explicit ones.
+ *
+ * @tparam Handler The parameter handler type, with string-like keys.
+ * @param handler The handler to serialize.
+ * @return The snapshot.
+ * @throws std::runtime_error if a parameter has an unsupported type.
+ */
+template <typename Handler>
+std::vector<std::byte> to_snapshot(Handler const &handler) {
+  using type_erasure = typename Handler::type_erasure_type;
+  static_assert(is_string_key_v<typename Handler::key_type>,
+                "snapshots require string-like keys");
+  std::vector<std::pair<std::string_view, type_erasure const *>> entries;
+  entries.reserve(handler.size());
+  for (const auto &[key, value] : handler) {
+    entries.emplace_back(std::string_view(key), &value);
+  }
+  handler.for_each_deferred([&entries](auto const &key, auto const &value) {
+    entries.emplace_back(std::string_view(key), &value);
+  });
+  return detail::write_snapshot_entries(entries);
+}
+
+/**
+ * @brief Writes a snapshot of a handler to a stream.
+ *
+ * @param handler The handler to serialize.
+ * @param os The binary output stream.
+ */
+template <typename Handler>
+void write_snapshot(Handler const &handler, std::ostream &os) {
+  const auto buffer{to_snapshot(handler)};
+  os.write(reinterpret_cast<char const *>(buffer.data()),
+           static_cast<std::streamsize>(buffer.size()));
+}
+
+/**
+ * @brief Writes a snapshot of a handler to a file.
+ *
+ * @param handler The handler to serialize.
+ * @param path The path of the file.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+template <typename Handler>
+void write_snapshot(Handler const &handler, std::string const &path) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  write_snapshot(handler, os);
+  if (!os) {
+    throw std::runtime_error("numsim_core::write_snapshot: cannot write " +
+                             path);
+  }
+}
+
+/**
+ * @brief A read-only view of a snapshot buffer.
+ *
+ * The view indexes the entries on construction and references the buffer
+ * afterwards, so the buffer must outlive the view.
+ */
+class snapshot_view {
+public:
+  /**
+   * @brief One parameter of the snapshot.
+   */
+  struct entry {
+    std::string_view m_key;               ///< The key.
+    snapshot_tag m_tag;                   ///< The type of the value.
+    std::span<std::byte const> m_payload; ///< The encoded value.
+
+    /**
+     * @brief Decodes a copy of the value.
+     *
+     * @tparam T The type of the value.
+     * @throws std::invalid_argument if the value is of another type.
+     */
+    template <typename T> T value() const {
+      check_tag(detail::snapshot_codec<T>::tag);
+      return detail::snapshot_codec<T>::decode(m_payload);
+    }
+
+    /**
+     * @brief Returns a string value without copying.
+     *
+     * @throws std::invalid_argument if the value is not a string.
+     */
+    std::string_view string() const {
+      check_tag(snapshot_tag::string);
+      return {reinterpret_cast<char const *>(m_payload.data()),
+              m_payload.size()};
+    }
+
+    /**
+     * @brief Returns an int or double array value without copying.
+     *
+     * @tparam T int or double.
+     * @throws std::invalid_argument if the value is of another type.
+     */
+    template <typename T> std::span<T const> array() const {
+      static_assert(std::is_same_v<T, int> || std::is_same_v<T, double>,
+                    "snapshot arrays are of int or double");
+      check_tag(detail::snapshot_codec<std::vector<T>>::tag);
+      return {reinterpret_cast<T const *>(m_payload.data()),
+              m_payload.size() / sizeof(T)};
+    }
+
+  private:
+    void check_tag(snapshot_tag tag) const {
+      if (tag != m_tag) {
+        throw std::invalid_argument("numsim_core::snapshot_view: parameter " +
+                                    std::string(m_key) +
+                                    " is of another type");
+      }
+    }
+  };
+
+  /**
+   * @brief Indexes a snapshot buffer.
+   *
+   * @param data The snapshot, aligned to 8 bytes.
+   * @throws std::invalid_argument if the buffer is misaligned.
+   * @throws std::runtime_error if the buffer is not a valid snapshot.
+   */
+  explicit snapshot_view(std::span<std::byte const> data) {
+    if (reinterpret_cast<std::uintptr_t>(data.data()) %
+            detail::snapshot_alignment != 0) {
+      throw std::invalid_argument(
+          "numsim_core::snapshot_view: buffer must be aligned to 8 bytes");
+    }
+    if (data.size() < sizeof(detail::snapshot_header)) {
+      corrupt();
+    }
+    detail::snapshot_header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.m_magic != detail::snapshot_magic) {
+      throw std::runtime_error("numsim_core::snapshot_view: not a snapshot");
+    }
+    if (header.m_byte_order != detail::snapshot_byte_order) {
+      throw std::runtime_error(
+          "numsim_core::snapshot_view: snapshot of another byte order");
+    }
+    if (header.m_version != detail::snapshot_version) {
+      throw std::runtime_error(
+          "numsim_core::snapshot_view: unsupported snapshot version");
+    }
+    if (header.m_size > data.size()) {
+      corrupt();
+    }
+    data = data.first(static_cast<std::size_t>(header.m_size));
+
+    m_entries.reserve(static_cast<std::size_t>(
+        std::min<std::uint64_t>(header.m_count, data.size())));
+    std::size_t offset{sizeof(detail::snapshot_header)};
+    for (std::uint64_t i = 0; i < header.m_count; ++i) {
+      if (data.size() - offset < sizeof(detail::snapshot_entry_header)) {
+        corrupt();
+      }
+      detail::snapshot_entry_header entry_header;
+      std::memcpy(&entry_header, data.data() + offset, sizeof(entry_header));
+      offset += sizeof(entry_header);
+      if (data.size() - offset < entry_header.m_key_size) {
+        corrupt();
+      }
+      const std::string_view key{
+          reinterpret_cast<char const *>(data.data() + offset),
+          entry_header.m_key_size};
+      offset = detail::align_snapshot(offset + entry_header.m_key_size);
+      if (offset > data.size() ||
+          data.size() - offset < entry_header.m_payload_size) {
+        corrupt();
+      }
+      const auto payload_size{
+          static_cast<std::size_t>(entry_header.m_payload_size)};
+      m_entries.push_back({key, static_cast<snapshot_tag>(entry_header.m_tag),
+                           data.subspan(offset, payload_size)});
+      offset = std::min(detail::align_snapshot(offset + payload_size),
+                        data.size());
+      if (i > 0 && !(m_entries[i - 1].m_key < key)) {
+        corrupt();
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the number of stored parameters.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_entries.size(); }
+
+  /**
+   * @brief Returns an iterator to the first entry, in key order.
+   */
+  [[nodiscard]] auto begin() const noexcept { return m_entries.begin(); }
+
+  /**
+   * @brief Returns an iterator past the last entry.
+   */
+  [[nodiscard]] auto end() const noexcept { return m_entries.end(); }
+
+  /**
+   * @brief Looks up a parameter by binary search.
+   *
+   * @param key The key of the parameter.
+   * @return The entry, or nullptr if the key is not stored.
+   */
+  [[nodiscard]] entry const *find(std::string_view key) const noexcept {
+    const auto pos{std::lower_bound(
+        m_entries.begin(), m_entries.end(), key,
+        [](entry const &lhs, std::string_view rhs) { return lhs.m_key < rhs; })};
+    return pos != m_entries.end() && pos->m_key == key ? &*pos : nullptr;
+  }
+
+  /**
+   * @brief Looks up a parameter.
+   *
+   * @param key The key of the parameter.
+   * @throws std::invalid_argument if the key is not stored.
+   */
+  [[nodiscard]] entry const &at(std::string_view key) const {
+    const auto *pos{find(key)};
+    if (pos == nullptr) {
+      throw std::invalid_argument("Key " + std::string(key) + " not found");
+    }
+    return *pos;
+  }
+
+  /**
+   * @brief Inserts copies of all parameters into a handler.
+   *
+   * The storage is reserved once and allocator-aware keys are constructed
+   * with the allocator of the handler, so a handler on a
+   * std::pmr::monotonic_buffer_resource is filled without a heap allocation
+   * per scalar entry.
+   *
+   * @param handler The handler to fill; existing keys are overwritten.
+   * @throws std::runtime_error if an entry has an unknown type tag.
+   */
+  template <typename Handler> void load(Handler &handler) const {
+    handler.reserve(handler.size() + m_entries.size());
+    for (const auto &item : m_entries) {
+      visit(item, [&](auto &&value) {
+        handler.insert(std::make_obj_using_allocator<typename Handler::key_type>(
+                           handler.get_allocator(), item.m_key),
+                       std::forward<decltype(value)>(value));
+      });
+    }
+  }
+
+  /**
+   * @brief Decodes the value of an entry and passes it to a function.
+   *
+   * @param item The entry.
+   * @param func Called with the decoded value as rvalue.
+   * @throws std::runtime_error if the entry has an unknown type tag.
+   */
+  template <typename Function>
+  static void visit(entry const &item, Function &&func) {
+    if (!detail::visit_snapshot_value(
+            item.m_tag, item.m_payload, func,
+            static_cast<detail::snapshot_types const *>(nullptr))) {
+      throw std::runtime_error("numsim_core::snapshot_view: parameter " +
+                               std::string(item.m_key) +
+                               " has an unknown type");
+    }
+  }
+
+private:
+  [[noreturn]] static void corrupt() {
+    throw std::runtime_error("numsim_core::snapshot_view: corrupt snapshot");
+  }
+
+  std::vector<entry> m_entries; ///< The entries in key order.
+};
+
+/**
+ * @brief A snapshot file, memory mapped where supported.
+ *
+ * On POSIX systems the file is mapped read-only and the view references the
+ * mapping; elsewhere the file is read into memory.
+ */
+class snapshot_file {
+public:
+  /**
+   * @brief Opens and indexes a snapshot file.
+   *
+   * @param path The path of the file.
+   * @throws std::runtime_error if the file cannot be read or is not a valid
+   * snapshot.
+   */
+  explicit snapshot_file(std::string const &path)
+      : m_mapping(path), m_view(m_mapping.bytes()) {}
+
+  snapshot_file(snapshot_file const &) = delete;
+
+  snapshot_file &operator=(snapshot_file const &) = delete;
+
+  /**
+   * @brief Returns the view of the snapshot.
+   */
+  [[nodiscard]] snapshot_view const &view() const noexcept { return m_view; }
+
+private:
+  /**
+   * @brief Owns the bytes of the file: a read-only mapping, or a copy of the
+   * contents where mmap is not available.
+   *
+   * A member of its own, so the file is released even if indexing the
+   * snapshot throws.
+   */
+  class mapping {
+  public:
+    explicit mapping(std::string const &path) {
+#ifdef NUMSIM_CORE_HAS_MMAP
+      const int fd{::open(path.c_str(), O_RDONLY)};
+      if (fd < 0) {
+        fail(path, errno);
+      }
+      struct stat status {};
+      if (::fstat(fd, &status) != 0) {
+        const int error{errno};
+        ::close(fd);
+        fail(path, error);
+      }
+      const auto size{static_cast<std::size_t>(status.st_size)};
+      if (size == 0) {
+        ::close(fd);
+        return;
+      }
+      void *data{::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+      const int error{errno};
+      ::close(fd);
+      if (data == MAP_FAILED) {
+        fail(path, error);
+      }
+      m_bytes = {static_cast<std::byte const *>(data), size};
+#else
+      std::ifstream is(path, std::ios::binary | std::ios::ate);
+      if (!is) {
+        throw std::runtime_error("numsim_core::snapshot_file: cannot open " +
+                                 path);
+      }
+      m_storage.resize(static_cast<std::size_t>(is.tellg()));
+      is.seekg(0);
+      is.read(reinterpret_cast<char *>(m_storage.data()),
+              static_cast<std::streamsize>(m_storage.size()));
+      m_bytes = m_storage;
+#endif
+    }
+
+    mapping(mapping const &) = delete;
+
+    mapping &operator=(mapping const &) = delete;
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~mapping() {
+#ifdef NUMSIM_CORE_HAS_MMAP
+      if (!m_bytes.empty()) {
+        ::munmap(const_cast<std::byte *>(m_bytes.data()), m_bytes.size());
+      }
+#endif
+    }
+
+    /**
+     * @brief Returns the bytes of the file.
+     */
+    [[nodiscard]] std::span<std::byte const> bytes() const noexcept {
+      return m_bytes;
+    }
+
+  private:
+#ifdef NUMSIM_CORE_HAS_MMAP
+    [[noreturn]] static void fail(std::string const &path, int error) {
+      throw std::system_error(error, std::generic_category(),
+                              "numsim_core::snapshot_file: cannot map " +
+                                  path);
+    }
+#else
+    std::vector<std::byte> m_storage; ///< The file contents.
+#endif
+
+    std::span<std::byte const> m_bytes; ///< The mapped file.
+  };
+
+  mapping m_mapping;    ///< The file.
+  snapshot_view m_view; ///< The view of the file.
+};
+
+} // namespace numsim_core
+
+#endif // SNAPSHOT_H
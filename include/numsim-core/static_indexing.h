@@ -2,6 +2,7 @@
 #define STATIC_INDEXING_H
 
 
+#include <atomic>
 #include <utility>
 
 namespace numsim_core {
@@ -9,26 +10,64 @@ namespace numsim_core {
 using type_id = unsigned int;
 
 namespace detail {
+//atomic counters: threads using different types of a family for the first
+//time may ask for ids concurrently
 template<typename Derived>
 struct static_indexing_inc
 {
-  static inline type_id m_id{0};
-  static inline type_id m_max_id{0};
+  static inline std::atomic<type_id> m_id{0};
+  static inline std::atomic<type_id> m_max_id{0};
 
   static type_id getID() {
-    m_max_id++;
-    return m_id++;
+    m_max_id.fetch_add(1);
+    return m_id.fetch_add(1);
   }
 };
 
-template <typename Type, typename Derived = void>
-struct static_indexing_imp {
-  static inline type_id value{static_indexing_inc<Derived>::getID()};
-};
+}
 
+/**
+ * @brief Returns the sequential id of `Type` within the id family `Family`.
+ *
+ * Ids are dense and start at zero for every family. The id is assigned on
+ * first use, so the function is safe to call during static initialization
+ * and from several threads.
+ *
+ * @tparam Type The type to identify.
+ * @tparam Family The tag type of the id family.
+ * @return The id of `Type`.
+ */
+template <typename Type, typename Family>
+[[nodiscard]] inline type_id static_type_id() noexcept {
+  static const type_id id{detail::static_indexing_inc<Family>::getID()};
+  return id;
 }
 
-/// class for counting the different implementations
+/**
+ * @brief Returns the number of ids handed out in the id family `Family`.
+ *
+ * All ids of the family lie in `[0, type_count<Family>())`, so the count is
+ * the size of a dense table indexed by id.
+ *
+ * @tparam Family The tag type of the id family.
+ */
+template <typename Family> [[nodiscard]] inline type_id type_count() noexcept {
+  return detail::static_indexing_inc<Family>::m_max_id.load();
+}
+
+/**
+ * @brief Class for counting the different implementations of `Base`.
+ *
+ * Every `Derived` receives a sequential id within the family of `Base`, so
+ * the ids of one hierarchy are dense and can index a dispatch table, see
+ * type_dispatch.h. If `Base` declares
+ * `virtual type_id get_type_id() const noexcept`, it is overridden and the id
+ * of an object can be queried through a `Base` reference. The id is assigned
+ * on first use, so it is valid during static initialization as well.
+ *
+ * @tparam Derived The implementation.
+ * @tparam Base The interface defining the id family.
+ */
 template <typename Derived, typename Base> class static_indexing : public Base {
 public:
   using expr_type = Base;
@@ -39,15 +78,28 @@ public:
   static_indexing(static_indexing &&) = delete;
   virtual ~static_indexing() = default;
   const static_indexing &operator=(static_indexing const &) = delete;
-//  [[nodiscard]] type_id get_type_id() const noexcept final override {
-//    return m_id;
-//  }
-//  [[nodiscard]] static type_id get_static_type_id() noexcept {
-//    return m_id;
-//  }
-
-private:
-  static inline auto m_id{detail::static_indexing_imp<Derived>::value};
+
+  /**
+   * @brief Returns the id of the dynamic type of the object.
+   */
+  [[nodiscard]] type_id get_type_id() const noexcept {
+    return static_type_id<Derived, Base>();
+  }
+
+  /**
+   * @brief Returns the id of `Derived`.
+   */
+  [[nodiscard]] static type_id get_static_type_id() noexcept {
+    return static_type_id<Derived, Base>();
+  }
+
+  /**
+   * @brief Returns the number of implementations of `Base` whose id was used
+   * so far.
+   */
+  [[nodiscard]] static type_id type_count() noexcept {
+    return numsim_core::type_count<Base>();
+  }
 };
 
 
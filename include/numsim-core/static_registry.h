@@ -0,0 +1,396 @@
+#ifndef STATIC_REGISTRY_H
+#define STATIC_REGISTRY_H
+
+#include "numsim_core_utility.h"
+#include "registry_bones.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace numsim_core {
+
+/**
+ * @brief Declares one name/type pair of a static_registry.
+ *
+ * Usually spelled through the StaticRegisterObject macro.
+ *
+ * @tparam Name The name the type is registered with.
+ * @tparam T The registered type.
+ */
+template <fixed_string Name, typename T> struct registration {
+  using type = T; ///< The registered type.
+
+  /**
+   * @brief The name the type is registered with.
+   */
+  static constexpr std::string_view name{Name.view()};
+};
+
+/**
+ * @brief Spells a registration for a static_registry, the compile-time
+ * counterpart of RegisterObject.
+ */
+#define StaticRegisterObject(Name, ObjectType)                                 \
+  ::numsim_core::registration<#Name, ObjectType>
+
+namespace detail {
+/**
+ * @brief Hash used by perfect_hash_table, usable in constant expressions.
+ *
+ * Consumes the key eight bytes at a time; the byte assembly compiles to
+ * plain loads in optimized builds.
+ *
+ * @param key The key to hash.
+ * @return The hash value.
+ */
+constexpr std::uint64_t perfect_hash(std::string_view key) noexcept {
+  std::uint64_t hash{0x9E3779B97F4A7C15ull ^ key.size()};
+  for (std::size_t i = 0; i < key.size(); i += 8) {
+    std::uint64_t chunk{0};
+    for (std::size_t j = 0; j < 8 && i + j < key.size(); ++j) {
+      chunk |= static_cast<std::uint64_t>(
+                   static_cast<unsigned char>(key[i + j]))
+               << (8 * j);
+    }
+    hash = (hash ^ chunk) * 0xff51afd7ed558ccdull;
+    hash ^= hash >> 32;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/**
+ * @brief Derives the seeded second-level hash from a key hash.
+ *
+ * @param hash The key hash.
+ * @param seed The seed selecting the hash function.
+ * @return The second-level hash value.
+ */
+constexpr std::uint64_t perfect_hash_seeded(std::uint64_t hash,
+                                            std::uint32_t seed) noexcept {
+  return ((hash ^ seed) * 0x9E3779B97F4A7C15ull) >> 32;
+}
+} // namespace detail
+
+/**
+ * @brief A minimal perfect hash over a fixed set of strings, built at compile
+ * time.
+ *
+ * Keys are distributed over buckets by their hash; every bucket stores the
+ * seed of a second, integer-only hash placing its keys into distinct slots
+ * (hash and displace). A lookup hashes the key once, reads two table entries
+ * and compares one string.
+ *
+ * @tparam N The number of keys.
+ */
+template <std::size_t N> class perfect_hash_table {
+public:
+  static constexpr std::size_t npos{
+      std::numeric_limits<std::size_t>::max()}; ///< Marks a failed lookup.
+
+  /**
+   * @brief Builds the table for the given keys.
+   *
+   * Fails to be a constant expression if two keys are equal.
+   *
+   * @param keys The keys, referenced by their position.
+   */
+  constexpr explicit perfect_hash_table(
+      std::array<std::string_view, N> const &keys)
+      : m_keys(keys) {
+    for (std::size_t i = 0; i < N; ++i) {
+      for (std::size_t j = i + 1; j < N; ++j) {
+        if (keys[i] == keys[j]) {
+          throw std::logic_error("perfect_hash_table: duplicate key");
+        }
+      }
+    }
+    m_index.fill(empty_slot);
+
+    std::array<std::size_t, table_size> bucket_size{};
+    for (const auto &key : keys) {
+      ++bucket_size[bucket(key)];
+    }
+    std::array<std::size_t, table_size> order{};
+    for (std::size_t i = 0; i < table_size; ++i) {
+      order[i] = i;
+    }
+    // Place the largest buckets first while most slots are free
+    for (std::size_t i = 0; i < table_size; ++i) {
+      for (std::size_t j = i + 1; j < table_size; ++j) {
+        if (bucket_size[order[j]] > bucket_size[order[i]]) {
+          std::swap(order[i], order[j]);
+        }
+      }
+    }
+
+    for (const auto current : order) {
+      if (bucket_size[current] == 0) {
+        break;
+      }
+      place_bucket(current);
+    }
+  }
+
+  /**
+   * @brief Returns the position of a key, or npos if it is not in the table.
+   *
+   * @param key The key to look up.
+   */
+  [[nodiscard]] constexpr std::size_t find(std::string_view key) const noexcept {
+    if constexpr (N == 0) {
+      return npos;
+    } else {
+      const auto hash{detail::perfect_hash(key)};
+      const auto seed{m_seeds[hash & (table_size - 1)]};
+      const auto index{m_index[slot(hash, seed)]};
+      return index != empty_slot && m_keys[index] == key ? index : npos;
+    }
+  }
+
+private:
+  static constexpr std::size_t table_size{
+      std::bit_ceil(N == 0 ? std::size_t{1} : N)}; ///< Slots and buckets.
+  static constexpr std::uint32_t empty_slot{
+      std::numeric_limits<std::uint32_t>::max()}; ///< Marks a free slot.
+  static constexpr std::uint32_t max_seed{
+      1u << 20}; ///< Bound of the seed search per bucket.
+
+  /**
+   * @brief Returns the bucket of a key.
+   */
+  static constexpr std::size_t bucket(std::string_view key) noexcept {
+    return detail::perfect_hash(key) & (table_size - 1);
+  }
+
+  /**
+   * @brief Returns the slot of a key for the seed of its bucket.
+   */
+  static constexpr std::size_t slot(std::uint64_t hash,
+                                    std::uint32_t seed) noexcept {
+    return detail::perfect_hash_seeded(hash, seed) & (table_size - 1);
+  }
+
+  /**
+   * @brief Searches a seed placing all keys of a bucket into free slots.
+   */
+  constexpr void place_bucket(std::size_t current) {
+    for (std::uint32_t seed = 1; seed < max_seed; ++seed) {
+      std::array<std::size_t, table_size> slots{};
+      std::size_t count{0};
+      bool placed{true};
+      for (std::size_t i = 0; i < N && placed; ++i) {
+        if (bucket(m_keys[i]) != current) {
+          continue;
+        }
+        const auto candidate{slot(detail::perfect_hash(m_keys[i]), seed)};
+        placed = m_index[candidate] == empty_slot;
+        for (std::size_t j = 0; j < count && placed; ++j) {
+          placed = slots[j] != candidate;
+        }
+        slots[count++] = candidate;
+      }
+      if (placed) {
+        m_seeds[current] = seed;
+        count = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+          if (bucket(m_keys[i]) == current) {
+            m_index[slots[count++]] = static_cast<std::uint32_t>(i);
+          }
+        }
+        return;
+      }
+    }
+    throw std::logic_error("perfect_hash_table: no seed found");
+  }
+
+  std::array<std::string_view, N> m_keys;        ///< The keys by position.
+  std::array<std::uint32_t, table_size> m_seeds{}; ///< Seed per bucket.
+  std::array<std::uint32_t, table_size> m_index{}; ///< Key position per slot.
+};
+
+/**
+ * @brief A registry whose names are fixed at compile time.
+ *
+ * Opt-in alternative to registry when all registrations can be listed in one
+ * place. The names are placed into a constexpr perfect_hash_table, so
+ * dispatching a name to its entry costs one hash and one string comparison
+ * and involves no map. The registry is immutable and can be used from any
+ * number of threads.
+ *
+ * @code
+ * using material_registry = numsim_core::static_registry<
+ *     numsim_core::heap_registry_entry<material, double>,
+ *     StaticRegisterObject(linear_elastic, linear_elastic),
+ *     StaticRegisterObject(plastic, plastic)>;
+ * auto object{material_registry::build("plastic", 210.0e3)};
+ * @endcode
+ *
+ * @tparam Entry The entry type, see registry_entry.
+ * @tparam Registrations The registration<Name, Type> declarations.
+ */
+template <typename Entry, typename... Registrations> class static_registry {
+public:
+  using entry_type = Entry;                       ///< The entry type.
+  using pointer = typename Entry::pointer;        ///< Built object pointer.
+  using build_ptr = typename Entry::build_ptr;    ///< Build function pointer.
+
+  /**
+   * @brief A name resolved to its entry, building objects without lookup.
+   */
+  class builder {
+  public:
+    /**
+     * @brief Constructs an empty builder.
+     */
+    builder() = default;
+
+    /**
+     * @brief Constructs a builder for an entry.
+     *
+     * @param entry The entry to build with.
+     */
+    explicit builder(entry_type const &entry) : m_entry(&entry) {}
+
+    /**
+     * @brief Builds an object of the resolved type.
+     *
+     * @param args The constructor arguments.
+     */
+    template <typename... Args> pointer operator()(Args &&...args) const {
+      return m_entry->build(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Returns the resolved entry.
+     */
+    entry_type const &entity() const { return *m_entry; }
+
+    /**
+     * @brief Checks whether the builder is bound to an entry.
+     */
+    explicit operator bool() const { return m_entry != nullptr; }
+
+  private:
+    entry_type const *m_entry{nullptr}; ///< The resolved entry.
+  };
+
+  /**
+   * @brief Returns the number of registered types.
+   */
+  static constexpr std::size_t size() noexcept {
+    return sizeof...(Registrations);
+  }
+
+  /**
+   * @brief Returns the position of a name, or npos if it is not registered.
+   *
+   * Usable in constant expressions.
+   *
+   * @param name The name to look up.
+   */
+  static constexpr std::size_t index(std::string_view name) noexcept {
+    return table.find(name);
+  }
+
+  /**
+   * @brief Checks whether a name is registered.
+   *
+   * @param name The name to look up.
+   */
+  static constexpr bool contains(std::string_view name) noexcept {
+    return index(name) != npos;
+  }
+
+  /**
+   * @brief Returns the entry of a name.
+   *
+   * @param name The name to look up.
+   * @throws std::runtime_error if the name is not registered.
+   */
+  static entry_type const &entity(std::string_view name) {
+    const auto position{index(name)};
+    if (position == npos) {
+      throw std::runtime_error("numsim_core::static_registry::build() " +
+                               std::string(name) + " is not a valid input");
+    }
+    return entries()[position];
+  }
+
+  /**
+   * @brief Returns the entry of a name resolved at compile time.
+   *
+   * @tparam Name The registered name.
+   */
+  template <fixed_string Name> static entry_type const &entity() {
+    constexpr auto position{index(Name.view())};
+    static_assert(position != npos,
+                  "numsim_core::static_registry: name is not registered");
+    return entries()[position];
+  }
+
+  /**
+   * @brief Builds an object by name.
+   *
+   * @param name The registered name.
+   * @param args The constructor arguments.
+   * @throws std::runtime_error if the name is not registered.
+   */
+  template <typename... Args>
+  static pointer build(std::string_view name, Args &&...args) {
+    return entity(name).build(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Resolves a name once into a builder.
+   *
+   * @param name The registered name.
+   * @throws std::runtime_error if the name is not registered.
+   */
+  static builder resolve(std::string_view name) {
+    return builder(entity(name));
+  }
+
+  /**
+   * @brief The names in registration order.
+   */
+  static constexpr std::array<std::string_view, sizeof...(Registrations)>
+      names{Registrations::name...};
+
+private:
+  static constexpr auto npos{perfect_hash_table<
+      sizeof...(Registrations)>::npos}; ///< Marks a failed lookup.
+
+  /**
+   * @brief The perfect hash over all names.
+   */
+  static constexpr perfect_hash_table<sizeof...(Registrations)> table{names};
+
+  /**
+   * @brief Returns the entries in registration order, set up on first use.
+   */
+  static auto const &entries() {
+    static const auto data{[]() {
+      std::array<Entry, sizeof...(Registrations)> result{};
+      std::size_t position{0};
+      ((result[position++].template setup<typename Registrations::type>(
+           std::string(Registrations::name),
+           &detail::build_object<Entry, typename Registrations::type>)),
+       ...);
+      return result;
+    }()};
+    return data;
+  }
+};
+
+} // namespace numsim_core
+
+#endif // STATIC_REGISTRY_H
@@ -0,0 +1,252 @@
+#ifndef TYPE_DISPATCH_H
+#define TYPE_DISPATCH_H
+
+#include "static_indexing.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace numsim_core {
+
+/**
+ * @file type_dispatch.h
+ * @brief Dense dispatch tables indexed by the ids of static_indexing.
+ *
+ * The ids of one static_indexing family are sequential, so handlers can be
+ * stored in a plain vector and selected by indexing instead of `dynamic_cast`
+ * chains or visitor hierarchies:
+ *
+ * @code
+ * numsim_core::double_dispatch_table<void(material &, element &)> kernels;
+ * kernels.set<linear_elastic, hex8>([](material &m, element &e) {
+ *   assemble(static_cast<linear_elastic &>(m), static_cast<hex8 &>(e));
+ * });
+ * kernels(m.get_type_id(), e.get_type_id(), m, e);
+ * @endcode
+ */
+
+template <typename Signature> class type_dispatch_table;
+
+/**
+ * @brief Maps the type ids of one family to handler functions.
+ *
+ * @tparam Result The return type of the handlers.
+ * @tparam Args The argument types of the handlers.
+ */
+template <typename Result, typename... Args>
+class type_dispatch_table<Result(Args...)> {
+public:
+  using function_ptr = Result (*)(Args...); ///< The handler type.
+
+  /**
+   * @brief Constructs an empty table.
+   */
+  type_dispatch_table() = default;
+
+  /**
+   * @brief Constructs a table with room for `size` type ids.
+   *
+   * @param size The number of type ids, usually type_count<Base>().
+   */
+  explicit type_dispatch_table(std::size_t size) : m_table(size, nullptr) {}
+
+  /**
+   * @brief Sets the handler of a type id, growing the table if needed.
+   *
+   * @param id The type id.
+   * @param func The handler.
+   */
+  void set(type_id id, function_ptr func) {
+    if (id >= m_table.size()) {
+      m_table.resize(id + 1, nullptr);
+    }
+    m_table[id] = func;
+  }
+
+  /**
+   * @brief Sets the handler of a static_indexing implementation.
+   *
+   * @tparam Derived The implementation.
+   * @param func The handler.
+   */
+  template <typename Derived> void set(function_ptr func) {
+    set(Derived::get_static_type_id(), func);
+  }
+
+  /**
+   * @brief Returns the handler of a type id, or nullptr if none is set.
+   *
+   * @param id The type id.
+   */
+  [[nodiscard]] function_ptr find(type_id id) const noexcept {
+    return id < m_table.size() ? m_table[id] : nullptr;
+  }
+
+  /**
+   * @brief Checks whether a handler is set for a type id.
+   *
+   * @param id The type id.
+   */
+  [[nodiscard]] bool contains(type_id id) const noexcept {
+    return find(id) != nullptr;
+  }
+
+  /**
+   * @brief Calls the handler of a type id.
+   *
+   * @param id The type id.
+   * @param args The arguments passed to the handler.
+   * @throws std::out_of_range if no handler is set.
+   */
+  Result operator()(type_id id, Args... args) const {
+    const auto func{find(id)};
+    if (func == nullptr) {
+      throw std::out_of_range(
+          "numsim_core::type_dispatch_table: no handler for type id " +
+          std::to_string(id));
+    }
+    return func(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Returns the number of type ids the table has room for.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_table.size(); }
+
+private:
+  std::vector<function_ptr> m_table; ///< Handler per type id.
+};
+
+template <typename Signature> class double_dispatch_table;
+
+/**
+ * @brief Maps pairs of type ids of two families to handler functions.
+ *
+ * The handlers are stored row-major in one contiguous block, so a dispatch
+ * is one multiply-add and one indirect call.
+ *
+ * @tparam Result The return type of the handlers.
+ * @tparam Args The argument types of the handlers.
+ */
+template <typename Result, typename... Args>
+class double_dispatch_table<Result(Args...)> {
+public:
+  using function_ptr = Result (*)(Args...); ///< The handler type.
+
+  /**
+   * @brief Constructs an empty table.
+   */
+  double_dispatch_table() = default;
+
+  /**
+   * @brief Constructs a table with room for `rows` x `cols` type ids.
+   *
+   * @param rows The number of type ids of the first family.
+   * @param cols The number of type ids of the second family.
+   */
+  double_dispatch_table(std::size_t rows, std::size_t cols)
+      : m_table(rows * cols, nullptr), m_rows(rows), m_cols(cols) {}
+
+  /**
+   * @brief Sets the handler of a pair of type ids, growing the table if
+   * needed.
+   *
+   * @param row The type id of the first family.
+   * @param col The type id of the second family.
+   * @param func The handler.
+   */
+  void set(type_id row, type_id col, function_ptr func) {
+    if (row >= m_rows || col >= m_cols) {
+      resize(std::max<std::size_t>(m_rows, row + 1),
+             std::max<std::size_t>(m_cols, col + 1));
+    }
+    m_table[row * m_cols + col] = func;
+  }
+
+  /**
+   * @brief Sets the handler of a pair of static_indexing implementations.
+   *
+   * @tparam Row The implementation of the first family.
+   * @tparam Col The implementation of the second family.
+   * @param func The handler.
+   */
+  template <typename Row, typename Col> void set(function_ptr func) {
+    set(Row::get_static_type_id(), Col::get_static_type_id(), func);
+  }
+
+  /**
+   * @brief Returns the handler of a pair of type ids, or nullptr if none is
+   * set.
+   *
+   * @param row The type id of the first family.
+   * @param col The type id of the second family.
+   */
+  [[nodiscard]] function_ptr find(type_id row, type_id col) const noexcept {
+    return row < m_rows && col < m_cols ? m_table[row * m_cols + col]
+                                        : nullptr;
+  }
+
+  /**
+   * @brief Checks whether a handler is set for a pair of type ids.
+   *
+   * @param row The type id of the first family.
+   * @param col The type id of the second family.
+   */
+  [[nodiscard]] bool contains(type_id row, type_id col) const noexcept {
+    return find(row, col) != nullptr;
+  }
+
+  /**
+   * @brief Calls the handler of a pair of type ids.
+   *
+   * @param row The type id of the first family.
+   * @param col The type id of the second family.
+   * @param args The arguments passed to the handler.
+   * @throws std::out_of_range if no handler is set.
+   */
+  Result operator()(type_id row, type_id col, Args... args) const {
+    const auto func{find(row, col)};
+    if (func == nullptr) {
+      throw std::out_of_range(
+          "numsim_core::double_dispatch_table: no handler for type ids (" +
+          std::to_string(row) + ", " + std::to_string(col) + ")");
+    }
+    return func(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Returns the number of type ids of the first family.
+   */
+  [[nodiscard]] std::size_t rows() const noexcept { return m_rows; }
+
+  /**
+   * @brief Returns the number of type ids of the second family.
+   */
+  [[nodiscard]] std::size_t cols() const noexcept { return m_cols; }
+
+private:
+  /**
+   * @brief Grows the table, keeping all handlers at their ids.
+   */
+  void resize(std::size_t rows, std::size_t cols) {
+    std::vector<function_ptr> table(rows * cols, nullptr);
+    for (std::size_t row = 0; row < m_rows; ++row) {
+      std::copy_n(m_table.begin() + row * m_cols, m_cols,
+                  table.begin() + row * cols);
+    }
+    m_table = std::move(table);
+    m_rows = rows;
+    m_cols = cols;
+  }
+
+  std::vector<function_ptr> m_table; ///< Handlers, row-major.
+  std::size_t m_rows{0};             ///< Number of rows.
+  std::size_t m_cols{0};             ///< Number of columns.
+};
+
+} // namespace numsim_core
+
+#endif // TYPE_DISPATCH_H
@@ -1,15 +1,276 @@
 #ifndef WAREHOUSE_BONES_H
 #define WAREHOUSE_BONES_H
 
+#include "static_indexing.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace numsim_core {
 
-template <typename T>
+/**
+ * @brief Owning store for objects of a hierarchy, grouped by concrete type.
+ *
+ * Every concrete type gets its own segment, selected by its static_type_id
+ * within the family of T (the same id static_indexing<Derived, T> assigns).
+ * A segment stores the objects contiguously in chunks of ChunkSize objects
+ * which are never relocated, so iterating all objects of one type is a
+ * linear walk without virtual calls, and references and handles stay valid
+ * while objects are added.
+ *
+ * @tparam T The base type of the stored objects.
+ * @tparam ChunkSize The number of objects per chunk.
+ */
+template <typename T, std::size_t ChunkSize = 64>
 class warehouse
 {
+    static_assert(ChunkSize > 0, "warehouse requires a non-empty chunk");
+
 public:
-    warehouse() {}
+    using size_type = std::size_t;
+
+    /**
+     * @brief Stable reference to an object in the warehouse.
+     */
+    struct handle
+    {
+        static constexpr type_id invalid{std::numeric_limits<type_id>::max()};
+
+        type_id m_type{invalid};
+        size_type m_index{0};
+
+        explicit operator bool() const noexcept {
+            return m_type != invalid;
+        }
+
+        friend bool operator==(handle const&, handle const&) = default;
+    };
+
+    warehouse() = default;
+
+    warehouse(warehouse const&) = delete;
+
+    warehouse& operator=(warehouse const&) = delete;
+
+    warehouse(warehouse&&) noexcept = default;
+
+    warehouse& operator=(warehouse&&) noexcept = default;
+
+    //constructs a Derived in the segment of its type
+    template<typename Derived, typename ...Args>
+    handle emplace(Args&&... args){
+        static_assert(std::is_base_of_v<T, Derived>, "warehouse: Derived must derive from T");
+        const auto id{static_type_id<Derived, T>()};
+        const auto index{segment_of<Derived>().emplace(std::forward<Args>(args)...)};
+        return handle{id, index};
+    }
+
+    T& get(handle h){
+        return *checked_segment(h)->get(h.m_index);
+    }
+
+    T const& get(handle h) const {
+        return *checked_segment(h)->get(h.m_index);
+    }
+
+    //typed access, throws if the handle refers to another type
+    template<typename Derived>
+    Derived& get(handle h){
+        return find_segment_or_throw<Derived>(h)->at(h.m_index);
+    }
+
+    template<typename Derived>
+    Derived const& get(handle h) const {
+        return find_segment_or_throw<Derived>(h)->at(h.m_index);
+    }
+
+    //calls func for every object of type Derived in insertion order
+    template<typename Derived, typename Function>
+    void for_each(Function&& func){
+        if(auto* seg{find_segment<Derived>()}){
+            seg->for_each(func);
+        }
+    }
+
+    template<typename Derived, typename Function>
+    void for_each(Function&& func) const {
+        if(auto const* seg{find_segment<Derived>()}){
+            seg->for_each(func);
+        }
+    }
+
+    //calls func for every object as T, grouped by type
+    template<typename Function>
+    void for_each(Function&& func){
+        for(auto& seg : m_segments){
+            if(seg){
+                for(size_type i{0}; i < seg->size(); ++i){
+                    func(*seg->get(i));
+                }
+            }
+        }
+    }
+
+    template<typename Function>
+    void for_each(Function&& func) const {
+        for(auto const& seg : m_segments){
+            if(seg){
+                for(size_type i{0}; i < seg->size(); ++i){
+                    func(static_cast<T const&>(*seg->get(i)));
+                }
+            }
+        }
+    }
+
+    template<typename Derived>
+    size_type size() const {
+        auto const* seg{find_segment<Derived>()};
+        return seg != nullptr ? seg->size() : 0;
+    }
+
+    size_type size() const {
+        size_type count{0};
+        for(auto const& seg : m_segments){
+            count += seg ? seg->size() : 0;
+        }
+        return count;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    //destroys all objects, invalidating all handles
+    void clear(){
+        m_segments.clear();
+    }
+
+private:
+    struct segment_base
+    {
+        virtual ~segment_base() = default;
+        virtual T* get(size_type index) = 0;
+        virtual size_type size() const = 0;
+    };
+
+    template<typename Derived>
+    class segment final : public segment_base
+    {
+    public:
+        segment() = default;
+
+        segment(segment const&) = delete;
+
+        segment& operator=(segment const&) = delete;
+
+        ~segment() override {
+            while(m_size > 0){
+                data(--m_size)->~Derived();
+            }
+        }
+
+        template<typename ...Args>
+        size_type emplace(Args&&... args){
+            if(m_size == m_chunks.size() * ChunkSize){
+                m_chunks.push_back(std::make_unique<chunk>());
+            }
+            ::new (address(m_size)) Derived(std::forward<Args>(args)...);
+            return m_size++;
+        }
+
+        T* get(size_type index) override {
+            return data(index);
+        }
+
+        size_type size() const override {
+            return m_size;
+        }
+
+        Derived& at(size_type index){
+            if(index >= m_size){
+                throw std::out_of_range("numsim_core::warehouse: invalid handle");
+            }
+            return *data(index);
+        }
+
+        //walks chunk by chunk, the hot loop sees a plain array of Derived
+        template<typename Function>
+        void for_each(Function& func){
+            for(size_type first{0}; first < m_size; first += ChunkSize){
+                auto* objects{data(first)};
+                const auto count{std::min(ChunkSize, m_size - first)};
+                for(size_type i{0}; i < count; ++i){
+                    func(objects[i]);
+                }
+            }
+        }
+
+        template<typename Function>
+        void for_each(Function& func) const {
+            const_cast<segment*>(this)->for_each([&func](Derived& object){
+                func(static_cast<Derived const&>(object));
+            });
+        }
+
+    private:
+        struct chunk
+        {
+            alignas(Derived) std::byte m_storage[sizeof(Derived) * ChunkSize];
+        };
+
+        void* address(size_type index){
+            return m_chunks[index / ChunkSize]->m_storage + (index % ChunkSize) * sizeof(Derived);
+        }
+
+        Derived* data(size_type index){
+            return std::launder(static_cast<Derived*>(address(index)));
+        }
+
+        std::vector<std::unique_ptr<chunk>> m_chunks;
+        size_type m_size{0};
+    };
+
+    template<typename Derived>
+    segment<Derived>& segment_of(){
+        const auto id{static_type_id<Derived, T>()};
+        if(id >= m_segments.size()){
+            m_segments.resize(std::max<std::size_t>(id + 1, type_count<T>()));
+        }
+        if(!m_segments[id]){
+            m_segments[id] = std::make_unique<segment<Derived>>();
+        }
+        return static_cast<segment<Derived>&>(*m_segments[id]);
+    }
+
+    template<typename Derived>
+    segment<Derived>* find_segment() const {
+        const auto id{static_type_id<Derived, T>()};
+        return id < m_segments.size() ? static_cast<segment<Derived>*>(m_segments[id].get()) : nullptr;
+    }
+
+    template<typename Derived>
+    segment<Derived>* find_segment_or_throw(handle h) const {
+        auto* seg{find_segment<Derived>()};
+        if(seg == nullptr || h.m_type != static_type_id<Derived, T>()){
+            throw std::invalid_argument("numsim_core::warehouse: handle does not refer to the requested type");
+        }
+        return seg;
+    }
 
+    segment_base* checked_segment(handle h) const {
+        if(h.m_type >= m_segments.size() || !m_segments[h.m_type] || h.m_index >= m_segments[h.m_type]->size()){
+            throw std::out_of_range("numsim_core::warehouse: invalid handle");
+        }
+        return m_segments[h.m_type].get();
+    }
 
+    std::vector<std::unique_ptr<segment_base>> m_segments;
 };
 
 }
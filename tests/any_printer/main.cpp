@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <any>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <numsim-core/any_printer.h>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/small_any.h>
+
+using numsim_core::print_buffer;
+using numsim_core::value_printer;
+
+namespace {
+struct point {
+  double m_x;
+  double m_y;
+};
+
+template <typename TypeErasure>
+std::string print_value(TypeErasure const &data) {
+  std::ostringstream os;
+  {
+    numsim_core::basic_value_printer<TypeErasure> printer(os);
+    printer(data);
+  }
+  return os.str();
+}
+} // namespace
+
+// Numbers use the shortest round-trip representation
+TEST(PrintBufferTest, FormatsNumbers) {
+  std::ostringstream os;
+  {
+    print_buffer out(os);
+    out.write_number(42);
+    out.put(' ');
+    out.write_number(0.1);
+    out.put(' ');
+    out.write_number(-2.5e300);
+    out.put(' ');
+    out.write_number(true);
+  }
+  EXPECT_EQ(os.str(), "42 0.1 -2.5e+300 true");
+}
+
+// Text larger than the buffer is passed through in order
+TEST(PrintBufferTest, FlushesInOrder) {
+  std::ostringstream os;
+  print_buffer out(os, 64);
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    out.write_number(i);
+    out.put(',');
+    expected += std::to_string(i) + ",";
+  }
+  const std::string large(200, 'x');
+  out.write(large);
+  out.write_quoted("a\"b");
+  expected += large + "\"a\\\"b\"";
+  out.flush();
+  EXPECT_EQ(os.str(), expected);
+}
+
+// The built-in types print like any_print_wrapper
+TEST(ValuePrinterTest, PrintsBuiltinTypes) {
+  EXPECT_EQ(print_value(std::any(42)), "42");
+  EXPECT_EQ(print_value(std::any(2.71828)), "2.71828");
+  EXPECT_EQ(print_value(std::any(std::string("steel"))), "steel");
+  EXPECT_EQ(print_value(std::any(std::vector<double>{1.5, 2.0})), "1.5 2 ");
+  EXPECT_EQ(print_value(std::any(std::vector<std::string>{"a", "b"})),
+            "a b ");
+  EXPECT_EQ(print_value(std::any(std::tuple<int, double, std::string>{
+                10, 3.5, "tuple test"})),
+            "(10, 3.5, \"tuple test\")");
+  EXPECT_EQ(print_value(numsim_core::small_any<>(std::vector<int>{1, 2})),
+            "1 2 ");
+  EXPECT_EQ(print_value(numsim_core::small_any<>(false)), "false");
+}
+
+// Unknown types throw
+TEST(ValuePrinterTest, UnknownTypeThrows) {
+  EXPECT_THROW(print_value(std::any(std::vector<bool>{true})),
+               std::runtime_error);
+  EXPECT_THROW(print_value(numsim_core::small_any<>(std::vector<bool>{true})),
+               std::runtime_error);
+}
+
+// Types added at runtime print through both paths
+TEST(ValuePrinterTest, RuntimeRegistration) {
+  const auto print_point{[](point const &p, print_buffer &out) {
+    out.put('[');
+    out.write_number(p.m_x);
+    out.write(", ");
+    out.write_number(p.m_y);
+    out.put(']');
+  }};
+  numsim_core::print_table<std::any>::instance().add<point>(print_point);
+  numsim_core::print_table<numsim_core::small_any<>>::instance().add<point>(
+      print_point);
+
+  EXPECT_EQ(print_value(std::any(point{1.0, 2.5})), "[1, 2.5]");
+  EXPECT_EQ(print_value(numsim_core::small_any<>(point{3.0, 4.0})), "[3, 4]");
+
+  std::ostringstream os;
+  os << numsim_core::any_print_wrapper(std::any(point{0.5, 1.0}));
+  EXPECT_EQ(os.str(), "[0.5, 1]");
+}
+
+// parameter_handler prints all entries through the bulk path
+TEST(ValuePrinterTest, PrintsHandler) {
+  numsim_core::parameter_handler<> handler;
+  handler.insert("E", 210000.0);
+  handler.insert("nodes", std::vector<int>{1, 2, 3});
+
+  std::ostringstream os;
+  {
+    value_printer printer(os);
+    handler.print(printer);
+  }
+  const auto text{os.str()};
+  EXPECT_NE(text.find("E: 210000\n"), std::string::npos);
+  EXPECT_NE(text.find("nodes: 1 2 3 \n"), std::string::npos);
+  EXPECT_EQ(text.size(), std::string("E: 210000\nnodes: 1 2 3 \n").size());
+}
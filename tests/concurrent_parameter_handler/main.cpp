@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <numsim-core/concurrent_parameter_handler.h>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/small_any.h>
+
+using numsim_core::concurrent_parameter_handler;
+
+// The read interface follows parameter_handler
+TEST(ConcurrentParameterHandlerTest, InsertAndGet) {
+  concurrent_parameter_handler<> handler;
+  handler.insert("E", 210000.0);
+  handler.insert("name", std::string("steel"));
+  EXPECT_EQ(handler.get<double>("E"), 210000.0);
+  EXPECT_EQ(handler.get<std::string>("name"), "steel");
+  EXPECT_TRUE(handler.contains("E"));
+  EXPECT_FALSE(handler.contains("nu"));
+  EXPECT_EQ(handler.size(), 2u);
+  EXPECT_THROW((void)handler.get<double>("nu"), std::invalid_argument);
+
+  handler.clear();
+  EXPECT_EQ(handler.size(), 0u);
+}
+
+// A batch is published at once and a failing batch is not published
+TEST(ConcurrentParameterHandlerTest, BatchedUpdate) {
+  numsim_core::parameter_handler<> initial;
+  initial.insert("steps", 5);
+  concurrent_parameter_handler<> handler(initial);
+
+  handler.update([](auto &next) {
+    next.insert("steps", 10);
+    next.insert("dt", 0.1);
+  });
+  EXPECT_THROW(handler.update([](auto &next) {
+    next.insert("dt", 0.2);
+    throw std::runtime_error("abort");
+  }),
+               std::runtime_error);
+  EXPECT_EQ(handler.read([](auto const &current) {
+    return current.template get<int>("steps") *
+           current.template get<double>("dt");
+  }),
+            1.0);
+}
+
+// A guard keeps its version while an update is published
+TEST(ConcurrentParameterHandlerTest, GuardKeepsVersion) {
+  concurrent_parameter_handler<> handler;
+  handler.insert("steps", 5);
+
+  std::atomic<bool> entered{false};
+  std::atomic<bool> release{false};
+  int seen{0};
+  std::thread reader([&] {
+    const auto guard{handler.read()};
+    entered = true;
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+    seen = guard->get<int>("steps");
+  });
+  while (!entered.load()) {
+    std::this_thread::yield();
+  }
+  // the writer waits for the reader before freeing the old version
+  std::thread writer([&] { handler.insert("steps", 10); });
+  while (handler.get<int>("steps") != 10) {
+    std::this_thread::yield();
+  }
+  release = true;
+  reader.join();
+  writer.join();
+  EXPECT_EQ(seen, 5);
+  EXPECT_EQ(handler.get<int>("steps"), 10);
+}
+
+// Other storage policies are selected through the same template parameters
+TEST(ConcurrentParameterHandlerTest, SmallAny) {
+  concurrent_parameter_handler<std::string, numsim_core::small_any<>> handler;
+  handler.insert("nodes", std::vector<int>{1, 2, 3});
+  EXPECT_EQ(handler.get<std::vector<int>>("nodes"),
+            (std::vector<int>{1, 2, 3}));
+  std::ostringstream os;
+  handler.print(os);
+  EXPECT_FALSE(os.str().empty());
+}
+
+// Readers always see a complete batch while a writer publishes
+TEST(ConcurrentParameterHandlerTest, ConcurrentReaders) {
+  concurrent_parameter_handler<> handler;
+  handler.update([](auto &next) {
+    next.insert("a", 0);
+    next.insert("b", 0);
+  });
+
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        handler.read([&](auto const &current) {
+          if (current.template get<int>("a") !=
+              current.template get<int>("b")) {
+            ++torn;
+          }
+        });
+        (void)handler.get<int>("a");
+      }
+    });
+  }
+  for (int i = 1; i <= 500; ++i) {
+    handler.update([i](auto &next) {
+      next.insert("a", i);
+      next.insert("b", i);
+    });
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_EQ(handler.get<int>("a"), 500);
+}
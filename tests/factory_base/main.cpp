@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <numsim-core/factory_base_bones.h>
+#include <numsim-core/static_indexing.h>
+
+using numsim_core::factory_base;
+
+struct material {
+  virtual ~material() = default;
+  [[nodiscard]] virtual double stiffness() const = 0;
+};
+
+struct linear_elastic final : material {
+  explicit linear_elastic(double youngs_modulus = 1.0)
+      : m_youngs_modulus(youngs_modulus) {}
+  [[nodiscard]] double stiffness() const override { return m_youngs_modulus; }
+  double m_youngs_modulus;
+};
+
+struct hyperelastic final : material {
+  [[nodiscard]] double stiffness() const override { return 2.0; }
+  double m_state[3]{1.0, 2.0, 3.0};
+};
+
+// static_indexing types cannot be copied, so they cannot be cloned.
+struct unique_material final
+    : numsim_core::static_indexing<unique_material, material> {
+  [[nodiscard]] double stiffness() const override { return 3.0; }
+};
+
+// Test adding prototypes and looking them up by string_view
+TEST(FactoryBaseTest, AddAndGet) {
+  factory_base<material> factory;
+  factory.add<linear_elastic>("steel", 210.0);
+  factory.add<hyperelastic>("rubber");
+  EXPECT_EQ(factory.size(), 2u);
+  constexpr std::string_view name{"steel"};
+  EXPECT_TRUE(factory.contains(name));
+  EXPECT_FALSE(factory.contains("wood"));
+  EXPECT_DOUBLE_EQ(factory.get(name)->stiffness(), 210.0);
+  EXPECT_DOUBLE_EQ(factory.get("rubber")->stiffness(), 2.0);
+}
+
+// Test that an unknown name throws instead of dereferencing end()
+TEST(FactoryBaseTest, UnknownNameThrows) {
+  factory_base<material> factory;
+  EXPECT_THROW(factory.get("wood"), std::runtime_error);
+  EXPECT_THROW(factory.create("wood"), std::runtime_error);
+  EXPECT_THROW(factory.create_n("wood", 4), std::runtime_error);
+}
+
+// Test that re-adding a name replaces its prototype
+TEST(FactoryBaseTest, ReplacePrototype) {
+  factory_base<material> factory;
+  factory.add<linear_elastic>("steel", 210.0);
+  factory.add<linear_elastic>("steel", 200.0);
+  EXPECT_EQ(factory.size(), 1u);
+  EXPECT_DOUBLE_EQ(factory.create("steel")->stiffness(), 200.0);
+}
+
+// Test cloning independent objects from a prototype
+TEST(FactoryBaseTest, CreateClonesPrototype) {
+  factory_base<material> factory;
+  factory.add<linear_elastic>("steel", 210.0);
+  auto object{factory.create("steel")};
+  EXPECT_NE(object.get(), factory.get("steel"));
+  EXPECT_DOUBLE_EQ(object->stiffness(), 210.0);
+  static_cast<linear_elastic &>(*object).m_youngs_modulus = 1.0;
+  EXPECT_DOUBLE_EQ(factory.get("steel")->stiffness(), 210.0);
+}
+
+// Test creating a contiguous batch of clones
+TEST(FactoryBaseTest, CreateN) {
+  factory_base<material> factory;
+  factory.add<hyperelastic>("rubber");
+  auto objects{factory.create_n("rubber", 100)};
+  ASSERT_EQ(objects.size(), 100u);
+  EXPECT_DOUBLE_EQ(objects[99].stiffness(), 2.0);
+
+  const auto typed{objects.view<hyperelastic>()};
+  ASSERT_EQ(typed.size(), 100u);
+  EXPECT_EQ(static_cast<material *>(&typed[42]), &objects[42]);
+  EXPECT_EQ(reinterpret_cast<char *>(&typed[1]) -
+                reinterpret_cast<char *>(&typed[0]),
+            static_cast<std::ptrdiff_t>(sizeof(hyperelastic)));
+  EXPECT_DOUBLE_EQ(typed[7].m_state[2], 3.0);
+  EXPECT_THROW(objects.view<linear_elastic>(), std::invalid_argument);
+
+  auto moved{std::move(objects)};
+  EXPECT_EQ(moved.size(), 100u);
+  EXPECT_TRUE(objects.empty());
+  EXPECT_TRUE(factory.create_n("rubber", 0).empty());
+}
+
+// Test that non-copyable prototypes can be stored but not cloned
+TEST(FactoryBaseTest, NonCopyablePrototype) {
+  factory_base<material> factory;
+  factory.add<unique_material>("unique");
+  EXPECT_DOUBLE_EQ(factory.get("unique")->stiffness(), 3.0);
+  EXPECT_THROW(factory.create("unique"), std::logic_error);
+  EXPECT_THROW(factory.create_n("unique", 2), std::logic_error);
+}
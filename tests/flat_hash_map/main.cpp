@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <numsim-core/flat_hash_map.h>
+
+using numsim_core::flat_hash_map;
+
+// Test fixture class
+class FlatHashMapTest : public ::testing::Test {
+protected:
+  flat_hash_map<std::string, int> map;
+};
+
+// Test inserting and finding values
+TEST_F(FlatHashMapTest, InsertAndFind) {
+  map.insert_or_assign(std::string("a"), 1);
+  map.insert_or_assign(std::string("b"), 2);
+  ASSERT_NE(map.find("a"), map.end());
+  EXPECT_EQ(map.find("a")->second, 1);
+  EXPECT_EQ(map.find("b")->second, 2);
+  EXPECT_EQ(map.find("c"), map.end());
+  EXPECT_EQ(map.size(), 2u);
+}
+
+// Test that insert_or_assign overwrites existing values
+TEST_F(FlatHashMapTest, InsertOrAssignOverwrites) {
+  EXPECT_TRUE(map.insert_or_assign(std::string("a"), 1).second);
+  EXPECT_FALSE(map.insert_or_assign(std::string("a"), 5).second);
+  EXPECT_EQ(map.find("a")->second, 5);
+  EXPECT_EQ(map.size(), 1u);
+}
+
+// Test operator[] default-constructs missing values
+TEST_F(FlatHashMapTest, SubscriptDefaultConstructs) {
+  EXPECT_EQ(map["x"], 0);
+  map["x"] = 7;
+  EXPECT_EQ(map["x"], 7);
+}
+
+// Test growing beyond the initial slot table
+TEST_F(FlatHashMapTest, GrowAndLookupMany) {
+  for (int i = 0; i < 1000; ++i) {
+    map.insert_or_assign(std::to_string(i), i);
+  }
+  EXPECT_EQ(map.size(), 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(map.contains(std::to_string(i)));
+    EXPECT_EQ(map.find(std::to_string(i))->second, i);
+  }
+}
+
+// Test erasing keeps all remaining keys reachable
+TEST_F(FlatHashMapTest, EraseKeepsRemainingKeys) {
+  for (int i = 0; i < 100; ++i) {
+    map.insert_or_assign(std::to_string(i), i);
+  }
+  for (int i = 0; i < 100; i += 2) {
+    EXPECT_EQ(map.erase(std::to_string(i)), 1u);
+  }
+  EXPECT_EQ(map.erase("0"), 0u);
+  EXPECT_EQ(map.size(), 50u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.contains(std::to_string(i)), i % 2 == 1);
+  }
+}
+
+// Test erasing from clusters of integer keys sharing home slots
+TEST(FlatHashMapCollisionTest, EraseKeepsCollidingKeys) {
+  flat_hash_map<int, int> small;
+  small.insert_or_assign(0, 0);
+  small.insert_or_assign(12, 12);
+  small.insert_or_assign(22, 22);
+  EXPECT_EQ(small.erase(0), 1u);
+  EXPECT_EQ(small.size(), 2u);
+  EXPECT_TRUE(small.contains(12));
+  EXPECT_TRUE(small.contains(22));
+
+  for (int count = 1; count < 200; count += 7) {
+    for (int step = 1; step < 5; ++step) {
+      flat_hash_map<int, int> keys;
+      for (int i = 0; i < count; ++i) {
+        keys.insert_or_assign(i * step, i);
+      }
+      for (int i = 0; i < count; i += 3) {
+        EXPECT_EQ(keys.erase(i * step), 1u);
+      }
+      for (int i = 0; i < count; ++i) {
+        const auto pos{keys.find(i * step)};
+        if (i % 3 == 0) {
+          EXPECT_EQ(pos, keys.end());
+        } else {
+          ASSERT_NE(pos, keys.end()) << count << " " << step << " " << i;
+          EXPECT_EQ(pos->second, i);
+        }
+      }
+    }
+  }
+}
+
+// Test clearing the map
+TEST_F(FlatHashMapTest, Clear) {
+  map.insert_or_assign(std::string("a"), 1);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains("a"));
+  map.insert_or_assign(std::string("a"), 2);
+  EXPECT_EQ(map.find("a")->second, 2);
+}
+
+// Test iteration visits all entries
+TEST_F(FlatHashMapTest, Iteration) {
+  map.insert_or_assign(std::string("a"), 1);
+  map.insert_or_assign(std::string("b"), 2);
+  int sum{0};
+  for (const auto &[key, value] : map) {
+    sum += value;
+  }
+  EXPECT_EQ(sum, 3);
+}
+
+TEST(TransparentFlatHashMapTest, HeterogeneousLookup) {
+  flat_hash_map<std::string, int, numsim_core::string_hash, std::equal_to<>>
+      map;
+  map["alpha"] = 1;
+  EXPECT_TRUE(map.contains(std::string_view("alpha")));
+  EXPECT_EQ(map.find("alpha")->second, 1);
+  EXPECT_EQ(map.find(std::string_view("beta")), map.end());
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <any>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <numsim-core/any_printer.h>
+#include <numsim-core/numsim_core_utility.h>
+
+using numsim_core::inplace_function;
+
+static int add_one(int value) { return value + 1; }
+
+// Test calling stored lambdas and function pointers
+TEST(InplaceFunctionTest, Call) {
+  const int offset{10};
+  inplace_function<int(int)> lambda{
+      [offset](int value) { return value + offset; }};
+  EXPECT_EQ(lambda(5), 15);
+  inplace_function<int(int)> pointer{&add_one};
+  EXPECT_EQ(pointer(5), 6);
+}
+
+// Test that mutable state of the callable persists across calls
+TEST(InplaceFunctionTest, MutableState) {
+  inplace_function<int()> counter{[count = 0]() mutable { return ++count; }};
+  EXPECT_EQ(counter(), 1);
+  EXPECT_EQ(counter(), 2);
+}
+
+// Test that references are passed through
+TEST(InplaceFunctionTest, ReferenceArguments) {
+  inplace_function<void(std::string &)> append{
+      [](std::string &text) { text += "!"; }};
+  std::string text{"done"};
+  append(text);
+  EXPECT_EQ(text, "done!");
+}
+
+// Test that an empty wrapper throws when called
+TEST(InplaceFunctionTest, EmptyThrows) {
+  inplace_function<void()> empty;
+  EXPECT_FALSE(empty);
+  EXPECT_THROW(empty(), std::bad_function_call);
+  inplace_function<void()> null{nullptr};
+  EXPECT_FALSE(null);
+}
+
+// Test moving transfers the callable and empties the source
+TEST(InplaceFunctionTest, MoveOnly) {
+  auto value{std::make_unique<int>(7)};
+  inplace_function<int()> source{[ptr = std::move(value)]() { return *ptr; }};
+  inplace_function<int()> target{std::move(source)};
+  EXPECT_FALSE(source);
+  EXPECT_EQ(target(), 7);
+
+  inplace_function<int()> assigned{[]() { return 1; }};
+  assigned = std::move(target);
+  EXPECT_FALSE(target);
+  EXPECT_EQ(assigned(), 7);
+}
+
+// Test that stored callables are destroyed exactly once
+TEST(InplaceFunctionTest, DestroysCallable) {
+  auto shared{std::make_shared<int>(1)};
+  {
+    inplace_function<void()> first{[shared]() {}};
+    EXPECT_EQ(shared.use_count(), 2);
+    inplace_function<void()> second{std::move(first)};
+    EXPECT_EQ(shared.use_count(), 2);
+    second = nullptr;
+    EXPECT_EQ(shared.use_count(), 1);
+    second = [shared]() {};
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+// Test that the print visitors built from inplace_function still print
+TEST(InplaceFunctionTest, PrintVisitors) {
+  std::ostringstream stream;
+  stream << numsim_core::any_print_wrapper(std::any(42)) << " "
+         << numsim_core::any_print_wrapper(std::any(std::string("text")));
+  EXPECT_EQ(stream.str(), "42 text");
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <utility>
 #include <numsim-core/parameter_handler.h>
 
 using numsim_core::parameter_handler;
@@ -73,3 +75,252 @@ TEST_F(ParameterHandlerTest, PrintContents) {
   EXPECT_NE(oss.str().find("key7"), std::string::npos);
   EXPECT_NE(oss.str().find("print_test"), std::string::npos);
 }
+
+// Test that the flat storage backend provides the same interface
+TEST(FlatParameterHandlerTest, InsertGetContains) {
+  numsim_core::flat_parameter_handler<> flat_handler;
+  flat_handler.insert("key1", 42);
+  flat_handler.insert("key2", std::string("value"));
+  EXPECT_EQ(flat_handler.get<int>("key1"), 42);
+  EXPECT_EQ(flat_handler.get<std::string>("key2"), "value");
+  EXPECT_TRUE(flat_handler.contains("key1"));
+  EXPECT_FALSE(flat_handler.contains("non_existent_key"));
+  EXPECT_EQ(std::any_cast<int>(flat_handler.data("key1")), 42);
+  EXPECT_THROW(flat_handler.get<int>("non_existent_key"),
+               std::invalid_argument);
+  flat_handler.clear();
+  EXPECT_FALSE(flat_handler.contains("key1"));
+}
+
+// Test reading and writing through a resolved handle
+TEST_F(ParameterHandlerTest, HandleAccess) {
+  handler.insert("key8", 3.5);
+  auto value{handler.resolve<double>("key8")};
+  EXPECT_TRUE(value.valid());
+  EXPECT_EQ(*value, 3.5);
+  *value = 4.5;
+  EXPECT_EQ(handler.get<double>("key8"), 4.5);
+}
+
+// Test that resolving a missing key or a wrong type throws
+TEST_F(ParameterHandlerTest, HandleResolveErrors) {
+  handler.insert("key9", 1);
+  EXPECT_THROW(handler.resolve<int>("non_existent_key"), std::invalid_argument);
+  EXPECT_THROW(handler.resolve<double>("key9"), std::bad_any_cast);
+}
+
+// Test that clear() invalidates outstanding handles
+TEST_F(ParameterHandlerTest, HandleInvalidatedByClear) {
+  handler.insert("key10", 1);
+  auto value{handler.resolve<int>("key10")};
+  handler.clear();
+  EXPECT_FALSE(value.valid());
+  EXPECT_THROW(value.get(), std::runtime_error);
+}
+
+// Test that overwriting a value invalidates outstanding handles
+TEST_F(ParameterHandlerTest, HandleInvalidatedByOverwrite) {
+  handler.insert("key11", 1);
+  auto value{handler.resolve<int>("key11")};
+  handler.insert("key12", 2);
+  EXPECT_TRUE(value.valid());
+  handler.insert("key11", 3);
+  EXPECT_FALSE(value.valid());
+}
+
+// Test that assigning or moving from a handler invalidates outstanding handles
+TEST_F(ParameterHandlerTest, HandleInvalidatedByAssignment) {
+  handler.insert("key13", 1);
+  auto copied{handler.resolve<int>("key13")};
+  handler = numsim_core::parameter_handler<>{};
+  EXPECT_FALSE(copied.valid());
+  EXPECT_THROW(copied.get(), std::runtime_error);
+
+  numsim_core::parameter_handler<> other;
+  other.insert("key13", 2);
+  auto moved{other.resolve<int>("key13")};
+  handler.insert("key13", 3);
+  auto replaced{handler.resolve<int>("key13")};
+  handler = std::move(other);
+  EXPECT_FALSE(moved.valid());
+  EXPECT_FALSE(replaced.valid());
+  EXPECT_EQ(handler.get<int>("key13"), 2);
+
+  auto kept{handler.resolve<int>("key13")};
+  const auto copy{handler};
+  EXPECT_TRUE(kept.valid());
+  const auto target{std::move(handler)};
+  EXPECT_FALSE(kept.valid());
+  EXPECT_EQ(copy.get<int>("key13"), 2);
+  EXPECT_EQ(target.get<int>("key13"), 2);
+}
+
+// Test that a pmr parameter handler allocates only from the given resource
+TEST(PmrParameterHandlerTest, AllocatesFromResource) {
+  std::pmr::monotonic_buffer_resource resource;
+  auto *previous{
+      std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+  {
+    const std::pmr::string first("a_rather_long_parameter_name_beyond_sso",
+                                 &resource);
+    const std::pmr::string second("another_rather_long_parameter_name",
+                                  &resource);
+    numsim_core::pmr::parameter_handler<> pmr_handler(&resource);
+    pmr_handler.insert(first, 1.0);
+    pmr_handler.insert(second, 2.0);
+    EXPECT_EQ(pmr_handler.get<double>(first), 1.0);
+    EXPECT_EQ(pmr_handler.get<double>(second), 2.0);
+
+    numsim_core::pmr::flat_parameter_handler<> flat_handler(&resource);
+    flat_handler.insert(first, 3);
+    EXPECT_EQ(flat_handler.get<int>(first), 3);
+  }
+  std::pmr::set_default_resource(previous);
+}
+
+TEST_F(ParameterHandlerTest, FindReturnsStoredValue) {
+  handler.insert("key", 3);
+  auto *value{handler.find("key")};
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(std::any_cast<int>(*value), 3);
+  EXPECT_EQ(handler.find("missing"), nullptr);
+
+  const auto &const_handler{handler};
+  EXPECT_EQ(const_handler.find("key"), value);
+}
+
+TEST(PmrParameterHandlerTest, StringViewLookupDoesNotAllocate) {
+  std::pmr::monotonic_buffer_resource resource;
+  numsim_core::pmr::parameter_handler<> pmr_handler(&resource);
+  numsim_core::pmr::flat_parameter_handler<> flat_handler(&resource);
+  pmr_handler.insert(
+      std::pmr::string("a_rather_long_parameter_name_beyond_sso", &resource),
+      1.0);
+  flat_handler.insert(
+      std::pmr::string("a_rather_long_parameter_name_beyond_sso", &resource),
+      2.0);
+  auto *previous{
+      std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+  // A temporary key would be allocated from the null resource and throw
+  EXPECT_EQ(pmr_handler.get<double>("a_rather_long_parameter_name_beyond_sso"),
+            1.0);
+  EXPECT_TRUE(pmr_handler.contains(
+      std::string_view("a_rather_long_parameter_name_beyond_sso")));
+  EXPECT_NE(pmr_handler.find("a_rather_long_parameter_name_beyond_sso"),
+            nullptr);
+  EXPECT_EQ(flat_handler.get<double>("a_rather_long_parameter_name_beyond_sso"),
+            2.0);
+  EXPECT_FALSE(flat_handler.contains("a_missing_parameter_name_beyond_sso"));
+  EXPECT_THROW(pmr_handler.get<double>("a_missing_parameter_name_beyond_sso"),
+               std::invalid_argument);
+  std::pmr::set_default_resource(previous);
+}
+
+TEST_F(ParameterHandlerTest, StringViewLookup) {
+  handler.insert("key", 3);
+  const std::string_view name{"key"};
+  EXPECT_EQ(handler.get<int>(name), 3);
+  EXPECT_EQ(handler.data(name).type(), typeid(int));
+  EXPECT_EQ(*handler.resolve<int>(name), 3);
+}
+
+// Deferred values are computed on first access and cached
+TEST_F(ParameterHandlerTest, DeferredComputedOnce) {
+  int calls{0};
+  handler.insert("E", 200.0);
+  handler.insert("nu", 0.25);
+  handler.insert_deferred("mu", {"E", "nu"}, [&calls](auto const &h) {
+    ++calls;
+    return h.template get<double>("E") /
+           (2.0 * (1.0 + h.template get<double>("nu")));
+  });
+  EXPECT_EQ(calls, 0);
+  EXPECT_TRUE(handler.contains("mu"));
+  EXPECT_EQ(handler.get<double>("mu"), 80.0);
+  EXPECT_EQ(std::as_const(handler).get<double>("mu"), 80.0);
+  EXPECT_NE(handler.find("mu"), nullptr);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(handler.size(), 2u);
+}
+
+// Overwriting a dependency recomputes the value and its dependents
+TEST_F(ParameterHandlerTest, DeferredInvalidatedByDependency) {
+  int calls{0};
+  handler.insert("E", 200.0);
+  handler.insert("nu", 0.25);
+  handler.insert_deferred("mu", {"E", "nu"}, [](auto const &h) {
+    return h.template get<double>("E") /
+           (2.0 * (1.0 + h.template get<double>("nu")));
+  });
+  handler.insert_deferred("two_mu", {"mu"}, [&calls](auto const &h) {
+    ++calls;
+    return 2.0 * h.template get<double>("mu");
+  });
+  auto mu{handler.resolve<double>("mu")};
+  EXPECT_EQ(handler.get<double>("two_mu"), 160.0);
+
+  handler.insert("unrelated", 1);
+  EXPECT_EQ(handler.get<double>("two_mu"), 160.0);
+  EXPECT_EQ(calls, 1);
+
+  handler.insert("E", 100.0);
+  EXPECT_FALSE(mu.valid());
+  EXPECT_EQ(handler.get<double>("mu"), 40.0);
+  EXPECT_EQ(handler.get<double>("two_mu"), 80.0);
+  EXPECT_EQ(calls, 2);
+}
+
+// A copy changing a dependency before either computed the value gets its own
+// cache
+TEST_F(ParameterHandlerTest, DeferredCopyBeforeFirstAccess) {
+  handler.insert("E", 1.0);
+  handler.insert_deferred("mu", {"E"}, [](auto const &h) {
+    return h.template get<double>("E") * 10.0;
+  });
+  auto copy{handler};
+  copy.insert("E", 2.0);
+  EXPECT_EQ(handler.get<double>("mu"), 10.0);
+  EXPECT_EQ(copy.get<double>("mu"), 20.0);
+}
+
+// Replacing a deferred value by an explicit one invalidates its handles
+TEST_F(ParameterHandlerTest, DeferredReplacedInvalidatesHandles) {
+  handler.insert("E", 1.0);
+  handler.insert_deferred("mu", {"E"}, [](auto const &h) {
+    return h.template get<double>("E") * 10.0;
+  });
+  auto mu{handler.resolve<double>("mu")};
+  EXPECT_EQ(*mu, 10.0);
+  handler.insert("mu", 5.0);
+  EXPECT_FALSE(mu.valid());
+  EXPECT_THROW(mu.get(), std::runtime_error);
+  EXPECT_EQ(*handler.resolve<double>("mu"), 5.0);
+}
+
+// Explicit values replace deferred ones, failing producers are retried
+TEST_F(ParameterHandlerTest, DeferredReplacedAndRetried) {
+  handler.insert_deferred("area", {"width"}, [](auto const &h) {
+    return h.template get<double>("width") * 2.0;
+  });
+  EXPECT_THROW(handler.get<double>("area"), std::invalid_argument);
+  handler.insert("width", 3.0);
+  EXPECT_EQ(handler.get<double>("area"), 6.0);
+
+  handler.insert("area", 1.0);
+  handler.insert("width", 4.0);
+  EXPECT_EQ(handler.get<double>("area"), 1.0);
+
+  handler.insert_deferred("area", {"width"}, [](auto const &h) {
+    return h.template get<double>("width");
+  });
+  EXPECT_EQ(handler.get<double>("area"), 4.0);
+  EXPECT_EQ(handler.size(), 1u);
+
+  auto copy{handler};
+  copy.insert("width", 5.0);
+  EXPECT_EQ(copy.get<double>("area"), 5.0);
+  EXPECT_EQ(handler.get<double>("area"), 4.0);
+
+  handler.clear();
+  EXPECT_FALSE(handler.contains("area"));
+}
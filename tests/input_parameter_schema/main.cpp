@@ -0,0 +1,78 @@
+#include "numsim-core/input_parameter_schema.h"
+#include "numsim-core/parameter_handler.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using numsim_core::input_parameter_schema;
+using numsim_core::parameter_handler;
+namespace schema = numsim_core::schema;
+
+using handler_type = parameter_handler<>;
+
+// Unit tests for the compile-time input parameter schema
+class InputParameterSchemaTest : public ::testing::Test {
+protected:
+  handler_type handler;
+};
+
+TEST_F(InputParameterSchemaTest, TestRequiredParameterPresent) {
+  using schema_type =
+      input_parameter_schema<std::string, handler_type,
+                             schema::parameter<"test_param", int,
+                                               schema::is_required>>;
+  handler.insert("test_param", 42);
+  EXPECT_NO_THROW(schema_type::check_parameter(handler));
+}
+
+TEST_F(InputParameterSchemaTest, TestRequiredParameterMissing) {
+  using schema_type =
+      input_parameter_schema<std::string, handler_type,
+                             schema::parameter<"missing_param", int,
+                                               schema::is_required>>;
+  EXPECT_THROW(schema_type::check_parameter(handler), std::invalid_argument);
+}
+
+TEST_F(InputParameterSchemaTest, TestParameterRange) {
+  using schema_type = input_parameter_schema<
+      std::string, handler_type,
+      schema::parameter<"range_param", int, schema::check_range<0, 100>>>;
+  handler.insert("range_param", 50);
+  EXPECT_NO_THROW(schema_type::check_parameter(handler));
+  handler.insert("range_param", 150);
+  EXPECT_THROW(schema_type::check_parameter(handler), std::invalid_argument);
+}
+
+TEST_F(InputParameterSchemaTest, TestSetDefaultValue) {
+  using schema_type = input_parameter_schema<
+      std::string, handler_type,
+      schema::parameter<"default_param", int, schema::set_default<99>>,
+      schema::parameter<"param_with_default", std::string,
+                        schema::set_default_string<"default_value">>>;
+  handler.insert("default_param", 42);
+  schema_type::check_parameter(handler);
+  EXPECT_EQ(handler.get<int>("default_param"), 42);
+  EXPECT_EQ(handler.get<std::string>("param_with_default"), "default_value");
+}
+
+TEST_F(InputParameterSchemaTest, TestMultipleChecks) {
+  using schema_type = input_parameter_schema<
+      std::string, handler_type,
+      schema::parameter<"multi_param", double, schema::set_default<50.0>,
+                        schema::is_required, schema::check_range<0.0, 100.0>,
+                        schema::check_data_type>>;
+  EXPECT_EQ(schema_type::size(), 1u);
+  schema_type::check_parameter(handler);
+  EXPECT_EQ(handler.get<double>("multi_param"), 50.0);
+  handler.insert("multi_param", 150.0);
+  EXPECT_THROW(schema_type::check_parameter(handler), std::invalid_argument);
+}
+
+TEST_F(InputParameterSchemaTest, TestInvalidType) {
+  using schema_type = input_parameter_schema<
+      std::string, handler_type,
+      schema::parameter<"param_with_wrong_type", int,
+                        schema::check_data_type>>;
+  handler.insert("param_with_wrong_type", std::string("not_an_int"));
+  EXPECT_THROW(schema_type::check_parameter(handler), std::bad_any_cast);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <numsim-core/input_parameter_controller.h>
+#include <numsim-core/input_parser.h>
+#include <numsim-core/parameter_handler.h>
+
+using numsim_core::config_reader;
+using numsim_core::input_parser;
+using numsim_core::parameter_handler;
+using controller_type =
+    numsim_core::input_parameter_controller<std::string, parameter_handler<>>;
+
+namespace {
+// argv of a command line, kept alive for the parser
+struct command_line {
+  explicit command_line(std::vector<std::string> args)
+      : m_args(std::move(args)) {
+    for (auto &arg : m_args) {
+      m_argv.push_back(arg.data());
+    }
+    m_argc = static_cast<int>(m_argv.size());
+  }
+
+  std::vector<std::string> m_args;
+  std::vector<char *> m_argv;
+  int m_argc;
+};
+
+// Counts how often the parameter is checked
+template <typename T, typename KeyType, typename ParameterHandler>
+class count_checks final
+    : public numsim_core::input_parameter_check_base<T, KeyType,
+                                                     ParameterHandler> {
+  using base =
+      numsim_core::input_parameter_check_base<T, KeyType, ParameterHandler>;
+
+public:
+  count_checks(numsim_core::input_parameter<T, KeyType, ParameterHandler> const
+                   &para,
+               int &count)
+      : base(para), m_count(count) {}
+
+  void check(ParameterHandler &,
+             typename base::value_pointer &) const override {
+    ++m_count;
+  }
+
+private:
+  int &m_count;
+};
+} // namespace
+
+// Values are parsed with from_chars
+TEST(ParseValueTest, ParsesTypes) {
+  using numsim_core::detail::parse_value;
+  EXPECT_EQ(parse_value<int>(" 42 "), 42);
+  EXPECT_EQ(parse_value<int>("+7"), 7);
+  EXPECT_EQ(parse_value<double>("2.1e5"), 2.1e5);
+  EXPECT_TRUE(parse_value<bool>("true"));
+  EXPECT_FALSE(parse_value<bool>("0"));
+  EXPECT_EQ(parse_value<std::string>(" steel "), "steel");
+  EXPECT_EQ(parse_value<std::vector<double>>("1, 2.5 3"),
+            (std::vector<double>{1.0, 2.5, 3.0}));
+  EXPECT_THROW(parse_value<int>("4x"), std::invalid_argument);
+  EXPECT_THROW(parse_value<bool>("yes"), std::invalid_argument);
+}
+
+// Arguments are views into argv with the leading dashes stripped
+TEST(InputParserTest, ParsesArguments) {
+  command_line args({"program", "--mesh", "beam.msh", "-verbose", "--steps",
+                     "10"});
+  const input_parser parser(args.m_argc, args.m_argv.data());
+  EXPECT_EQ(parser.value("mesh"), "beam.msh");
+  EXPECT_TRUE(parser.contains("verbose"));
+  EXPECT_EQ(parser.value("verbose"), "");
+  EXPECT_EQ(parser.get<int>("steps"), 10);
+  EXPECT_EQ(parser.value("mesh").data(), args.m_argv[2]);
+  EXPECT_THROW((void)parser.value("missing"), std::runtime_error);
+}
+
+// Registered arguments get their type, others are inferred
+TEST(InputParserTest, ParsesIntoHandler) {
+  command_line args({"program", "--E", "210000", "--nu", "0.3", "--name",
+                     "steel"});
+  const input_parser parser(args.m_argc, args.m_argv.data());
+  controller_type controller;
+  controller.insert<double>("E").add<numsim_core::is_required>();
+  controller.insert<int>("steps").add<numsim_core::set_default>(5);
+
+  parameter_handler<> handler;
+  parser.parse(handler, controller);
+  EXPECT_EQ(handler.get<double>("E"), 210000.0);
+  EXPECT_EQ(handler.get<double>("nu"), 0.3);
+  EXPECT_EQ(handler.get<std::string>("name"), "steel");
+  EXPECT_EQ(handler.get<int>("steps"), 5);
+}
+
+// Entries of a file are handed out with their section
+TEST(ConfigReaderTest, ReadsEntries) {
+  std::istringstream input("# comment\n"
+                           "E = 210000\n"
+                           "\n"
+                           "[plastic]\r\n"
+                           "  yield=250.5  \n"
+                           "; comment\n"
+                           "name = st eel");
+  config_reader reader(input);
+  std::vector<std::pair<std::string, std::string>> entries;
+  reader.for_each([&](std::string_view key, std::string_view value) {
+    entries.emplace_back(key, value);
+  });
+  const std::vector<std::pair<std::string, std::string>> expected{
+      {"E", "210000"}, {"plastic.yield", "250.5"}, {"plastic.name", "st eel"}};
+  EXPECT_EQ(entries, expected);
+  EXPECT_EQ(reader.line(), 7u);
+}
+
+// Lines spanning block boundaries are reassembled
+TEST(ConfigReaderTest, SmallBlocks) {
+  std::string text;
+  for (int i = 0; i < 100; ++i) {
+    text += "a_rather_long_key_name_" + std::to_string(i) + " = " +
+            std::to_string(i) + "\n";
+  }
+  text += "a_value_longer_than_the_block = " + std::string(200, 'x') + "\n";
+  std::istringstream input(text);
+  parameter_handler<> handler;
+  config_reader(input, 64).read(handler);
+  EXPECT_EQ(handler.size(), 101u);
+  EXPECT_EQ(handler.get<int>("a_rather_long_key_name_99"), 99);
+  EXPECT_EQ(handler.get<std::string>("a_value_longer_than_the_block"),
+            std::string(200, 'x'));
+}
+
+// Registered parameters are parsed and checked in the same pass
+TEST(ConfigReaderTest, ValidatesWithController) {
+  controller_type controller;
+  controller.insert<double>("E")
+      .add<numsim_core::is_required>()
+      .add<numsim_core::check_range>(0.0, 1.0e6);
+  controller.insert<std::vector<int>>("nodes");
+  controller.insert<int>("steps").add<numsim_core::set_default>(5);
+
+  std::istringstream input("E = 210000\nnodes = 1, 2, 3\nlabel = beam\n");
+  parameter_handler<> handler;
+  config_reader(input).read(handler, controller);
+  EXPECT_EQ(handler.get<double>("E"), 210000.0);
+  EXPECT_EQ(handler.get<std::vector<int>>("nodes"),
+            (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(handler.get<std::string>("label"), "beam");
+  EXPECT_EQ(handler.get<int>("steps"), 5);
+}
+
+// Parsed parameters are checked once, missing ones after reading
+TEST(ConfigReaderTest, ChecksEveryParameterOnce) {
+  int parsed{0};
+  int missing{0};
+  controller_type controller;
+  controller.insert<double>("E").add<count_checks>(parsed);
+  controller.insert<int>("steps")
+      .add<count_checks>(missing)
+      .add<numsim_core::set_default>(5);
+
+  std::istringstream input("E = 210000\n");
+  parameter_handler<> handler;
+  config_reader(input).read(handler, controller);
+  EXPECT_EQ(parsed, 1);
+  EXPECT_EQ(missing, 1);
+  EXPECT_EQ(handler.get<int>("steps"), 5);
+
+  command_line args({"program", "--E", "1.0"});
+  parameter_handler<> arguments;
+  input_parser(args.m_argc, args.m_argv.data()).parse(arguments, controller);
+  EXPECT_EQ(parsed, 2);
+  EXPECT_EQ(missing, 2);
+}
+
+// Errors report the line
+TEST(ConfigReaderTest, ErrorsReportLine) {
+  controller_type controller;
+  controller.insert<double>("E").add<numsim_core::check_range>(0.0, 1.0);
+  controller.insert<int>("steps");
+
+  {
+    std::istringstream input("E = 0.5\nsteps = ten\n");
+    parameter_handler<> handler;
+    try {
+      config_reader(input).read(handler, controller);
+      FAIL() << "expected std::invalid_argument";
+    } catch (std::invalid_argument const &error) {
+      EXPECT_NE(std::string(error.what()).find("line 2"), std::string::npos);
+    }
+  }
+  {
+    std::istringstream input("E = 2\n");
+    parameter_handler<> handler;
+    EXPECT_THROW(config_reader(input).read(handler, controller),
+                 std::invalid_argument);
+  }
+  {
+    std::istringstream input("E 2\n");
+    parameter_handler<> handler;
+    EXPECT_THROW(config_reader(input).read(handler), std::invalid_argument);
+  }
+  {
+    std::istringstream input("[section\n");
+    parameter_handler<> handler;
+    EXPECT_THROW(config_reader(input).read(handler), std::invalid_argument);
+  }
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <any>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <numsim-core/input_parameter_controller.h>
+#include <numsim-core/instrumentation.h>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/query_map.h>
+
+using numsim_core::instrumentation;
+using numsim_core::key_statistics;
+
+namespace {
+enum class field { displacement = 3 };
+} // namespace
+
+class InstrumentationTest : public ::testing::Test {
+protected:
+  void SetUp() override { instrumentation::instance().reset(); }
+
+  void TearDown() override { instrumentation::instance().reset(); }
+};
+
+// Calls are counted per site and key with a latency histogram
+TEST_F(InstrumentationTest, RecordsStatistics) {
+  auto &data{instrumentation::instance()};
+  data.record("site", "E", std::chrono::nanoseconds(5), false);
+  data.record("site", "E", std::chrono::nanoseconds(100), true);
+  data.record("other", "E", std::chrono::nanoseconds(0), false);
+
+  const auto statistics{data.statistics("site", "E")};
+  ASSERT_TRUE(statistics.has_value());
+  EXPECT_EQ(statistics->m_lookups, 2u);
+  EXPECT_EQ(statistics->m_misses, 1u);
+  EXPECT_EQ(statistics->m_total_ns, 105u);
+  EXPECT_EQ(statistics->m_histogram[key_statistics::bucket(5)], 1u);
+  EXPECT_EQ(statistics->m_histogram[key_statistics::bucket(100)], 1u);
+  EXPECT_EQ(key_statistics::bucket(0), 0u);
+  EXPECT_EQ(key_statistics::bucket(4), 3u);
+  EXPECT_EQ(key_statistics::bucket(~0ull), key_statistics::bucket_count - 1);
+  EXPECT_FALSE(data.statistics("site", "nu").has_value());
+  EXPECT_FALSE(data.statistics("missing", "E").has_value());
+}
+
+// The report and the JSON list the most expensive key first
+TEST_F(InstrumentationTest, ExportsReportAndJson) {
+  auto &data{instrumentation::instance()};
+  data.record("site", "cheap", std::chrono::nanoseconds(1), false);
+  data.record("site", "a \"quoted\"\n key", std::chrono::nanoseconds(2000),
+              false);
+
+  std::ostringstream report;
+  data.report(report);
+  const auto text{report.str()};
+  EXPECT_NE(text.find("lookups"), std::string::npos);
+  EXPECT_LT(text.find("quoted"), text.find("cheap"));
+
+  std::ostringstream json;
+  data.write_json(json);
+  const auto document{json.str()};
+  EXPECT_EQ(document.rfind("{\"entries\":[{\"site\":\"site\",\"key\":\"a "
+                           "\\\"quoted\\\"\\u000a key\",\"lookups\":1,"
+                           "\"misses\":0,\"total_ns\":2000,\"histogram\":[",
+                           0),
+            0u);
+  EXPECT_EQ(document.substr(document.size() - 4), "]}]}");
+}
+
+// Keys are formatted by value
+TEST_F(InstrumentationTest, FormatsKeys) {
+  using numsim_core::detail::instrumentation_key;
+  EXPECT_EQ(instrumentation_key(std::string("E")), "E");
+  EXPECT_EQ(instrumentation_key(42), "42");
+  EXPECT_EQ(instrumentation_key(field::displacement), "3");
+  EXPECT_EQ(instrumentation_key(std::make_tuple(1, std::string("u"))),
+            "(1, u)");
+}
+
+// With NUMSIM_CORE_INSTRUMENTATION the hot paths record their keys
+TEST_F(InstrumentationTest, InstrumentsHotPaths) {
+  if constexpr (!instrumentation::enabled) {
+    GTEST_SKIP() << "built without NUMSIM_CORE_INSTRUMENTATION";
+  }
+  numsim_core::parameter_handler<> handler;
+  handler.insert("E", 210000.0);
+  (void)handler.get<double>("E");
+  (void)handler.get<double>("E");
+  EXPECT_THROW((void)handler.get<double>("nu"), std::invalid_argument);
+
+  numsim_core::input_parameter_controller<std::string,
+                                          numsim_core::parameter_handler<>>
+      controller;
+  controller.insert<double>("E").add<numsim_core::check_range>(0.0, 1.0);
+  EXPECT_THROW(controller.check_parameter(handler), std::invalid_argument);
+
+  numsim_core::query_map<std::tuple<int, std::string>, std::unordered_map>
+      map;
+  map.set(std::any(1), 2, std::string("u"));
+  (void)map.get(2, std::string("u"));
+
+  auto &data{instrumentation::instance()};
+  EXPECT_EQ(data.statistics("parameter_handler::get", "E")->m_lookups, 2u);
+  EXPECT_EQ(data.statistics("parameter_handler::get", "nu")->m_misses, 1u);
+  EXPECT_EQ(data.statistics("input_parameter_controller::check_parameter", "E")
+                ->m_misses,
+            1u);
+  EXPECT_EQ(data.statistics("query_map::get", "(2, u)")->m_lookups, 1u);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <any>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <numsim-core/input_parameter_controller.h>
+#include <numsim-core/layered_parameter_handler.h>
+#include <numsim-core/parameter_handler.h>
+
+using numsim_core::layered_parameter_handler;
+
+// Lookups resolve through the chain, the nearest layer wins
+TEST(LayeredParameterHandlerTest, ResolvesThroughChain) {
+  numsim_core::parameter_handler<> base;
+  base.insert("E", 210000.0);
+  base.insert("nu", 0.3);
+
+  layered_parameter_handler<> material(base);
+  material.insert("name", std::string("steel"));
+  auto element{material.child()};
+  element.insert("E", 190000.0);
+
+  EXPECT_EQ(element.get<double>("E"), 190000.0);
+  EXPECT_EQ(element.get<double>(std::string_view("nu")), 0.3);
+  EXPECT_EQ(element.get<std::string>("name"), "steel");
+  EXPECT_EQ(material.get<double>("E"), 210000.0);
+  EXPECT_TRUE(element.contains("nu"));
+  EXPECT_FALSE(element.contains("rho"));
+  EXPECT_THROW((void)element.get<double>("rho"), std::invalid_argument);
+  EXPECT_EQ(element.overrides().size(), 1u);
+  EXPECT_EQ(element.depth(), 3u);
+  EXPECT_EQ(element.parent(), &material);
+}
+
+// Copies share the parent and only copy their overrides
+TEST(LayeredParameterHandlerTest, CopiesShareParent) {
+  layered_parameter_handler<> material;
+  material.insert("E", 210000.0);
+  std::vector<layered_parameter_handler<>> elements(3, material.child());
+  elements[1].insert("E", 1.0);
+  material.insert("nu", 0.3);
+
+  EXPECT_EQ(elements[0].get<double>("E"), 210000.0);
+  EXPECT_EQ(elements[1].get<double>("E"), 1.0);
+  EXPECT_EQ(elements[2].get<double>("nu"), 0.3);
+  EXPECT_EQ(elements[0].overrides().size(), 0u);
+}
+
+// modify copies an inherited value into the layer
+TEST(LayeredParameterHandlerTest, CopyOnWrite) {
+  layered_parameter_handler<> material;
+  material.insert("nodes", std::vector<int>{1, 2});
+  auto element{material.child()};
+  element.modify<std::vector<int>>("nodes").push_back(3);
+
+  EXPECT_EQ(element.get<std::vector<int>>("nodes"),
+            (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(material.get<std::vector<int>>("nodes"),
+            (std::vector<int>{1, 2}));
+  EXPECT_THROW((void)element.modify<int>("missing"), std::invalid_argument);
+}
+
+// Flattening copies the chain, nearer layers win, and detaches the layer
+TEST(LayeredParameterHandlerTest, Flatten) {
+  numsim_core::parameter_handler<> base;
+  base.insert("E", 210000.0);
+  base.insert("nu", 0.3);
+  layered_parameter_handler<> flat;
+  {
+    layered_parameter_handler<> material(base);
+    material.insert("nu", 0.25);
+    flat = material.child();
+    flat.insert("rho", 7.85);
+    flat.flatten();
+  }
+  EXPECT_EQ(flat.depth(), 1u);
+  EXPECT_EQ(flat.overrides().size(), 3u);
+  EXPECT_EQ(flat.get<double>("E"), 210000.0);
+  EXPECT_EQ(flat.get<double>("nu"), 0.25);
+  EXPECT_EQ(flat.get<double>("rho"), 7.85);
+}
+
+// Flattening keeps deferred values of the base as they resolve in the chain
+TEST(LayeredParameterHandlerTest, FlattenDeferred) {
+  numsim_core::parameter_handler<> base;
+  base.insert("E", 2.0);
+  base.insert_deferred("twice", {"E"}, [](auto const &handler) {
+    return 2.0 * handler.template get<double>("E");
+  });
+  layered_parameter_handler<> layer(base);
+  layer.insert("E", 5.0);
+  EXPECT_EQ(layer.get<double>("twice"), 4.0);
+
+  layer.flatten();
+  EXPECT_EQ(layer.overrides().size(), 2u);
+  EXPECT_EQ(layer.get<double>("E"), 5.0);
+  EXPECT_EQ(layer.get<double>("twice"), 4.0);
+}
+
+// Defaults of the shared parent are not duplicated into the children
+TEST(LayeredParameterHandlerTest, ControllerDefaults) {
+  using handler_type = layered_parameter_handler<>;
+  numsim_core::input_parameter_controller<std::string, handler_type> controller;
+  controller.insert<double>("E")
+      .add<numsim_core::is_required>()
+      .add<numsim_core::check_range>(0.0, 1.0e6);
+  controller.insert<int>("steps").add<numsim_core::set_default>(5);
+
+  handler_type material;
+  material.insert("E", 210000.0);
+  controller.check_parameter(material);
+  EXPECT_EQ(material.get<int>("steps"), 5);
+
+  std::vector<handler_type> elements(4, material.child());
+  elements[2].insert("E", 2.0e6);
+  const auto errors{controller.check_parameter(elements)};
+  ASSERT_EQ(errors.size(), 1u);
+  EXPECT_EQ(errors[0].m_index, 2u);
+  for (const auto &element : elements) {
+    EXPECT_FALSE(element.overrides().contains("steps"));
+    EXPECT_EQ(element.get<int>("steps"), 5);
+  }
+}
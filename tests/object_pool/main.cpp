@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <numsim-core/object_pool.h>
+
+using numsim_core::object_pool;
+
+struct pooled_value {
+  explicit pooled_value(int value) : m_value(value) {}
+  int m_value;
+  std::string m_name{"a_string_member_longer_than_the_sso_buffer"};
+};
+
+struct throwing_value {
+  throwing_value() { throw std::runtime_error("construction failed"); }
+};
+
+// Test that destroyed storage is reused
+TEST(ObjectPoolTest, RecyclesStorage) {
+  object_pool<pooled_value, 4> pool;
+  auto *first{pool.create(1)};
+  EXPECT_EQ(first->m_value, 1);
+  EXPECT_EQ(pool.size(), 1u);
+  pool.destroy(first);
+  EXPECT_EQ(pool.size(), 0u);
+  auto *second{pool.create(2)};
+  EXPECT_EQ(static_cast<void *>(second), static_cast<void *>(first));
+  pool.destroy(second);
+}
+
+// Test that the pool grows by whole slabs and keeps its capacity
+TEST(ObjectPoolTest, GrowsBySlabs) {
+  object_pool<pooled_value, 4> pool;
+  std::vector<pooled_value *> objects;
+  for (int i = 0; i < 10; ++i) {
+    objects.push_back(pool.create(i));
+  }
+  EXPECT_EQ(pool.capacity(), 12u);
+  std::set<pooled_value *> unique(objects.begin(), objects.end());
+  EXPECT_EQ(unique.size(), objects.size());
+  for (auto *object : objects) {
+    pool.destroy(object);
+  }
+  for (int round = 0; round < 100; ++round) {
+    pool.destroy(pool.create(round));
+  }
+  EXPECT_EQ(pool.capacity(), 12u);
+  EXPECT_EQ(pool.size(), 0u);
+}
+
+// Test that a throwing constructor returns the storage
+TEST(ObjectPoolTest, ThrowingConstructor) {
+  object_pool<throwing_value, 2> pool;
+  EXPECT_THROW(static_cast<void>(pool.create()), std::runtime_error);
+  EXPECT_EQ(pool.size(), 0u);
+}
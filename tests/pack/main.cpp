@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <any>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <numsim-core/pack.h>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/query_map.h>
+
+using numsim_core::pack;
+using numsim_core::unpack;
+
+using model_map = numsim_core::query_map<std::tuple<int, std::string>,
+                                         std::unordered_map>;
+using flat_model_map =
+    numsim_core::flat_query_map<std::tuple<int, std::string>,
+                                std::unordered_map>;
+
+namespace {
+template <typename Map> Map make_map() {
+  Map map;
+  map.set(std::any(1.5), 1, std::string("E"));
+  map.set(std::any(std::string("steel")), 1, std::string("name"));
+  map.set(std::any(std::vector<double>{1.0, 2.0}), 2, std::string("E"));
+  return map;
+}
+} // namespace
+
+// A packed handler unpacks into an equal handler
+TEST(PackTest, HandlerRoundTrip) {
+  numsim_core::parameter_handler<> handler;
+  handler.insert("E", 210.0);
+  handler.insert("nodes", std::vector<int>{1, 2, 3});
+
+  numsim_core::parameter_handler<> restored;
+  unpack(pack(handler), restored);
+  EXPECT_EQ(restored.size(), 2u);
+  EXPECT_EQ(restored.get<double>("E"), 210.0);
+  EXPECT_EQ(restored.get<std::vector<int>>("nodes"),
+            (std::vector<int>{1, 2, 3}));
+}
+
+// Deferred values are packed as computed values
+TEST(PackTest, HandlerDeferredValues) {
+  numsim_core::parameter_handler<> handler;
+  handler.insert("E", 210.0);
+  handler.insert_deferred("half", {"E"}, [](auto const &h) {
+    return h.template get<double>("E") / 2.0;
+  });
+
+  numsim_core::parameter_handler<> restored;
+  unpack(pack(handler), restored);
+  EXPECT_EQ(restored.size(), 2u);
+  EXPECT_EQ(restored.get<double>("half"), 105.0);
+}
+
+// Unpacking into a pmr handler allocates keys from its resource
+TEST(PackTest, PmrHandlerUsesResource) {
+  numsim_core::parameter_handler<> handler;
+  handler.insert("a_rather_long_parameter_name_beyond_sso", 1.0);
+  handler.insert("another_rather_long_parameter_name", 2);
+  const auto buffer{pack(handler)};
+
+  std::pmr::monotonic_buffer_resource resource;
+  auto *previous{
+      std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+  {
+    numsim_core::pmr::parameter_handler<> restored(&resource);
+    unpack(buffer, restored);
+    EXPECT_EQ(restored.get<double>("a_rather_long_parameter_name_beyond_sso"),
+              1.0);
+    EXPECT_EQ(restored.get<int>("another_rather_long_parameter_name"), 2);
+  }
+  std::pmr::set_default_resource(previous);
+}
+
+// A packed query_map unpacks with its key tuples
+TEST(PackTest, QueryMapRoundTrip) {
+  const auto map{make_map<model_map>()};
+  model_map restored;
+  unpack(pack(map), restored);
+  EXPECT_EQ(std::any_cast<double>(restored.get(1, std::string("E"))), 1.5);
+  EXPECT_EQ(std::any_cast<std::string>(restored.get(1, std::string("name"))),
+            "steel");
+  EXPECT_EQ(
+      std::any_cast<std::vector<double>>(restored.get(2, std::string("E"))),
+      (std::vector<double>{1.0, 2.0}));
+}
+
+// Only the values below the prefix are packed
+TEST(PackTest, QueryMapSubtree) {
+  const auto map{make_map<model_map>()};
+  model_map restored;
+  unpack(pack(map, 1), restored);
+  EXPECT_EQ(std::any_cast<double>(restored.get(1, std::string("E"))), 1.5);
+  EXPECT_THROW(restored.get(2, std::string("E")), std::invalid_argument);
+
+  const auto single{pack(map, 2, std::string("E"))};
+  EXPECT_EQ(numsim_core::snapshot_view(single).size(), 1u);
+}
+
+// Flat and nested maps share the packed layout
+TEST(PackTest, FlatQueryMapRoundTrip) {
+  const auto map{make_map<flat_model_map>()};
+  model_map nested;
+  unpack(pack(map), nested);
+  EXPECT_EQ(std::any_cast<double>(nested.get(1, std::string("E"))), 1.5);
+
+  flat_model_map restored;
+  unpack(pack(nested, 1), restored);
+  EXPECT_EQ(restored.size(), 2u);
+  EXPECT_EQ(std::any_cast<std::string>(restored.get(1, std::string("name"))),
+            "steel");
+}
+
+// A buffer with mismatching key types is rejected
+TEST(PackTest, KeyMismatchThrows) {
+  numsim_core::parameter_handler<> handler;
+  handler.insert("E", 210.0);
+  const auto buffer{pack(handler)};
+  model_map map;
+  EXPECT_THROW(unpack(buffer, map), std::runtime_error);
+}
+
+// broadcast() sends the size and the buffer through the given function
+TEST(PackTest, Broadcast) {
+  model_map root{make_map<model_map>()};
+  std::vector<std::vector<std::byte>> sent;
+  numsim_core::broadcast(root, true, [&](void *data, std::size_t size) {
+    auto const *bytes{static_cast<std::byte const *>(data)};
+    sent.emplace_back(bytes, bytes + size);
+  });
+  ASSERT_EQ(sent.size(), 2u);
+
+  model_map receiver;
+  std::size_t call{0};
+  numsim_core::broadcast(receiver, false, [&](void *data, std::size_t size) {
+    ASSERT_EQ(size, sent[call].size());
+    std::memcpy(data, sent[call].data(), size);
+    ++call;
+  });
+  EXPECT_EQ(call, 2u);
+  EXPECT_EQ(std::any_cast<double>(receiver.get(1, std::string("E"))), 1.5);
+}
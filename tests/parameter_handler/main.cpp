@@ -1,9 +1,11 @@
 #include "numsim-core/input_parameter_controller.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 using numsim_core::check_data_type;
 using numsim_core::check_range;
@@ -14,6 +16,8 @@ using numsim_core::set_default;
 // Mock implementation of ParameterHandler for tests
 class MockParameterHandler {
 public:
+  using type_erasure_type = std::any;
+
   bool contains(const std::string &name) const {
     return parameters.find(name) != parameters.end();
   }
@@ -26,6 +30,11 @@ public:
     parameters[name] = value;
   }
 
+  std::any *find(const std::string &name) {
+    auto pos{parameters.find(name)};
+    return pos == parameters.end() ? nullptr : &pos->second;
+  }
+
 private:
   std::unordered_map<std::string, std::any> parameters;
 };
@@ -211,3 +220,132 @@ TEST_F(InputParameterTest, TestMultipleChecks_Fail) {
   // This should fail the test because the value is out of the allowed range
   EXPECT_THROW(paramController.check_parameter(handler), std::invalid_argument);
 }
+
+TEST(InputParameterBatchTest, CollectsAllErrorsInHandlerOrder) {
+  input_parameter_controller<std::string, MockParameterHandler> paramController;
+  paramController.insert<int>("required_param").add<is_required>();
+  paramController.insert<int>("range_param").add<check_range>(0, 10);
+
+  std::vector<MockParameterHandler> handlers(1000);
+  for (std::size_t i = 0; i < handlers.size(); ++i) {
+    if (i % 3 != 0) {
+      handlers[i].insert("required_param", 1);
+    }
+    handlers[i].insert("range_param", i % 5 == 0 ? 20 : 5);
+  }
+
+  const auto errors{paramController.check_parameter(
+      handlers, numsim_core::parallel_executor(8, 7))};
+
+  std::size_t expected{0};
+  for (std::size_t i = 0; i < handlers.size(); ++i) {
+    expected += (i % 3 == 0) + (i % 5 == 0);
+  }
+  ASSERT_EQ(errors.size(), expected);
+  for (std::size_t i = 1; i < errors.size(); ++i) {
+    EXPECT_LE(errors[i - 1].m_index, errors[i].m_index);
+  }
+  EXPECT_EQ(errors.front().m_index, 0u);
+  EXPECT_FALSE(errors.front().m_message.empty());
+}
+
+TEST(InputParameterBatchTest, SetDefaultMatchesSerialCheck) {
+  input_parameter_controller<std::string, MockParameterHandler> paramController;
+  paramController.insert<int>("default_param").add<set_default>(7);
+
+  std::vector<MockParameterHandler> handlers(256);
+  for (std::size_t i = 0; i < handlers.size(); i += 2) {
+    handlers[i].insert("default_param", static_cast<int>(i));
+  }
+
+  const auto errors{paramController.check_parameter(handlers)};
+  EXPECT_TRUE(errors.empty());
+  for (std::size_t i = 0; i < handlers.size(); ++i) {
+    EXPECT_EQ(handlers[i].get<int>("default_param"),
+              i % 2 == 0 ? static_cast<int>(i) : 7);
+  }
+}
+
+TEST(InputParameterBatchTest, EmptyRange) {
+  input_parameter_controller<std::string, MockParameterHandler> paramController;
+  paramController.insert<int>("required_param").add<is_required>();
+  std::vector<MockParameterHandler> handlers;
+  EXPECT_TRUE(paramController.check_parameter(handlers).empty());
+}
+
+TEST_F(InputParameterTest, TestRangeCheckSeesInsertedDefault) {
+  input_parameter_controller<std::string, MockParameterHandler> paramController;
+  auto &param = paramController.insert<int>("default_then_range");
+  param.add<set_default>(150);
+  param.add<check_range>(0, 100);
+
+  // The default is inserted first, the range check has to see it
+  EXPECT_THROW(paramController.check_parameter(handler), std::invalid_argument);
+}
+
+TEST(InputParameterColumnTest, MatchesBatchedCheck) {
+  input_parameter_controller<std::string, MockParameterHandler> paramController;
+  paramController.insert<int>("required_param").add<is_required>();
+  paramController.insert<int>("range_param").add<check_range>(0, 10);
+  paramController.insert<std::string>("name_param").add<is_required>();
+
+  std::vector<MockParameterHandler> handlers(1000);
+  for (std::size_t i = 0; i < handlers.size(); ++i) {
+    if (i % 3 != 0) {
+      handlers[i].insert("required_param", 1);
+    }
+    handlers[i].insert("range_param", i % 5 == 0 ? 20 : 5);
+    if (i != 999) {
+      handlers[i].insert("name_param", std::string("steel"));
+    }
+  }
+
+  const auto masks{paramController.check_columns(handlers)};
+  const auto errors{paramController.check_parameter(handlers)};
+  ASSERT_EQ(masks.size(), 3u);
+  std::size_t failures{0};
+  for (const auto &mask : masks) {
+    ASSERT_EQ(mask.m_failed.size(), 16u);
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+      failures += mask.failed(i);
+    }
+  }
+  EXPECT_EQ(failures, errors.size());
+  for (const auto &error : errors) {
+    const auto mask{std::find_if(masks.begin(), masks.end(), [&](auto &m) {
+      return m.m_name == error.m_name;
+    })};
+    ASSERT_NE(mask, masks.end());
+    EXPECT_TRUE(mask->failed(error.m_index));
+  }
+}
+
+TEST(InputParameterColumnTest, DefaultsAndTypes) {
+  input_parameter_controller<std::string, MockParameterHandler> paramController;
+  paramController.insert<int>("default_param")
+      .add<set_default>(150)
+      .add<check_range>(0, 100);
+  paramController.insert<double>("typed_param").add<check_data_type>();
+
+  std::vector<MockParameterHandler> handlers(70);
+  for (std::size_t i = 0; i < handlers.size(); i += 2) {
+    handlers[i].insert("default_param", static_cast<int>(i));
+  }
+  handlers[65].insert("typed_param", 1);
+  handlers[66].insert("typed_param", 1.0);
+
+  const auto masks{paramController.check_columns(handlers)};
+  ASSERT_EQ(masks.size(), 2u);
+  for (const auto &mask : masks) {
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+      if (mask.m_name == "default_param") {
+        // the inserted default is out of range
+        EXPECT_EQ(mask.failed(i), i % 2 == 1);
+        EXPECT_EQ(handlers[i].get<int>("default_param"),
+                  i % 2 == 0 ? static_cast<int>(i) : 150);
+      } else {
+        EXPECT_EQ(mask.failed(i), i == 65);
+      }
+    }
+  }
+}
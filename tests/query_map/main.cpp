@@ -3,8 +3,13 @@
 #include <any>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <functional>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 #include <numsim-core/query_map.h>
 
 using numsim_core::query_map;
@@ -99,3 +104,296 @@ TEST_F(QueryMapTest, UpdateValue) {
   auto &retrievedValue = std::any_cast<int&>(qmap.get(4, std::string("key4")));
   EXPECT_EQ(retrievedValue, updated_data);
 }
+
+// Test that final_queries only re-runs queries whose value changed
+TEST_F(QueryMapTest, QueriesRunIncrementally) {
+  qmap.set(std::make_any<int>(1), 1, std::string("a"));
+  qmap.set(std::make_any<int>(2), 2, std::string("b"));
+  int runs_a{0};
+  int runs_b{0};
+  qmap.query([&runs_a](std::any &) { ++runs_a; }, 1, std::string("a"));
+  qmap.query([&runs_b](std::any &) { ++runs_b; }, 2, std::string("b"));
+
+  qmap.final_queries();
+  EXPECT_EQ(runs_a, 1);
+  EXPECT_EQ(runs_b, 1);
+
+  qmap.final_queries();
+  EXPECT_EQ(runs_a, 1);
+  EXPECT_EQ(runs_b, 1);
+
+  qmap.set(std::make_any<int>(3), 1, std::string("a"));
+  qmap.final_queries();
+  EXPECT_EQ(runs_a, 2);
+  EXPECT_EQ(runs_b, 1);
+
+  // A mutable get may change the value
+  std::any_cast<int &>(qmap.get(2, std::string("b"))) = 4;
+  qmap.final_queries();
+  EXPECT_EQ(runs_a, 2);
+  EXPECT_EQ(runs_b, 2);
+
+  qmap.invalidate_queries();
+  qmap.final_queries();
+  EXPECT_EQ(runs_a, 3);
+  EXPECT_EQ(runs_b, 3);
+}
+
+// Test that resolved queries see values after new keys are inserted
+TEST_F(QueryMapTest, QueriesSurviveInsertion) {
+  qmap.set(std::make_any<int>(1), 1, std::string("a"));
+  int seen{0};
+  qmap.query([&seen](std::any &value) { seen = std::any_cast<int>(value); },
+             1, std::string("a"));
+  qmap.final_queries();
+  for (int i = 0; i < 100; ++i) {
+    qmap.set(std::make_any<int>(i), i + 2, std::string("x"));
+    qmap.set(std::make_any<int>(i), 1, "key" + std::to_string(i));
+  }
+  qmap.set(std::make_any<int>(7), 1, std::string("a"));
+  qmap.final_queries();
+  EXPECT_EQ(seen, 7);
+}
+
+// Test that a query whose keys are missing throws
+TEST_F(QueryMapTest, QueryWithMissingKeyThrows) {
+  qmap.query([](std::any &) {}, 1, std::string("missing"));
+  EXPECT_THROW(qmap.final_queries(), std::invalid_argument);
+}
+
+// Test that parallel queries serialize on shared values and run incrementally
+TEST(ParallelQueryMapTest, ConflictingQueriesAreSerialized) {
+  query_map<key_list, std::unordered_map> qmap;
+  constexpr int values{64};
+  constexpr int queries_per_value{50};
+  std::vector<int> counters(values, 0);
+  for (int i = 0; i < values; ++i) {
+    qmap.set(std::make_any<int>(i), i, std::string("field"));
+  }
+  for (int q = 0; q < queries_per_value; ++q) {
+    for (int i = 0; i < values; ++i) {
+      // Unsynchronized increment, only correct if queries of a value are
+      // serialized
+      qmap.query([&counters, i](std::any &) { ++counters[i]; }, i,
+                 std::string("field"));
+    }
+  }
+  const numsim_core::parallel_executor executor(4, 1);
+  qmap.final_queries(executor);
+  for (const auto count : counters) {
+    EXPECT_EQ(count, queries_per_value);
+  }
+
+  qmap.final_queries(executor);
+  qmap.set(std::make_any<int>(0), 3, std::string("field"));
+  qmap.final_queries(executor);
+  for (int i = 0; i < values; ++i) {
+    EXPECT_EQ(counters[i], i == 3 ? 2 * queries_per_value : queries_per_value);
+  }
+}
+
+// Test that queries of one value keep their order in parallel mode
+TEST(ParallelQueryMapTest, GroupOrderIsPreserved) {
+  numsim_core::flat_query_map<key_list, std::unordered_map> qmap;
+  qmap.set(std::make_any<int>(0), 1, std::string("a"));
+  qmap.set(std::make_any<int>(0), 2, std::string("b"));
+  std::vector<int> order_a;
+  std::vector<int> order_b;
+  for (int q = 0; q < 10; ++q) {
+    qmap.query([&order_a, q](std::any &) { order_a.push_back(q); }, 1,
+               std::string("a"));
+    qmap.query([&order_b, q](std::any &) { order_b.push_back(q); }, 2,
+               std::string("b"));
+  }
+  qmap.final_queries(numsim_core::parallel_executor(2, 1));
+  const std::vector<int> expected{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(order_a, expected);
+  EXPECT_EQ(order_b, expected);
+}
+
+// Test that exceptions of parallel queries reach the caller
+TEST(ParallelQueryMapTest, ExceptionIsRethrown) {
+  query_map<key_list, std::unordered_map> qmap;
+  qmap.set(std::make_any<int>(0), 1, std::string("a"));
+  qmap.query([](std::any &) { throw std::runtime_error("query failed"); }, 1,
+             std::string("a"));
+  EXPECT_THROW(qmap.final_queries(numsim_core::parallel_executor(2, 1)),
+               std::runtime_error);
+  qmap.query([](std::any &) {}, 2, std::string("missing"));
+  EXPECT_THROW(qmap.final_queries(numsim_core::parallel_executor(2, 1)),
+               std::invalid_argument);
+}
+
+// Test that the executor reuses its threads across calls and copies
+TEST(ParallelExecutorTest, ThreadsAreReused) {
+  const numsim_core::parallel_executor executor(4, 1);
+  const auto copy{executor};
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  for (int call = 0; call < 20; ++call) {
+    (call % 2 == 0 ? executor : copy)(64, [&](std::size_t) {
+      std::lock_guard<std::mutex> lock(mutex);
+      ids.insert(std::this_thread::get_id());
+    });
+  }
+  EXPECT_LE(ids.size(), 4u);
+  EXPECT_TRUE(ids.contains(std::this_thread::get_id()));
+}
+
+// Test that calls from within a running call complete on the calling thread
+TEST(ParallelExecutorTest, NestedCalls) {
+  const numsim_core::parallel_executor executor(4, 1);
+  std::vector<int> sums(16, 0);
+  executor(sums.size(), [&](std::size_t i) {
+    const auto thread{std::this_thread::get_id()};
+    executor(8, [&](std::size_t j) {
+      EXPECT_EQ(std::this_thread::get_id(), thread);
+      sums[i] += static_cast<int>(j);
+    });
+  });
+  for (const auto sum : sums) {
+    EXPECT_EQ(sum, 28);
+  }
+  EXPECT_THROW(executor(8,
+                        [](std::size_t i) {
+                          if (i == 5) {
+                            throw std::runtime_error("failed");
+                          }
+                        }),
+               std::runtime_error);
+}
+
+// Test that a pmr query map propagates its allocator to the nested maps
+TEST(PmrQueryMapTest, NestedMapsUseResource) {
+  std::pmr::monotonic_buffer_resource resource;
+  auto *previous{
+      std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+  {
+    numsim_core::pmr::double_query_map pmr_qmap(&resource);
+    pmr_qmap.set(std::make_any<int>(5), std::pmr::string("model"),
+                 std::pmr::string("field"));
+    EXPECT_EQ(std::any_cast<int>(pmr_qmap.get(std::pmr::string("model"),
+                                              std::pmr::string("field"))),
+              5);
+  }
+  std::pmr::set_default_resource(previous);
+}
+
+// Test a three level nested query map
+TEST(NestedQueryMapTest, ThreeKeys) {
+  query_map<std::tuple<std::string, std::string, int>, std::unordered_map> qmap;
+  qmap.set(std::make_any<int>(3), std::string("model"), std::string("field"), 2);
+  EXPECT_EQ(std::any_cast<int>(qmap.get(std::string("model"),
+                                        std::string("field"), 2)),
+            3);
+  EXPECT_THROW(qmap.get(std::string("model"), std::string("field"), 1),
+               std::invalid_argument);
+}
+
+// Test suite for the flat query_map layout
+class FlatQueryMapTest : public ::testing::Test {
+protected:
+  numsim_core::flat_query_map<key_list, std::unordered_map> qmap;
+};
+
+TEST_F(FlatQueryMapTest, SetAndGetValues) {
+  qmap.set(std::make_any<int>(42), 1, std::string("key1"));
+  EXPECT_EQ(std::any_cast<int &>(qmap.get(1, std::string("key1"))), 42);
+  EXPECT_TRUE(qmap.contains(1, std::string("key1")));
+  EXPECT_FALSE(qmap.contains(2, std::string("key1")));
+  const auto &const_qmap{qmap};
+  EXPECT_EQ(std::any_cast<int const &>(const_qmap.get(1, std::string("key1"))),
+            42);
+}
+
+TEST_F(FlatQueryMapTest, UpdateValue) {
+  qmap.set(std::make_any<int>(10), 4, std::string("key4"));
+  qmap.set(std::make_any<int>(99), 4, std::string("key4"));
+  EXPECT_EQ(qmap.size(), 1u);
+  EXPECT_EQ(std::any_cast<int>(qmap.get(4, std::string("key4"))), 99);
+}
+
+TEST_F(FlatQueryMapTest, KeyNotFound) {
+  qmap.set(std::make_any<int>(1), 3, std::string("key"));
+  EXPECT_THROW(qmap.get(3, std::string("nonexistent")), std::invalid_argument);
+  EXPECT_THROW(qmap.get(4, std::string("key")), std::invalid_argument);
+}
+
+TEST_F(FlatQueryMapTest, QueryExecution) {
+  bool query_executed{false};
+  qmap.set(std::make_any<int>(55), 1, std::string("key3"));
+  qmap.query(
+      [&query_executed](std::any &value) {
+        EXPECT_EQ(std::any_cast<int>(value), 55);
+        query_executed = true;
+      },
+      1, std::string("key3"));
+  qmap.final_queries();
+  EXPECT_TRUE(query_executed);
+}
+
+// Test that final_queries only re-runs queries whose value changed
+TEST_F(FlatQueryMapTest, QueriesRunIncrementally) {
+  qmap.set(std::make_any<int>(1), 1, std::string("a"));
+  int runs{0};
+  qmap.query([&runs](std::any &) { ++runs; }, 1, std::string("a"));
+  qmap.final_queries();
+  qmap.final_queries();
+  EXPECT_EQ(runs, 1);
+  for (int i = 0; i < 100; ++i) {
+    qmap.set(std::make_any<int>(i), i + 2, std::string("x"));
+  }
+  qmap.final_queries();
+  EXPECT_EQ(runs, 1);
+  qmap.set(std::make_any<int>(2), 1, std::string("a"));
+  qmap.final_queries();
+  EXPECT_EQ(runs, 2);
+}
+
+TEST_F(FlatQueryMapTest, NestedView) {
+  qmap.set(std::make_any<int>(1), 1, std::string("a"));
+  qmap.set(std::make_any<int>(2), 1, std::string("b"));
+  qmap.set(std::make_any<int>(3), 2, std::string("a"));
+  auto view{qmap.nested_view()};
+  EXPECT_EQ(std::any_cast<int>(*view.get(1, std::string("b"))), 2);
+  EXPECT_EQ(view.get(2, std::string("a")), &qmap.get(2, std::string("a")));
+}
+
+TEST(PmrFlatQueryMapTest, UsesResource) {
+  std::pmr::monotonic_buffer_resource resource;
+  auto *previous{
+      std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+  {
+    numsim_core::pmr::flat_double_query_map pmr_qmap(&resource);
+    pmr_qmap.set(std::make_any<int>(5), std::pmr::string("model", &resource),
+                 std::pmr::string("field", &resource));
+    EXPECT_EQ(std::any_cast<int>(
+                  pmr_qmap.get(std::pmr::string("model", &resource),
+                               std::pmr::string("field", &resource))),
+              5);
+  }
+  std::pmr::set_default_resource(previous);
+}
+
+TEST(PmrQueryMapTest, StringViewLookupDoesNotAllocate) {
+  std::pmr::monotonic_buffer_resource resource;
+  numsim_core::pmr::double_query_map nested(&resource);
+  numsim_core::pmr::flat_double_query_map flat(&resource);
+  const std::pmr::string model("a_rather_long_model_name_beyond_sso",
+                               &resource);
+  const std::pmr::string field("a_rather_long_field_name_beyond_sso",
+                               &resource);
+  nested.set(std::make_any<int>(1), model, field);
+  flat.set(std::make_any<int>(2), std::pmr::string(model, &resource),
+           std::pmr::string(field, &resource));
+  auto *previous{
+      std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+  const std::string_view model_name{"a_rather_long_model_name_beyond_sso"};
+  EXPECT_EQ(std::any_cast<int>(nested.get(
+                model_name, "a_rather_long_field_name_beyond_sso")),
+            1);
+  EXPECT_EQ(std::any_cast<int>(
+                flat.get(model_name, "a_rather_long_field_name_beyond_sso")),
+            2);
+  std::pmr::set_default_resource(previous);
+}
@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <numsim-core/registry_bones.h>
+
+// Object hierarchies per test, registries are process-wide singletons.
+struct material {
+  virtual ~material() = default;
+  virtual double stiffness() const = 0;
+};
+
+struct linear_elastic final : material {
+  explicit linear_elastic(double youngs_modulus) : m_e(youngs_modulus) {}
+  double stiffness() const override { return m_e; }
+  double m_e;
+};
+
+struct plastic final : material {
+  explicit plastic(double youngs_modulus) : m_e(youngs_modulus / 2) {}
+  double stiffness() const override { return m_e; }
+  double m_e;
+};
+
+struct element {
+  virtual ~element() = default;
+  virtual int nodes() const = 0;
+};
+
+// Counts live instances to check destruction
+struct counted {
+  static inline std::atomic<int> live{0};
+  counted() { ++live; }
+  virtual ~counted() { --live; }
+};
+
+// Multiple inheritance places element at an offset within the object
+struct quad4 final : counted, element {
+  int nodes() const override { return 4; }
+};
+
+struct tri3 final : counted, element {
+  int nodes() const override { return 3; }
+};
+
+using material_registry =
+    numsim_core::registry<std::map, std::string,
+                          numsim_core::heap_registry_entry<material, double>>;
+using element_registry =
+    numsim_core::registry<std::unordered_map, std::string,
+                          numsim_core::pooled_registry_entry<element>>;
+
+RegisterObject(material_registry, linear_elastic, linear_elastic)
+RegisterObject(material_registry, plastic, plastic)
+RegisterObject(element_registry, quad4, quad4)
+RegisterObject(element_registry, tri3, tri3)
+
+// Test building objects on the heap
+TEST(RegistryTest, HeapBuild) {
+  auto object{material_registry::build("linear_elastic", 210.0)};
+  EXPECT_EQ(object->stiffness(), 210.0);
+  EXPECT_EQ(material_registry::build(std::string("plastic"), 210.0)->stiffness(),
+            105.0);
+  EXPECT_EQ(material_registry::entity("plastic").name(), "plastic");
+}
+
+// Test that unknown names throw
+TEST(RegistryTest, UnknownName) {
+  EXPECT_THROW(material_registry::build("unknown", 1.0), std::runtime_error);
+  EXPECT_THROW(static_cast<void>(material_registry::entity("unknown")),
+               std::runtime_error);
+}
+
+// Test that pooled objects are recycled and destroyed correctly
+TEST(RegistryTest, PooledBuildRecyclesStorage) {
+  const int live{counted::live};
+  {
+    auto first{element_registry::build("quad4")};
+    auto second{element_registry::build("tri3")};
+    EXPECT_EQ(first->nodes(), 4);
+    EXPECT_EQ(second->nodes(), 3);
+    EXPECT_EQ(counted::live, live + 2);
+  }
+  EXPECT_EQ(counted::live, live);
+
+  auto &pool{numsim_core::object_pool<quad4>::instance()};
+  void const *address{nullptr};
+  {
+    auto object{element_registry::build("quad4")};
+    address = dynamic_cast<void const *>(object.get());
+  }
+  const auto capacity{pool.capacity()};
+  for (int i = 0; i < 1000; ++i) {
+    auto object{element_registry::build("quad4")};
+    EXPECT_EQ(dynamic_cast<void const *>(object.get()), address);
+  }
+  EXPECT_EQ(pool.capacity(), capacity);
+  EXPECT_EQ(pool.size(), 0u);
+}
+
+// Argument type counting copies and moves
+struct mesh_view {
+  mesh_view() = default;
+  mesh_view(mesh_view const &other) : m_copies(other.m_copies + 1) {}
+  mesh_view(mesh_view &&other) noexcept
+      : m_copies(other.m_copies), m_moves(other.m_moves + 1) {}
+  int m_copies{0};
+  int m_moves{0};
+};
+
+struct assembler {
+  virtual ~assembler() = default;
+  virtual mesh_view const &mesh() const = 0;
+};
+
+// Stores a copy of the mesh view taken by reference
+struct reference_assembler final : assembler {
+  explicit reference_assembler(mesh_view const &mesh) : m_mesh(mesh) {}
+  mesh_view const &mesh() const override { return m_mesh; }
+  mesh_view m_mesh;
+};
+
+// Takes the mesh view by value
+struct value_assembler final : assembler {
+  explicit value_assembler(mesh_view mesh) : m_mesh(std::move(mesh)) {}
+  mesh_view const &mesh() const override { return m_mesh; }
+  mesh_view m_mesh;
+};
+
+using reference_registry = numsim_core::registry<
+    std::map, std::string,
+    numsim_core::heap_registry_entry<assembler, mesh_view const &>>;
+using value_registry =
+    numsim_core::registry<std::map, std::string,
+                          numsim_core::pooled_registry_entry<assembler, mesh_view>>;
+
+RegisterObject(reference_registry, reference_assembler, reference_assembler)
+RegisterObject(value_registry, value_assembler, value_assembler)
+
+// Test that reference arguments are not copied on the way to the constructor
+TEST(RegistryTest, ForwardsReferenceArguments) {
+  const mesh_view mesh;
+  auto object{reference_registry::build("reference_assembler", mesh)};
+  EXPECT_EQ(object->mesh().m_copies, 1);
+  EXPECT_EQ(object->mesh().m_moves, 0);
+}
+
+// Test that by-value arguments are moved, and lvalues copied once
+TEST(RegistryTest, ForwardsValueArguments) {
+  auto moved{value_registry::build("value_assembler", mesh_view{})};
+  EXPECT_EQ(moved->mesh().m_copies, 0);
+  mesh_view mesh;
+  auto copied{value_registry::build("value_assembler", mesh)};
+  EXPECT_EQ(copied->mesh().m_copies, 1);
+}
+
+// Test repeated building through a resolved builder
+TEST(RegistryTest, Builder) {
+  auto builder{material_registry::resolve("linear_elastic")};
+  ASSERT_TRUE(builder);
+  EXPECT_EQ(builder.entity().name(), "linear_elastic");
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(builder(static_cast<double>(i))->stiffness(), i);
+  }
+  EXPECT_THROW(static_cast<void>(material_registry::resolve("unknown")),
+               std::runtime_error);
+}
+
+// Test that registering a name again keeps its builders valid
+TEST(RegistryTest, BuilderFollowsReplacement) {
+  material_registry::add_object<linear_elastic>("replaced");
+  auto builder{material_registry::resolve("replaced")};
+  EXPECT_EQ(builder(210.0)->stiffness(), 210.0);
+  material_registry::add_object<plastic>("replaced");
+  EXPECT_EQ(builder(210.0)->stiffness(), 105.0);
+  EXPECT_EQ(&builder.entity(), &material_registry::entity("replaced"));
+  material_registry::erase("replaced");
+}
+
+// Registry frozen by the tests below
+using frozen_registry =
+    numsim_core::registry<std::unordered_map, std::string,
+                          numsim_core::heap_registry_entry<element>>;
+
+RegisterObject(frozen_registry, quad4, quad4)
+RegisterObject(frozen_registry, tri3, tri3)
+
+// Test lookups and immutability after freezing
+TEST(RegistryTest, Freeze) {
+  frozen_registry::freeze();
+  EXPECT_TRUE(frozen_registry::is_frozen());
+  EXPECT_FALSE(material_registry::is_frozen());
+  EXPECT_EQ(frozen_registry::build("quad4")->nodes(), 4);
+  EXPECT_EQ(frozen_registry::build(std::string_view("tri3"))->nodes(), 3);
+  EXPECT_EQ(frozen_registry::entity(std::string("tri3")).name(), "tri3");
+  EXPECT_EQ(frozen_registry::resolve("quad4")()->nodes(), 4);
+  EXPECT_THROW(frozen_registry::build("unknown"), std::runtime_error);
+  EXPECT_THROW(frozen_registry::add_object<quad4>("quad4_copy"),
+               std::logic_error);
+  EXPECT_THROW(frozen_registry::erase("quad4"), std::logic_error);
+  // Freezing twice is harmless
+  EXPECT_NO_THROW(frozen_registry::freeze());
+}
+
+// Test building from several threads without synchronization
+TEST(RegistryTest, FrozenConcurrentBuild) {
+  frozen_registry::freeze();
+  std::atomic<int> nodes{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&nodes, t]() {
+      for (int i = 0; i < 1000; ++i) {
+        nodes += frozen_registry::build((i + t) % 2 == 0 ? "quad4" : "tri3")
+                     ->nodes();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(nodes.load(), 4 * 500 * (4 + 3));
+}
+
+// Entry counting the entries set up, to observe when registration happens
+struct counting_entry : numsim_core::heap_registry_entry<element> {
+  static inline int setups{0};
+
+  template <typename T>
+  void setup(std::string const &name, build_ptr func) {
+    ++setups;
+    numsim_core::heap_registry_entry<element>::setup<T>(name, func);
+  }
+};
+
+using lazy_registry =
+    numsim_core::registry<std::map, std::string, counting_entry>;
+
+RegisterObject(lazy_registry, quad4, quad4)
+RegisterObject(lazy_registry, tri3, tri3)
+
+// Test that static registration creates the entries on first access only
+TEST(RegistryTest, LazyRegistration) {
+  EXPECT_EQ(counting_entry::setups, 0);
+  EXPECT_EQ(lazy_registry::build("quad4")->nodes(), 4);
+  EXPECT_EQ(counting_entry::setups, 2);
+  EXPECT_EQ(lazy_registry::build("tri3")->nodes(), 3);
+  EXPECT_EQ(counting_entry::setups, 2);
+}
+
+// Test registrations linked after the first access, the latest one wins
+TEST(RegistryTest, LateRegistration) {
+  static_cast<void>(lazy_registry::get());
+  static lazy_registry::registration first{"late", std::type_identity<quad4>{}};
+  static lazy_registry::registration second{"late", std::type_identity<tri3>{}};
+  EXPECT_EQ(lazy_registry::build("late")->nodes(), 3);
+  EXPECT_EQ(lazy_registry::entity("late").name(), "late");
+}
+
+// Registry first accessed by several threads at once
+struct concurrent_entry : numsim_core::heap_registry_entry<element> {};
+using concurrent_registry =
+    numsim_core::registry<std::unordered_map, std::string, concurrent_entry>;
+
+RegisterObject(concurrent_registry, quad4, quad4)
+RegisterObject(concurrent_registry, tri3, tri3)
+
+// Test that concurrent first accesses create the entries once
+TEST(RegistryTest, ConcurrentFirstAccess) {
+  std::atomic<int> nodes{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&nodes, t]() {
+      nodes += concurrent_registry::build(t % 2 == 0 ? "quad4" : "tri3")
+                   ->nodes();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(nodes.load(), 2 * (4 + 3));
+}
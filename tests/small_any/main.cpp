@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/query_map.h>
+#include <numsim-core/small_any.h>
+
+using numsim_core::any_cast;
+using numsim_core::small_any;
+
+// Test storing and casting scalar values
+TEST(SmallAnyTest, StoreAndCast) {
+  small_any<> value{42};
+  EXPECT_TRUE(value.has_value());
+  EXPECT_EQ(any_cast<int>(value), 42);
+  any_cast<int &>(value) = 7;
+  EXPECT_EQ(any_cast<int const &>(value), 7);
+}
+
+// Test that a type mismatch throws std::bad_any_cast
+TEST(SmallAnyTest, BadCastThrows) {
+  small_any<> value{1.5};
+  EXPECT_THROW(any_cast<int>(value), std::bad_any_cast);
+  EXPECT_EQ(any_cast<int>(&value), nullptr);
+  small_any<> empty;
+  EXPECT_FALSE(empty.has_value());
+  EXPECT_THROW(any_cast<int>(empty), std::bad_any_cast);
+}
+
+// Test inline storage of tensors and heap fallback for large types
+TEST(SmallAnyTest, InlineAndHeapStorage) {
+  static_assert(small_any<>::fits_inline<std::array<double, 9>>);
+  static_assert(small_any<32>::fits_inline<std::array<double, 4>>);
+  static_assert(!small_any<16>::fits_inline<std::array<double, 9>>);
+  small_any<16> large{std::array<double, 9>{1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  small_any<16> copy{large};
+  EXPECT_EQ((any_cast<std::array<double, 9> const &>(copy)[8]), 9.0);
+}
+
+// Test copy, move and reassignment with a non-trivial type
+TEST(SmallAnyTest, CopyMoveAssign) {
+  small_any<> value{std::string("hello")};
+  small_any<> copy{value};
+  small_any<> moved{std::move(value)};
+  EXPECT_FALSE(value.has_value());
+  EXPECT_EQ(any_cast<std::string const &>(copy), "hello");
+  EXPECT_EQ(any_cast<std::string const &>(moved), "hello");
+  copy = std::vector<int>{1, 2};
+  EXPECT_EQ(any_cast<std::vector<int> const &>(copy).size(), 2u);
+  moved = copy;
+  EXPECT_EQ(any_cast<std::vector<int> const &>(moved).size(), 2u);
+}
+
+// Test printing through any_print_wrapper
+TEST(SmallAnyTest, Print) {
+  std::ostringstream oss;
+  oss << print(small_any<>{std::vector<int>{1, 2}}) << print(small_any<>{true});
+  EXPECT_EQ(oss.str(), "1 2 true");
+  EXPECT_THROW(oss << print(small_any<>{std::vector<bool>{true}}),
+               std::runtime_error);
+}
+
+// Test small_any as TypeErasure of parameter_handler
+TEST(SmallAnyTest, ParameterHandler) {
+  numsim_core::parameter_handler<std::string, small_any<>> handler;
+  handler.insert("E", 210.0);
+  handler.insert("name", std::string("steel"));
+  EXPECT_EQ(handler.get<double>("E"), 210.0);
+  EXPECT_EQ(handler.get<std::string>("name"), "steel");
+  EXPECT_THROW(handler.get<int>("E"), std::bad_any_cast);
+  std::ostringstream oss;
+  handler.print(oss);
+  EXPECT_NE(oss.str().find("steel"), std::string::npos);
+}
+
+// Test small_any as TypeErasure of query_map
+TEST(SmallAnyTest, QueryMap) {
+  numsim_core::query_map<std::tuple<std::string, std::string>,
+                         std::unordered_map, small_any<>>
+      qmap;
+  qmap.set(small_any<>{3}, std::string("model"), std::string("field"));
+  EXPECT_EQ(any_cast<int>(qmap.get(std::string("model"), std::string("field"))),
+            3);
+}
+
+namespace {
+struct concurrent_family {};
+template <std::size_t I> struct concurrent_type {};
+
+template <std::size_t Offset, std::size_t... I>
+void concurrent_ids(std::vector<numsim_core::type_id> &ids,
+                    std::index_sequence<I...>) {
+  (ids.push_back(numsim_core::static_type_id<concurrent_type<Offset + I>,
+                                             concurrent_family>()),
+   ...);
+}
+} // namespace
+
+// Test that types used for the first time from several threads get distinct
+// ids
+TEST(SmallAnyTest, ConcurrentTypeIds) {
+  constexpr std::size_t per_thread{64};
+  std::array<std::vector<numsim_core::type_id>, 4> ids;
+  std::vector<std::thread> threads;
+  threads.emplace_back([&] {
+    concurrent_ids<0 * per_thread>(ids[0],
+                                     std::make_index_sequence<per_thread>{});
+  });
+  threads.emplace_back([&] {
+    concurrent_ids<1 * per_thread>(ids[1],
+                                     std::make_index_sequence<per_thread>{});
+  });
+  threads.emplace_back([&] {
+    concurrent_ids<2 * per_thread>(ids[2],
+                                     std::make_index_sequence<per_thread>{});
+  });
+  threads.emplace_back([&] {
+    concurrent_ids<3 * per_thread>(ids[3],
+                                     std::make_index_sequence<per_thread>{});
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::set<numsim_core::type_id> distinct;
+  for (const auto &thread_ids : ids) {
+    distinct.insert(thread_ids.begin(), thread_ids.end());
+  }
+  EXPECT_EQ(distinct.size(), 4 * per_thread);
+  EXPECT_EQ(*distinct.rbegin(), 4 * per_thread - 1);
+  EXPECT_EQ(numsim_core::type_count<concurrent_family>(), 4 * per_thread);
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <vector>
+#include <numsim-core/flat_hash_map.h>
+#include <numsim-core/parameter_handler.h>
+#include <numsim-core/small_any.h>
+#include <numsim-core/snapshot.h>
+
+using numsim_core::parameter_handler;
+using numsim_core::snapshot_view;
+using numsim_core::to_snapshot;
+
+namespace {
+parameter_handler<> make_handler() {
+  parameter_handler<> handler;
+  handler.insert("int", 42);
+  handler.insert("unsigned", 7u);
+  handler.insert("long", -5000000000l);
+  handler.insert("float", 1.5f);
+  handler.insert("double", 3.25);
+  handler.insert("bool", true);
+  handler.insert("string", std::string("steel"));
+  handler.insert("ints", std::vector<int>{1, 2, 3});
+  handler.insert("doubles", std::vector<double>{0.5, 1.5});
+  handler.insert("strings", std::vector<std::string>{"a", "", "bc"});
+  handler.insert("tuple", std::tuple<int, double, std::string>{1, 2.0, "x"});
+  handler.insert("empty", std::vector<double>{});
+  return handler;
+}
+
+void expect_contents(parameter_handler<> const &handler) {
+  EXPECT_EQ(handler.size(), 12u);
+  EXPECT_EQ(handler.get<int>("int"), 42);
+  EXPECT_EQ(handler.get<unsigned>("unsigned"), 7u);
+  EXPECT_EQ(handler.get<long>("long"), -5000000000l);
+  EXPECT_EQ(handler.get<float>("float"), 1.5f);
+  EXPECT_EQ(handler.get<double>("double"), 3.25);
+  EXPECT_TRUE(handler.get<bool>("bool"));
+  EXPECT_EQ(handler.get<std::string>("string"), "steel");
+  EXPECT_EQ(handler.get<std::vector<int>>("ints"),
+            (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(handler.get<std::vector<double>>("doubles"),
+            (std::vector<double>{0.5, 1.5}));
+  EXPECT_EQ(handler.get<std::vector<std::string>>("strings"),
+            (std::vector<std::string>{"a", "", "bc"}));
+  EXPECT_EQ((handler.get<std::tuple<int, double, std::string>>("tuple")),
+            (std::tuple<int, double, std::string>{1, 2.0, "x"}));
+  EXPECT_TRUE(handler.get<std::vector<double>>("empty").empty());
+}
+} // namespace
+
+// A snapshot loads back into an equal handler
+TEST(SnapshotTest, RoundTrip) {
+  const auto buffer{to_snapshot(make_handler())};
+  const snapshot_view view(buffer);
+  EXPECT_EQ(view.size(), 12u);
+
+  parameter_handler<> restored;
+  view.load(restored);
+  expect_contents(restored);
+}
+
+// Deferred values are stored like explicit ones
+TEST(SnapshotTest, DeferredValues) {
+  parameter_handler<> handler;
+  handler.insert("E", 2.0);
+  handler.insert_deferred("twice", {"E"}, [](auto const &h) {
+    return 2.0 * h.template get<double>("E");
+  });
+  const auto buffer{to_snapshot(handler)};
+  EXPECT_EQ(snapshot_view(buffer).size(), 2u);
+
+  parameter_handler<> restored;
+  snapshot_view(buffer).load(restored);
+  EXPECT_EQ(restored.size(), 2u);
+  EXPECT_EQ(restored.get<double>("twice"), 4.0);
+}
+
+// Entries are sorted and found by key
+TEST(SnapshotTest, FindByKey) {
+  const auto buffer{to_snapshot(make_handler())};
+  const snapshot_view view(buffer);
+
+  std::string previous;
+  for (const auto &entry : view) {
+    EXPECT_LT(previous, entry.m_key);
+    previous = entry.m_key;
+  }
+  ASSERT_NE(view.find("double"), nullptr);
+  EXPECT_EQ(view.find("double")->value<double>(), 3.25);
+  EXPECT_EQ(view.find("missing"), nullptr);
+  EXPECT_THROW((void)view.at("missing"), std::invalid_argument);
+}
+
+// Strings and numeric arrays are viewed in place
+TEST(SnapshotTest, ZeroCopyViews) {
+  const auto buffer{to_snapshot(make_handler())};
+  const snapshot_view view(buffer);
+
+  const auto doubles{view.at("doubles").array<double>()};
+  ASSERT_EQ(doubles.size(), 2u);
+  EXPECT_EQ(doubles[1], 1.5);
+  EXPECT_GE(reinterpret_cast<std::byte const *>(doubles.data()),
+            buffer.data());
+  EXPECT_LT(reinterpret_cast<std::byte const *>(doubles.data()),
+            buffer.data() + buffer.size());
+
+  EXPECT_EQ(view.at("ints").array<int>()[2], 3);
+  EXPECT_EQ(view.at("string").string(), "steel");
+}
+
+// Accessing a value as another type throws
+TEST(SnapshotTest, TypeMismatchThrows) {
+  const auto buffer{to_snapshot(make_handler())};
+  const snapshot_view view(buffer);
+  EXPECT_THROW((void)view.at("int").value<double>(), std::invalid_argument);
+  EXPECT_THROW((void)view.at("ints").array<double>(), std::invalid_argument);
+  EXPECT_THROW((void)view.at("int").string(), std::invalid_argument);
+}
+
+// Unsupported value types cannot be written
+TEST(SnapshotTest, UnsupportedTypeThrows) {
+  parameter_handler<> handler;
+  handler.insert("pair", std::pair<int, int>{1, 2});
+  EXPECT_THROW((void)to_snapshot(handler), std::runtime_error);
+}
+
+// Invalid buffers are rejected
+TEST(SnapshotTest, InvalidBufferThrows) {
+  auto buffer{to_snapshot(make_handler())};
+
+  EXPECT_THROW(snapshot_view(std::span<std::byte const>(buffer).first(16)),
+               std::runtime_error);
+  EXPECT_THROW(snapshot_view(std::span<std::byte const>(buffer).first(
+                   buffer.size() - 8)),
+               std::runtime_error);
+  EXPECT_THROW(snapshot_view(std::span<std::byte const>(buffer).subspan(1)),
+               std::invalid_argument);
+
+  buffer[0] = std::byte{'X'};
+  EXPECT_THROW(snapshot_view{buffer}, std::runtime_error);
+}
+
+// A snapshot with an inflated entry size is rejected
+TEST(SnapshotTest, CorruptEntryThrows) {
+  auto buffer{to_snapshot(make_handler())};
+  // payload size of the first entry
+  buffer[32 + 15] = std::byte{0x7f};
+  EXPECT_THROW(snapshot_view{buffer}, std::runtime_error);
+}
+
+// An empty handler gives an empty snapshot
+TEST(SnapshotTest, EmptyHandler) {
+  const auto buffer{to_snapshot(parameter_handler<>{})};
+  const snapshot_view view(buffer);
+  EXPECT_EQ(view.size(), 0u);
+  EXPECT_EQ(view.begin(), view.end());
+}
+
+// Snapshots work with other type erasures and storage policies
+TEST(SnapshotTest, SmallAnyFlatHashMap) {
+  parameter_handler<std::string, numsim_core::small_any<>,
+                    numsim_core::flat_hash_map>
+      handler;
+  handler.insert("E", 210.0);
+  handler.insert("name", std::string("steel"));
+  const auto buffer{to_snapshot(handler)};
+
+  parameter_handler<std::string, numsim_core::small_any<>,
+                    numsim_core::flat_hash_map>
+      restored;
+  snapshot_view(buffer).load(restored);
+  EXPECT_EQ(restored.get<double>("E"), 210.0);
+  EXPECT_EQ(restored.get<std::string>("name"), "steel");
+}
+
+// Writing to a stream produces the same bytes
+TEST(SnapshotTest, WriteToStream) {
+  const auto handler{make_handler()};
+  std::ostringstream os;
+  numsim_core::write_snapshot(handler, os);
+  const auto buffer{to_snapshot(handler)};
+  ASSERT_EQ(os.str().size(), buffer.size());
+  EXPECT_EQ(std::memcmp(os.str().data(), buffer.data(), buffer.size()), 0);
+}
+
+// A snapshot file is opened in place and loaded
+TEST(SnapshotTest, FileRoundTrip) {
+  const auto path{(std::filesystem::temp_directory_path() /
+                   "numsim_core_snapshot_test.snap")
+                      .string()};
+  numsim_core::write_snapshot(make_handler(), path);
+  {
+    const numsim_core::snapshot_file file(path);
+    EXPECT_EQ(file.view().at("ints").array<int>()[0], 1);
+    parameter_handler<> restored;
+    file.view().load(restored);
+    expect_contents(restored);
+  }
+  std::filesystem::remove(path);
+  EXPECT_THROW(numsim_core::snapshot_file{path}, std::runtime_error);
+}
+
+// A foreign file is rejected without leaking its mapping, a missing file
+// reports why it could not be opened
+TEST(SnapshotTest, FileErrors) {
+  const auto path{(std::filesystem::temp_directory_path() /
+                   "numsim_core_snapshot_foreign.snap")
+                      .string()};
+  {
+    std::ofstream os(path, std::ios::binary);
+    os << "certainly not a numsim-core snapshot";
+  }
+  EXPECT_THROW(numsim_core::snapshot_file{path}, std::runtime_error);
+  if (std::ifstream maps{"/proc/self/maps"}) {
+    const std::string mappings{std::istreambuf_iterator<char>(maps),
+                               std::istreambuf_iterator<char>()};
+    EXPECT_EQ(mappings.find(path), std::string::npos);
+  }
+  std::filesystem::remove(path);
+
+  try {
+    numsim_core::snapshot_file file(path);
+    FAIL() << "opened a missing file";
+  } catch (std::system_error const &error) {
+    EXPECT_EQ(error.code(), std::errc::no_such_file_or_directory);
+  } catch (std::runtime_error const &) {
+    // the fallback without mmap reports no error code
+  }
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <numsim-core/static_registry.h>
+
+using numsim_core::perfect_hash_table;
+
+struct material {
+  virtual ~material() = default;
+  virtual double stiffness() const = 0;
+};
+
+struct linear_elastic final : material {
+  explicit linear_elastic(double youngs_modulus) : m_e(youngs_modulus) {}
+  double stiffness() const override { return m_e; }
+  double m_e;
+};
+
+struct plastic final : material {
+  explicit plastic(double youngs_modulus) : m_e(youngs_modulus / 2) {}
+  double stiffness() const override { return m_e; }
+  double m_e;
+};
+
+struct damage final : material {
+  explicit damage(double youngs_modulus) : m_e(youngs_modulus / 4) {}
+  double stiffness() const override { return m_e; }
+  double m_e;
+};
+
+using material_registry = numsim_core::static_registry<
+    numsim_core::pooled_registry_entry<material, double>,
+    StaticRegisterObject(linear_elastic, linear_elastic),
+    StaticRegisterObject(plastic, plastic),
+    StaticRegisterObject(damage, damage)>;
+
+// The lookup is usable in constant expressions
+static_assert(material_registry::size() == 3);
+static_assert(material_registry::index("plastic") == 1);
+static_assert(material_registry::contains("damage"));
+static_assert(!material_registry::contains("elastic"));
+
+// Test building objects by name
+TEST(StaticRegistryTest, Build) {
+  EXPECT_EQ(material_registry::build("linear_elastic", 200.0)->stiffness(),
+            200.0);
+  EXPECT_EQ(material_registry::build(std::string("plastic"), 200.0)
+                ->stiffness(),
+            100.0);
+  EXPECT_EQ(material_registry::build(std::string_view("damage"), 200.0)
+                ->stiffness(),
+            50.0);
+  EXPECT_EQ(material_registry::entity<"plastic">().name(), "plastic");
+  EXPECT_EQ(material_registry::resolve("damage")(8.0)->stiffness(), 2.0);
+}
+
+// Test that unknown names throw
+TEST(StaticRegistryTest, UnknownName) {
+  EXPECT_THROW(material_registry::build("unknown", 1.0), std::runtime_error);
+  EXPECT_THROW(static_cast<void>(material_registry::resolve("")),
+               std::runtime_error);
+}
+
+// Test that a larger key set is placed without collisions
+TEST(PerfectHashTableTest, AllKeysFound) {
+  static constexpr std::array<std::string_view, 40> keys{
+      "a",  "b",  "c",  "d",  "e",  "f",  "g",  "h",  "i",  "j",
+      "k",  "l",  "m",  "n",  "o",  "p",  "q",  "r",  "s",  "t",
+      "aa", "ab", "ac", "ad", "ae", "af", "ag", "ah", "ai", "aj",
+      "ba", "bb", "bc", "bd", "be", "bf", "bg", "bh", "bi", "bj"};
+  static constexpr perfect_hash_table<40> table{keys};
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(table.find(keys[i]), i);
+  }
+  EXPECT_EQ(table.find("zz"), perfect_hash_table<40>::npos);
+  EXPECT_EQ(table.find(""), perfect_hash_table<40>::npos);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <numsim-core/static_indexing.h>
+#include <numsim-core/type_dispatch.h>
+
+using numsim_core::double_dispatch_table;
+using numsim_core::static_indexing;
+using numsim_core::type_dispatch_table;
+using numsim_core::type_id;
+
+// Two independent hierarchies, each forming its own id family.
+struct material {
+  virtual ~material() = default;
+  [[nodiscard]] virtual type_id get_type_id() const noexcept = 0;
+};
+
+struct linear_elastic final : static_indexing<linear_elastic, material> {};
+struct plastic final : static_indexing<plastic, material> {};
+struct damage final : static_indexing<damage, material> {};
+
+struct element {
+  virtual ~element() = default;
+  [[nodiscard]] virtual type_id get_type_id() const noexcept = 0;
+};
+
+struct hex8 final : static_indexing<hex8, element> {};
+struct tet4 final : static_indexing<tet4, element> {};
+
+// Queried during static initialization, as a dispatch table built in another
+// translation unit would
+const type_id early_tet4_id{tet4::get_static_type_id()};
+
+// Test that the ids of one family are dense and start at zero
+TEST(StaticIndexingTest, IdsAreDensePerFamily) {
+  const std::set<type_id> materials{linear_elastic::get_static_type_id(),
+                                    plastic::get_static_type_id(),
+                                    damage::get_static_type_id()};
+  EXPECT_EQ(materials, (std::set<type_id>{0, 1, 2}));
+  EXPECT_EQ(linear_elastic::type_count(), 3u);
+  EXPECT_EQ(numsim_core::type_count<material>(), 3u);
+
+  const std::set<type_id> elements{hex8::get_static_type_id(),
+                                   tet4::get_static_type_id()};
+  EXPECT_EQ(elements, (std::set<type_id>{0, 1}));
+  EXPECT_EQ(numsim_core::type_count<element>(), 2u);
+}
+
+// Test that an id queried during static initialization is the final one
+TEST(StaticIndexingTest, IdDuringStaticInitialization) {
+  EXPECT_EQ(early_tet4_id, tet4::get_static_type_id());
+  EXPECT_EQ(early_tet4_id, tet4().get_type_id());
+}
+
+// Test that the id of the dynamic type is available through the base
+TEST(StaticIndexingTest, DynamicTypeId) {
+  const std::unique_ptr<material> object{std::make_unique<plastic>()};
+  EXPECT_EQ(object->get_type_id(), plastic::get_static_type_id());
+  EXPECT_NE(object->get_type_id(), damage::get_static_type_id());
+}
+
+// Test single dispatch on the dynamic type
+TEST(TypeDispatchTableTest, Dispatch) {
+  type_dispatch_table<std::string(material const &)> names(
+      numsim_core::type_count<material>());
+  names.set<linear_elastic>([](material const &) -> std::string {
+    return "linear_elastic";
+  });
+  names.set<plastic>(
+      [](material const &) -> std::string { return "plastic"; });
+
+  plastic object;
+  material const &base{object};
+  EXPECT_EQ(names(base.get_type_id(), base), "plastic");
+  EXPECT_TRUE(names.contains(linear_elastic::get_static_type_id()));
+  EXPECT_FALSE(names.contains(damage::get_static_type_id()));
+  EXPECT_EQ(names.find(100), nullptr);
+  EXPECT_THROW(names(damage::get_static_type_id(), damage{}),
+               std::out_of_range);
+}
+
+// Test that setting an id beyond the size grows the table
+TEST(TypeDispatchTableTest, GrowsOnSet) {
+  type_dispatch_table<int()> table;
+  EXPECT_EQ(table.size(), 0u);
+  table.set(5, []() { return 5; });
+  EXPECT_EQ(table.size(), 6u);
+  EXPECT_EQ(table(5), 5);
+  EXPECT_FALSE(table.contains(4));
+}
+
+// Test double dispatch over two families
+TEST(DoubleDispatchTableTest, Dispatch) {
+  double_dispatch_table<int(material &, element &)> kernels(
+      numsim_core::type_count<material>(), numsim_core::type_count<element>());
+  kernels.set<linear_elastic, hex8>([](material &, element &) { return 1; });
+  kernels.set<linear_elastic, tet4>([](material &, element &) { return 2; });
+  kernels.set<plastic, tet4>([](material &m, element &) {
+    return static_cast<plastic &>(m).get_type_id() ==
+                   plastic::get_static_type_id()
+               ? 3
+               : 0;
+  });
+
+  linear_elastic elastic;
+  plastic plast;
+  hex8 hex;
+  tet4 tet;
+  material &m0{elastic};
+  material &m1{plast};
+  element &e0{hex};
+  element &e1{tet};
+  EXPECT_EQ(kernels(m0.get_type_id(), e0.get_type_id(), m0, e0), 1);
+  EXPECT_EQ(kernels(m0.get_type_id(), e1.get_type_id(), m0, e1), 2);
+  EXPECT_EQ(kernels(m1.get_type_id(), e1.get_type_id(), m1, e1), 3);
+  EXPECT_FALSE(kernels.contains(m1.get_type_id(), e0.get_type_id()));
+  EXPECT_THROW(kernels(m1.get_type_id(), e0.get_type_id(), m1, e0),
+               std::out_of_range);
+}
+
+// Test that growing the table keeps the handlers at their ids
+TEST(DoubleDispatchTableTest, GrowsOnSet) {
+  double_dispatch_table<int()> table(2, 2);
+  table.set(0, 1, []() { return 1; });
+  table.set(1, 0, []() { return 10; });
+  table.set(3, 4, []() { return 34; });
+  EXPECT_EQ(table.rows(), 4u);
+  EXPECT_EQ(table.cols(), 5u);
+  EXPECT_EQ(table(0, 1), 1);
+  EXPECT_EQ(table(1, 0), 10);
+  EXPECT_EQ(table(3, 4), 34);
+  EXPECT_FALSE(table.contains(1, 1));
+  EXPECT_FALSE(table.contains(4, 0));
+}
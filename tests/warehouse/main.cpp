@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <numsim-core/static_indexing.h>
+#include <numsim-core/warehouse_bones.h>
+
+using numsim_core::warehouse;
+
+struct shape {
+  virtual ~shape() = default;
+  [[nodiscard]] virtual double area() const = 0;
+};
+
+struct square final : numsim_core::static_indexing<square, shape> {
+  explicit square(double side) : m_side(side) {}
+  [[nodiscard]] double area() const override { return m_side * m_side; }
+  double m_side;
+};
+
+struct circle final : numsim_core::static_indexing<circle, shape> {
+  explicit circle(double radius) : m_radius(radius) {}
+  [[nodiscard]] double area() const override {
+    return 3.0 * m_radius * m_radius;
+  }
+  double m_radius;
+};
+
+// Counts destructor calls of the stored objects.
+struct tracked final : shape {
+  explicit tracked(int &destroyed) : m_destroyed(&destroyed) {}
+  ~tracked() override { ++*m_destroyed; }
+  [[nodiscard]] double area() const override { return 0.0; }
+  int *m_destroyed;
+};
+
+// Test that objects are stored per type and accessible through handles
+TEST(WarehouseTest, EmplaceAndGet) {
+  warehouse<shape> store;
+  const auto s{store.emplace<square>(2.0)};
+  const auto c{store.emplace<circle>(1.0)};
+  EXPECT_TRUE(s);
+  EXPECT_NE(s.m_type, c.m_type);
+  EXPECT_EQ(s.m_type, square::get_static_type_id());
+  EXPECT_DOUBLE_EQ(store.get(s).area(), 4.0);
+  EXPECT_DOUBLE_EQ(store.get(c).area(), 3.0);
+  EXPECT_DOUBLE_EQ(store.get<circle>(c).m_radius, 1.0);
+  EXPECT_EQ(store.size(), 2u);
+  EXPECT_EQ(store.size<square>(), 1u);
+  EXPECT_EQ(store.size<tracked>(), 0u);
+}
+
+// Test that handles and references stay valid while objects are added
+TEST(WarehouseTest, StableAcrossInsertion) {
+  warehouse<shape, 4> store;
+  const auto first{store.emplace<square>(1.0)};
+  auto &object{store.get<square>(first)};
+  std::vector<warehouse<shape, 4>::handle> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.push_back(store.emplace<square>(static_cast<double>(i)));
+  }
+  EXPECT_EQ(&object, &store.get<square>(first));
+  EXPECT_DOUBLE_EQ(object.m_side, 1.0);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_DOUBLE_EQ(store.get<square>(handles[i]).m_side,
+                     static_cast<double>(i));
+  }
+}
+
+// Test iterating all objects of one type in insertion order
+TEST(WarehouseTest, ForEachType) {
+  warehouse<shape, 3> store;
+  for (int i = 0; i < 10; ++i) {
+    store.emplace<square>(static_cast<double>(i));
+    store.emplace<circle>(1.0);
+  }
+  std::vector<double> sides;
+  store.for_each<square>(
+      [&](square &object) { sides.push_back(object.m_side); });
+  ASSERT_EQ(sides.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_DOUBLE_EQ(sides[i], static_cast<double>(i));
+  }
+
+  double total{0.0};
+  std::as_const(store).for_each(
+      [&](shape const &object) { total += object.area(); });
+  EXPECT_DOUBLE_EQ(total, 285.0 + 30.0);
+}
+
+// Test that invalid handles and type mismatches throw
+TEST(WarehouseTest, InvalidHandleThrows) {
+  warehouse<shape> store;
+  const auto s{store.emplace<square>(2.0)};
+  EXPECT_THROW(store.get(warehouse<shape>::handle{}), std::out_of_range);
+  EXPECT_THROW(store.get<circle>(s), std::invalid_argument);
+  auto stale{s};
+  stale.m_index = 5;
+  EXPECT_THROW(store.get(stale), std::out_of_range);
+  EXPECT_THROW(store.get<square>(stale), std::out_of_range);
+}
+
+// Test that the warehouse destroys the objects it owns
+TEST(WarehouseTest, DestroysObjects) {
+  int destroyed{0};
+  {
+    warehouse<shape, 2> store;
+    for (int i = 0; i < 5; ++i) {
+      store.emplace<tracked>(destroyed);
+    }
+    store.clear();
+    EXPECT_EQ(destroyed, 5);
+    EXPECT_TRUE(store.empty());
+    store.emplace<tracked>(destroyed);
+  }
+  EXPECT_EQ(destroyed, 6);
+}